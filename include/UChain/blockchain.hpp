@@ -28,6 +28,7 @@
 #include <UChain/blockchain/define.hpp>
 #include <UChain/blockchain/organizer.hpp>
 #include <UChain/blockchain/orphan_pool.hpp>
+#include <UChain/blockchain/script_cache.hpp>
 #include <UChain/blockchain/settings.hpp>
 #include <UChain/blockchain/simple_chain.hpp>
 #include <UChain/blockchain/tx_pool.hpp>
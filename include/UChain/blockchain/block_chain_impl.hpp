@@ -31,9 +31,11 @@
 #include <UChain/blockchain/block_chain.hpp>
 #include <UChain/blockchain/define.hpp>
 #include <UChain/blockchain/organizer.hpp>
+#include <UChain/blockchain/script_cache.hpp>
 #include <UChain/blockchain/settings.hpp>
 #include <UChain/blockchain/simple_chain.hpp>
 #include <UChain/blockchain/tx_pool.hpp>
+#include <UChain/blockchain/wallet_session.hpp>
 #include <UChain/coin/chain/header.hpp>
 #include <UChain/coin/chain/header.hpp>
 
@@ -70,6 +72,9 @@ class BCB_API block_chain_impl
     // Get a reference to the transaction pool.
     tx_pool &pool();
 
+    // Get a reference to the cache of verified input scripts.
+    script_cache &get_script_cache();
+
     // Get a reference to the blockchain configuration settings.
     const settings &chain_settings() const;
 
@@ -114,6 +119,19 @@ class BCB_API block_chain_impl
     bool get_transaction(chain::transaction &out_transaction,
                          uint64_t &out_block_height, const hash_digest &transaction_hash) const;
 
+    /// Get the unspent output of the given output point from the utxo store.
+    bool get_unspent_output(chain::output &out_output, uint64_t &out_height,
+                            bool &out_coinbase, const chain::output_point &outpoint) const;
+
+    /// Get the confirmed totals of an address, symbol is empty for ucn.
+    database::address_balance get_address_balance(const std::string &address,
+                                                  const std::string &symbol = "") const;
+
+    /// Get the confirmed deposit and coinbase outputs of an address which
+    /// are frozen at the given height.
+    database::frozen_output::list get_address_frozen(const std::string &address,
+                                                     uint64_t height) const;
+
     /// Import a block to the blockchain.
     bool import(chain::block::ptr block, uint64_t height);
 
@@ -123,6 +141,10 @@ class BCB_API block_chain_impl
     /// Remove blocks at or above the given height, returning them in order.
     bool pop_from(block_info::list &out_blocks, uint64_t height);
 
+    /// Exclude readers while the chain changes.
+    void start_write();
+    void stop_write();
+
     // block_chain queries (thread safe).
     // ------------------------------------------------------------------------
 
@@ -233,6 +255,10 @@ class BCB_API block_chain_impl
     std::shared_ptr<libbitcoin::chain::wallet> is_wallet_passwd_valid(const std::string &name, const std::string &passwd);
     std::string is_wallet_lastwd_valid(const libbitcoin::chain::wallet &acc, std::string &auth, const std::string &lastwd);
     void set_wallet_passwd(const std::string &name, const std::string &passwd);
+    void unlock_wallet(const std::string &name, const std::string &passwd, uint32_t timeout);
+    void lock_wallet(const std::string &name);
+    wallet_keyring::ptr get_wallet_keyring(const std::string &name, const std::string &passwd);
+    std::string get_wallet_prv_key(const wallet_address &address, const std::string &passwd);
     bool is_wallet_exist(const std::string &name);
     bool is_admin_wallet(const std::string &name);
     operation_result store_wallet(std::shared_ptr<libbitcoin::chain::wallet> acc);
@@ -294,9 +320,14 @@ class BCB_API block_chain_impl
     std::shared_ptr<candidate_info::list> get_registered_candidates();
     std::shared_ptr<candidate_info::list> get_candidate_history(const std::string &symbol,
                                                                 uint64_t limit = 0, uint64_t page_number = 0);
+    std::shared_ptr<candidate_info::list> get_candidate_history(const std::string &symbol,
+                                                                database::history_cursor &cursor, uint64_t limit);
     std::shared_ptr<candidate::list> get_wallet_candidates(
         const std::string &wallet, const std::string &symbol = "");
     bool exist_in_candidates(std::string uid);
+    /// The unspent votes for the candidate uid after the block at height.
+    uint64_t get_candidate_votes(const std::string &uid,
+                                 uint64_t height = max_uint32);
 
     // wallet uid api
     bool is_uid_exist(const std::string &symbol);
@@ -322,6 +353,12 @@ class BCB_API block_chain_impl
     std::shared_ptr<business_record::list> get_address_business_record(
         const std::string &address, const std::string &symbol, size_t start_height, size_t end_height,
         uint64_t limit, uint64_t page_number) const;
+    std::shared_ptr<business_record::list> get_address_business_record(
+        const std::string &address, const std::string &symbol, size_t start_height, size_t end_height,
+        uint64_t limit, const database::history_cursor &cursor, array_index &resume) const;
+    std::shared_ptr<database::wallet_tx::list> get_wallet_history(const std::string &name,
+        database::history_cursor &cursor, uint64_t start_height, uint64_t end_height, uint64_t limit);
+    uint64_t get_wallet_history_count(const std::string &name, uint64_t start_height, uint64_t end_height);
     std::shared_ptr<wallet_address::list> get_addresses();
 
     // wallet message api
@@ -343,6 +380,8 @@ class BCB_API block_chain_impl
     organizer &get_organizer();
     bool get_transaction(const hash_digest &hash,
                          chain::transaction &tx, uint64_t &tx_height);
+    bool get_utxo(const chain::output_point &outpoint, chain::output &output,
+                  uint64_t &output_height, bool &coinbase);
     bool get_transaction_callback(const hash_digest &hash,
                                   std::function<void(const code &, const chain::transaction &)> handler);
     bool get_history_callback(const payment_address &address,
@@ -368,16 +407,6 @@ class BCB_API block_chain_impl
         return true;
     }
 
-    template <typename Handler, typename... Args>
-    void stop_write(Handler handler, Args &&... args)
-    {
-        const auto result = database_.end_write();
-        BITCOIN_ASSERT(result);
-        handler(std::forward<Args>(args)...);
-    }
-
-    void stop_write();
-    void start_write();
     void do_store(message::block_msg::ptr block,
                   block_store_handler handler);
 
@@ -385,18 +414,24 @@ class BCB_API block_chain_impl
     ////void fetch_parallel(perform_read_functor perform_read);
     void fetch_serial(perform_read_functor perform_read);
     bool stopped() const;
+    void handle_session_timer(const code &ec);
 
     std::string get_token_symbol_from_asset_data(const asset_data &data);
 
   private:
     std::atomic<bool> stopped_;
     const settings &settings_;
+    threadpool &pool_;
+
+    // Sweeps the expired wallet sessions.
+    deadline::ptr session_timer_;
 
     // These are thread safe.
     organizer organizer_;
     ////dispatcher read_dispatch_;
     ////dispatcher write_dispatch_;
     blockchain::tx_pool tx_pool_;
+    script_cache script_cache_;
 
     // This is protected by mutex.
     database::data_base database_;
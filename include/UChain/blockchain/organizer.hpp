@@ -99,6 +99,7 @@ class BCB_API organizer
     const config::checkpoint::list checkpoints_;
 
     // These are protected by the caller protecting organize().
+    threadpool &pool_;
     simple_chain &chain_;
     block_info::list process_queue_;
 
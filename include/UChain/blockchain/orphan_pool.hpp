@@ -22,8 +22,11 @@
 #define UC_BLOCKCHAIN_orphan_pool_HPP
 
 #include <cstddef>
+#include <cstdint>
+#include <map>
 #include <memory>
-#include <boost/circular_buffer.hpp>
+#include <set>
+#include <unordered_map>
 #include <UChain/coin.hpp>
 #include <UChain/blockchain/define.hpp>
 #include <UChain/blockchain/block_info.hpp>
@@ -34,7 +37,7 @@ namespace blockchain
 {
 
 /// This class is thread safe.
-/// An unordered memory pool for orphan blocks.
+/// An unordered memory pool for orphan blocks, indexed by block hash.
 class BCB_API orphan_pool
 {
   public:
@@ -54,25 +57,31 @@ class BCB_API orphan_pool
     /// Get the longest connected chain of orphans after 'end'.
     block_info::list trace(block_info::ptr end) const;
 
-    /// Get the set of unprocessed orphans.
+    /// Get the set of unprocessed orphans, most recently added first.
     block_info::list unprocessed() const;
 
     bool add_pending_block(const hash_digest &needed_block, const block_info::ptr &pending_block);
     block_info::ptr delete_pending_block(const hash_digest &needed_block);
 
   private:
-    //    typedef boost::circular_buffer<block_info::ptr> buffer;
-    typedef std::vector<block_info::ptr> buffer;
-    typedef buffer::const_iterator const_iterator;
-    typedef buffer::const_reverse_iterator const_reverse_iterator;
+    struct entry
+    {
+        block_info::ptr block;
+        uint64_t sequence;
+    };
+
+    // Blocks by hash, and blocks not yet known to be processed by the order
+    // of their arrival. Blocks are marked processed outside of the pool, so
+    // the unprocessed set is pruned as it is read.
+    typedef std::unordered_map<hash_digest, entry> block_map;
+    typedef std::map<uint64_t, block_info::ptr> sequence_map;
 
     bool exists(const hash_digest &hash) const;
-    bool exists(const chain::header &header) const;
-    const_iterator find(buffer::const_iterator begin, const hash_digest &hash) const;
-    const_reverse_iterator rfind(buffer::const_reverse_iterator begin, const hash_digest &hash) const;
 
-    // The buffer is protected by mutex.
-    buffer buffer_;
+    // The indexes are protected by mutex.
+    block_map blocks_;
+    mutable sequence_map unprocessed_;
+    uint64_t sequence_;
     mutable upgrade_mutex mutex_;
 
     std::multimap<hash_digest, block_info::ptr> pending_blocks_;
@@ -0,0 +1,83 @@
+/**
+ * Copyright (c) 2018-2020 UChain core developers (check UC-AUTHORS)
+ *
+ * This file is part of UChain.
+ *
+ * UChain is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef UC_BLOCKCHAIN_SCRIPT_CACHE_HPP
+#define UC_BLOCKCHAIN_SCRIPT_CACHE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_set>
+#include <vector>
+#include <UChain/coin.hpp>
+#include <UChain/blockchain/define.hpp>
+
+namespace libbitcoin
+{
+namespace blockchain
+{
+
+/// A bounded set of input scripts known to verify, keyed by transaction hash,
+/// input index and script flags. Keys are salted with a per-process random
+/// value so that peers cannot aim collisions at the cache.
+/// This class is thread safe.
+class BCB_API script_cache
+{
+  public:
+    script_cache(size_t capacity);
+
+    /// This class is not copyable.
+    script_cache(const script_cache &) = delete;
+    void operator=(const script_cache &) = delete;
+
+    /// True if the input script was verified under the given flags.
+    bool contains(const hash_digest &tx_hash, uint32_t input_index,
+                  uint32_t flags) const;
+
+    /// Remember a verified input script, evicting the oldest if full.
+    void insert(const hash_digest &tx_hash, uint32_t input_index,
+                uint32_t flags);
+
+    void clear();
+
+    size_t size() const;
+    uint64_t hits() const;
+    uint64_t misses() const;
+
+  private:
+    hash_digest key(const hash_digest &tx_hash, uint32_t input_index,
+                    uint32_t flags) const;
+
+    const size_t capacity_;
+    data_chunk salt_;
+    std::unordered_set<hash_digest> entries_;
+
+    // Insertion order, a ring over capacity_ slots.
+    std::vector<hash_digest> order_;
+    size_t next_;
+
+    mutable std::atomic<uint64_t> hits_;
+    mutable std::atomic<uint64_t> misses_;
+    mutable shared_mutex mutex_;
+};
+
+} // namespace blockchain
+} // namespace libbitcoin
+
+#endif
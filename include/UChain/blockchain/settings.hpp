@@ -41,6 +41,7 @@ class BCB_API settings
     /// Properties.
     uint32_t block_pool_capacity;
     uint32_t tx_pool_capacity;
+    uint32_t script_cache_capacity;
     bool tx_pool_consistency;
     bool use_testnet_rules;
     config::checkpoint::list checkpoints;
@@ -68,6 +68,11 @@ public:
         uint64_t& out_block_height,
         const hash_digest& transaction_hash) const = 0;
 
+    /// Get the unspent output of the given output point from the utxo store.
+    virtual bool get_unspent_output(chain::output& out_output,
+        uint64_t& out_height, bool& out_coinbase,
+        const chain::output_point& outpoint) const = 0;
+
     /// Import a block for the given height.
     virtual bool import(chain::block::ptr block, uint64_t height) = 0;
 
@@ -77,6 +82,11 @@ public:
     /// Remove blocks at or above the given height, returning them in order.
     virtual bool pop_from(block_info::list& out_blocks,
         uint64_t height) = 0;
+
+    /// Exclude readers while the chain changes, push and pop_from must be
+    /// called within one write section per reorganization.
+    virtual void start_write() = 0;
+    virtual void stop_write() = 0;
 };
 
 } // namespace blockchain
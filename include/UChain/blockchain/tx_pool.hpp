@@ -24,7 +24,8 @@
 #include <atomic>
 #include <cstddef>
 #include <functional>
-#include <boost/circular_buffer.hpp>
+#include <list>
+#include <unordered_map>
 #include <UChain/coin.hpp>
 #include <UChain/blockchain/define.hpp>
 #include <UChain/blockchain/block_chain.hpp>
@@ -99,12 +100,29 @@ class BCB_API tx_pool
         confirm_handler handle_confirm;
     };
 
-    typedef boost::circular_buffer<entry> buffer;
+    /// Entries in arrival order, oldest first.
+    typedef std::list<entry> buffer;
     typedef buffer::const_iterator const_iterator;
 
-    typedef std::function<bool(const chain::input &)> input_compare;
+    typedef std::unordered_map<hash_digest, buffer::iterator> entry_index;
+    typedef std::unordered_map<chain::output_point, hash_digest> spent_index;
+    typedef std::unordered_multimap<hash_digest, hash_digest> child_index;
+
     typedef message::block_msg::ptr_list block_list;
 
+    typedef std::unordered_map<std::string, size_t> reservation_map;
+
+    /// Symbols, cert keys and uids claimed by the pooled transactions.
+    struct reservations
+    {
+        reservation_map tokens;
+        reservation_map token_certs;
+        reservation_map candidates;
+        reservation_map uids;
+        reservation_map uid_addresses;
+        reservation_map uid_attaches;
+    };
+
     bool stopped();
     const_iterator find(const hash_digest &tx_hash) const;
 
@@ -121,24 +139,32 @@ class BCB_API tx_pool
     void notify_transaction(const chain::point::indexes &unconfirmed,
                             transaction_ptr tx);
 
-    void add(transaction_ptr tx, confirm_handler handler);
+    code add(transaction_ptr tx, confirm_handler handler);
     void remove(const block_list &blocks);
     void clear(const code &ec);
 
     code check_symbol_repeat(transaction_ptr tx);
+    void reserve_symbols(const chain::transaction &tx, int delta);
 
     // These would be private but for test access.
     void delete_spent_in_blocks(const block_list &blocks);
     void delete_confirmed_in_blocks(const block_list &blocks);
     void delete_dependencies(const hash_digest &tx_hash, const code &ec);
     void delete_dependencies(const chain::output_point &point, const code &ec);
-    void delete_dependencies(input_compare is_dependency, const code &ec);
     void delete_package(const code &ec);
     void delete_package(transaction_ptr tx, const code &ec);
     bool delete_single(const hash_digest &tx_hash, const code &ec);
 
-    // The buffer is protected by non-concurrent dispatch.
+    // Unlink an entry from the buffer and all indexes.
+    void erase(buffer::iterator it);
+
+    // The buffer and its indexes are protected by non-concurrent dispatch.
     buffer buffer_;
+    entry_index entries_;
+    spent_index spent_;
+    child_index children_;
+    reservations reserved_;
+    const size_t capacity_;
     std::atomic<bool> stopped_;
 
   private:
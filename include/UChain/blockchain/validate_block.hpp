@@ -65,13 +65,25 @@ class BCB_API validate_block
 
     virtual size_t get_fork_index() const { return max_size_t; }
 
+    /// The number of threads which verified input scripts in connect_block.
+    size_t script_threads() const;
+
   protected:
     typedef std::vector<uint8_t> versions;
     typedef std::function<bool()> stopped_callback;
 
+    /// An input script verification deferred by connect_input.
+    struct script_check
+    {
+        size_t tx_index;
+        size_t input_index;
+        chain::script previous_script;
+    };
+    typedef std::vector<script_check> script_checks;
+
     validate_block(size_t height, const chain::block &block,
                    bool testnet, const config::checkpoint::list &checks,
-                   stopped_callback stop_callback);
+                   stopped_callback stop_callback, threadpool *pool = nullptr);
 
     virtual bool check_get_coinage_reward_transaction(const chain::transaction &coinage_reward_coinbase, const chain::output &tx, bool is_candidate) const = 0;
     virtual uint64_t median_time_past() const = 0;
@@ -82,6 +94,8 @@ class BCB_API validate_block
     virtual bool transaction_exists(const hash_digest &tx_hash) const = 0;
     virtual bool fetch_transaction(chain::transaction &tx, size_t &tx_height,
                                    const hash_digest &tx_hash) const = 0;
+    virtual bool fetch_unspent_output(chain::output &output, size_t &output_height,
+                                      bool &coinbase, const chain::output_point &outpoint) const = 0;
     virtual bool is_output_spent(const chain::output_point &outpoint) const = 0;
     virtual bool is_output_spent(const chain::output_point &previous_output,
                                  size_t index_in_parent, size_t input_index) const = 0;
@@ -89,10 +103,16 @@ class BCB_API validate_block
     // These have default implementations that can be overriden.
     virtual bool connect_input(size_t index_in_parent,
                                const chain::transaction &current_tx, size_t input_index,
-                               uint64_t &value_in, size_t &total_sigops) const;
+                               uint64_t &value_in, size_t &total_sigops,
+                               script_checks &checks) const;
     virtual bool validate_inputs(const chain::transaction &tx,
                                  size_t index_in_parent, uint64_t &value_in,
-                                 size_t &total_sigops) const;
+                                 size_t &total_sigops, script_checks &checks) const;
+
+    /// Run the deferred script checks, across the pool if there is one.
+    /// Returns the index of the first failed check or checks.size().
+    size_t verify_scripts(const script_checks &checks,
+                          script_cache *cache = nullptr) const;
 
     // These are protected virtual for testability.
     bool stopped() const;
@@ -118,6 +138,8 @@ class BCB_API validate_block
     const chain::block &current_block_;
     const config::checkpoint::list &checkpoints_;
     const stopped_callback stop_callback_;
+    threadpool *const pool_;
+    mutable size_t script_threads_;
 };
 
 } // namespace blockchain
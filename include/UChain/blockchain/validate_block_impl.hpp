@@ -42,7 +42,7 @@ class BCB_API validate_block_impl
                         const block_info::list &orphan_chain, size_t orphan_index,
                         size_t height, const chain::block &block, bool testnet,
                         const config::checkpoint::list &checkpoints,
-                        stopped_callback stopped);
+                        stopped_callback stopped, threadpool *pool = nullptr);
     //virtual bool is_valid_proof_of_work(const chain::header& header) const;
     virtual bool check_get_coinage_reward_transaction(const chain::transaction &coinage_reward_coinbase, const chain::output &output, bool is_candidate) const;
 
@@ -63,6 +63,8 @@ class BCB_API validate_block_impl
     chain::header fetch_block(size_t fetch_height) const;
     bool fetch_transaction(chain::transaction &tx, size_t &tx_height,
                            const hash_digest &tx_hash) const;
+    bool fetch_unspent_output(chain::output &output, size_t &output_height,
+                              bool &coinbase, const chain::output_point &outpoint) const;
     bool is_output_spent(const chain::output_point &outpoint) const;
     bool is_output_spent(const chain::output_point &previous_output,
                          size_t index_in_parent, size_t input_index) const;
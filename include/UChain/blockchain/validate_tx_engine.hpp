@@ -32,6 +32,11 @@
 
 namespace libbitcoin
 {
+namespace consensus
+{
+class transaction_context;
+} // namespace consensus
+
 namespace blockchain
 {
 
@@ -49,6 +54,15 @@ class BCB_API validate_tx_engine
                                chain::point::indexes)>
         validate_handler;
 
+    /// A transaction prepared once for the script checks of all its inputs.
+    struct verify_context
+    {
+        explicit verify_context(const chain::transaction &tx);
+
+        const chain::transaction &tx;
+        std::shared_ptr<const consensus::transaction_context> prepared;
+    };
+
     validate_tx_engine(block_chain &chain, const chain::transaction &tx,
                          const tx_pool &pool, dispatcher &dispatch);
 
@@ -60,6 +74,9 @@ class BCB_API validate_tx_engine
     static bool check_consensus(const chain::script &prevout_script,
                                 const chain::transaction &current_tx, size_t input_index,
                                 uint32_t flags);
+    static bool check_consensus(const chain::script &prevout_script,
+                                const verify_context &context, size_t input_index,
+                                uint32_t flags);
 
     code check_transaction_connect_input(size_t last_height);
     code check_transaction() const;
@@ -143,6 +160,7 @@ class BCB_API validate_tx_engine
     std::string old_symbol_in_;      // used for check same token/uid/candidate symbol in previous outputs
     std::string old_cert_symbol_in_; // used for check same cert symbol in previous outputs
     uint32_t current_input_;
+    std::unique_ptr<verify_context> verify_context_;
     chain::point::indexes unconfirmed_;
     validate_handler handle_validate_;
 };
@@ -0,0 +1,104 @@
+/**
+ * Copyright (c) 2018-2020 UChain core developers (check UC-AUTHORS)
+ *
+ * This file is part of UChain.
+ *
+ * UChain is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UChain_WALLET_SESSION_HPP
+#define UChain_WALLET_SESSION_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+
+#include <UChain/coin/math/hash.hpp>
+#include <UChain/coin/utility/thread.hpp>
+
+namespace libbitcoin
+{
+namespace blockchain
+{
+
+/// Decrypted private keys of one unlocked wallet, indexed by address.
+/// Key material lives in page-locked memory and is wiped on destruction.
+class wallet_keyring
+{
+  public:
+    typedef std::shared_ptr<const wallet_keyring> ptr;
+
+    /// Receives a key in place, it must not outlive the call.
+    typedef std::function<void(const char *data, std::size_t size)> key_handler;
+
+    wallet_keyring(const hash_digest &passwd_hash, uint32_t expiry);
+    ~wallet_keyring();
+
+    wallet_keyring(const wallet_keyring &) = delete;
+    void operator=(const wallet_keyring &) = delete;
+
+    void store(const std::string &address, const std::string &prv_key);
+    bool find(const std::string &address, const key_handler &handler) const;
+
+    bool matches(const hash_digest &passwd_hash) const;
+    bool expired(uint32_t now) const;
+
+  private:
+    struct material;
+
+    const hash_digest passwd_hash_;
+    const uint32_t expiry_;
+    std::unique_ptr<material> material_;
+};
+
+/// Wallets unlocked with a timeout, keyed by wallet name.
+class wallet_session
+{
+  public:
+    static wallet_session *get_instance();
+
+    void unlock(const std::string &wallet_name, std::shared_ptr<wallet_keyring> keyring);
+    void lock(const std::string &wallet_name);
+
+    /// Returns nullptr unless the wallet is unlocked with this password.
+    wallet_keyring::ptr get(const std::string &wallet_name, const hash_digest &passwd_hash);
+
+    /// Drops the expired sessions, their keys are wiped as soon as no
+    /// request still holds them.
+    void sweep();
+
+    static uint32_t now();
+
+  private:
+    wallet_session();
+    virtual ~wallet_session();
+
+    wallet_session(const wallet_session &) = delete;
+    void operator=(const wallet_session &) = delete;
+
+    // Call with the mutex held exclusively.
+    void erase_expired(uint32_t now);
+
+    std::map<std::string, wallet_keyring::ptr> sessions_;
+
+    mutable shared_mutex mutex_;
+};
+
+} // namespace blockchain
+} // namespace libbitcoin
+#endif //UChain_WALLET_SESSION_HPP
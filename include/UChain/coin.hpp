@@ -23,6 +23,7 @@
 #include <UChain/coin/messages.hpp>
 #include <UChain/coin/version.hpp>
 #include <UChain/coin/chain/block.hpp>
+#include <UChain/coin/chain/decoded_transaction.hpp>
 #include <UChain/coin/chain/header.hpp>
 #include <UChain/coin/chain/history.hpp>
 #include <UChain/coin/chain/input.hpp>
@@ -126,6 +127,7 @@
 #include <UChain/coin/utility/notifier.hpp>
 #include <UChain/coin/utility/ostream_writer.hpp>
 #include <UChain/coin/utility/png.hpp>
+#include <UChain/coin/utility/prefix_notifier.hpp>
 #include <UChain/coin/utility/random.hpp>
 #include <UChain/coin/utility/reader.hpp>
 #include <UChain/coin/utility/resource_lock.hpp>
@@ -0,0 +1,94 @@
+/**
+ * Copyright (c) 2018-2020 UChain core developers (check UC-AUTHORS)
+ *
+ * This file is part of UChain.
+ *
+ * UChain is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef UC_CHAIN_DECODED_TRANSACTION_HPP
+#define UC_CHAIN_DECODED_TRANSACTION_HPP
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <UChain/coin/chain/transaction.hpp>
+#include <UChain/coin/define.hpp>
+#include <UChain/coin/math/hash.hpp>
+#include <UChain/coin/wallet/payment_address.hpp>
+
+namespace libbitcoin
+{
+namespace chain
+{
+
+/// The payment address of an input script.
+struct BC_API decoded_input
+{
+    typedef std::vector<decoded_input> list;
+
+    /// Invalid if the script does not match a payment pattern.
+    wallet::payment_address address;
+
+    /// The encoded address, empty if the address is invalid.
+    std::string encoded;
+};
+
+/// The payment address, attachment and stealth data of an output.
+struct BC_API decoded_output
+{
+    typedef std::vector<decoded_output> list;
+
+    /// Invalid if the script does not match a payment pattern.
+    wallet::payment_address address;
+
+    /// The encoded address, empty if the address is invalid.
+    std::string encoded;
+
+    /// The attachment type and the token, candidate or cert symbol, if any.
+    uint32_t attachment_type;
+    std::string symbol;
+
+    /// Stealth outputs are paired by convention, this one carrying the
+    /// prefix and ephemeral key for the payment in the next output.
+    bool stealth;
+    uint32_t stealth_prefix;
+    bool ephemeral;
+    hash_digest ephemeral_key;
+};
+
+/// The addresses and attachments of a transaction, decoded from its scripts
+/// once and shared by the indexers and notifiers that consume them.
+class BC_API decoded_transaction
+{
+  public:
+    typedef std::shared_ptr<const decoded_transaction> ptr;
+
+    explicit decoded_transaction(const transaction &tx);
+
+    /// The distinct encoded addresses of the inputs then outputs.
+    std::vector<std::string> addresses() const;
+
+    /// True if the output at index pays a stealth payment to the next one.
+    bool is_stealth_payment(size_t index) const;
+
+    decoded_input::list inputs;
+    decoded_output::list outputs;
+};
+
+} // namespace chain
+} // namespace libbitcoin
+
+#endif
@@ -39,6 +39,8 @@ namespace libbitcoin
 namespace chain
 {
 
+class decoded_transaction;
+
 enum transaction_version
 {
     first = 1,               //the frist version
@@ -87,6 +89,10 @@ class BC_API transaction
     void reset();
     hash_digest hash() const;
 
+    /// The addresses and attachments decoded from the scripts, cached on
+    /// first use like hash(), and like it not carried over to copies.
+    std::shared_ptr<const decoded_transaction> decoded() const;
+
     // sighash_type is used by OP_CHECKSIG
     hash_digest hash(uint32_t sighash_type) const;
     bool is_coinbase() const;
@@ -118,6 +124,7 @@ class BC_API transaction
   private:
     mutable upgrade_mutex mutex_;
     mutable std::shared_ptr<hash_digest> hash_;
+    mutable std::shared_ptr<const decoded_transaction> decoded_;
 };
 
 } // namespace chain
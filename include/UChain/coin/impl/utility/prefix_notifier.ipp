@@ -0,0 +1,342 @@
+/**
+ * Copyright (c) 2018-2020 UChain core developers (check UC-AUTHORS)
+ *
+ * This file is part of UChain.
+ *
+ * UChain is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef UC_PREFIX_NOTIFIER_IPP
+#define UC_PREFIX_NOTIFIER_IPP
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <UChain/coin/utility/asio.hpp>
+#include <UChain/coin/utility/assert.hpp>
+#include <UChain/coin/utility/binary.hpp>
+#include <UChain/coin/utility/dispatcher.hpp>
+#include <UChain/coin/utility/thread.hpp>
+#include <UChain/coin/utility/threadpool.hpp>
+
+namespace libbitcoin
+{
+
+template <typename Key, typename... Args>
+prefix_notifier<Key, Args...>::prefix_notifier(threadpool &pool,
+                                               size_t limit, const std::string &class_name)
+    : limit_(limit), stopped_(true), count_(0), dispatch_(pool, class_name)
+{
+}
+
+template <typename Key, typename... Args>
+prefix_notifier<Key, Args...>::~prefix_notifier()
+{
+    BITCOIN_ASSERT_MSG(subscriptions_.empty(), "prefix notifier not cleared");
+}
+
+template <typename Key, typename... Args>
+void prefix_notifier<Key, Args...>::start()
+{
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    unique_lock lock(subscribe_mutex_);
+    stopped_ = false;
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+template <typename Key, typename... Args>
+void prefix_notifier<Key, Args...>::stop()
+{
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    unique_lock lock(subscribe_mutex_);
+    stopped_ = true;
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+template <typename Key, typename... Args>
+void prefix_notifier<Key, Args...>::subscribe(handler handler, const Key &key,
+                                              const binary &prefix, const asio::duration &duration,
+                                              Args... stopped_args)
+{
+    const auto expires = asio::steady_clock::now() + duration;
+
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    subscribe_mutex_.lock();
+
+    if (!stopped_)
+    {
+        const auto by_length = subscriptions_.find(prefix.size());
+
+        if (by_length != subscriptions_.end())
+        {
+            const auto by_prefix = by_length->second.find(prefix);
+
+            if (by_prefix != by_length->second.end())
+            {
+                const auto it = by_prefix->second.find(key);
+
+                if (it != by_prefix->second.end())
+                {
+                    it->second.expires = expires;
+                    subscribe_mutex_.unlock();
+                    //---------------------------------------------------------
+                    return;
+                }
+            }
+        }
+
+        if (limit_ == 0 || count_ < limit_)
+        {
+            insert({prefix, key, {handler, expires}});
+            subscribe_mutex_.unlock();
+            //-----------------------------------------------------------------
+            return;
+        }
+    }
+
+    subscribe_mutex_.unlock();
+    ///////////////////////////////////////////////////////////////////////////
+
+    // Limit exceeded and stopped share the same return arguments.
+    handler(stopped_args...);
+}
+
+template <typename Key, typename... Args>
+void prefix_notifier<Key, Args...>::unsubscribe(const Key &key,
+                                                const binary &prefix, Args... unsubscribed_args)
+{
+    handler removed;
+
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    subscribe_mutex_.lock();
+    const auto found = !stopped_ && erase(key, prefix, &removed);
+    subscribe_mutex_.unlock();
+    ///////////////////////////////////////////////////////////////////////////
+
+    if (found)
+        removed(unsubscribed_args...);
+}
+
+template <typename Key, typename... Args>
+void prefix_notifier<Key, Args...>::purge(Args... expired_args)
+{
+    const auto now = asio::steady_clock::now();
+
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    subscribe_mutex_.lock();
+
+    // Move subscribers from the member tables to a temporary list.
+    const auto subscriptions = take_all();
+
+    subscribe_mutex_.unlock();
+    ///////////////////////////////////////////////////////////////////////////
+
+    // Subscriptions may be created while this loop is executing.
+    // Invoke and discard expired subscribers from temporary list.
+    for (const auto &item : subscriptions)
+    {
+        if (now > item.subscription.expires)
+        {
+            item.subscription.notify(expired_args...);
+            continue;
+        }
+
+        // Critical Section
+        ///////////////////////////////////////////////////////////////////
+        unique_lock lock(subscribe_mutex_);
+        insert(item);
+        ///////////////////////////////////////////////////////////////////
+    }
+}
+
+template <typename Key, typename... Args>
+void prefix_notifier<Key, Args...>::invoke(Args... args)
+{
+    do_invoke(args...);
+}
+
+template <typename Key, typename... Args>
+void prefix_notifier<Key, Args...>::relay(const binary &field, Args... args)
+{
+    // This enqueues work while maintaining order.
+    dispatch_.ordered(&prefix_notifier<Key, Args...>::do_relay,
+                      this->shared_from_this(), field, args...);
+}
+
+// private
+template <typename Key, typename... Args>
+void prefix_notifier<Key, Args...>::do_invoke(Args... args)
+{
+    // Critical Section (prevent concurrent handler execution)
+    ///////////////////////////////////////////////////////////////////////////
+    unique_lock lock(invoke_mutex_);
+
+    // Critical Section (protect stop)
+    ///////////////////////////////////////////////////////////////////////////
+    subscribe_mutex_.lock();
+
+    // Move subscribers from the member tables to a temporary list.
+    const auto subscriptions = take_all();
+
+    subscribe_mutex_.unlock();
+    ///////////////////////////////////////////////////////////////////////////
+
+    // Subscriptions may be created while this loop is executing.
+    // Invoke subscribers from temporary list and resubscribe as indicated.
+    for (const auto &item : subscriptions)
+    {
+        if (item.subscription.notify(args...))
+        {
+            // Critical Section
+            ///////////////////////////////////////////////////////////////////
+            subscribe_mutex_.lock();
+
+            if (!stopped_)
+                insert(item);
+
+            subscribe_mutex_.unlock();
+            ///////////////////////////////////////////////////////////////////
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+// private
+template <typename Key, typename... Args>
+void prefix_notifier<Key, Args...>::do_relay(const binary &field,
+                                             Args... args)
+{
+    entries matches;
+
+    // Critical Section (prevent concurrent handler execution)
+    ///////////////////////////////////////////////////////////////////////////
+    unique_lock lock(invoke_mutex_);
+
+    // Critical Section (collect matches)
+    ///////////////////////////////////////////////////////////////////////////
+    subscribe_mutex_.lock_shared();
+
+    // Tables are ordered by prefix length, so stop once longer than field.
+    for (const auto &by_length : subscriptions_)
+    {
+        if (by_length.first > field.size())
+            break;
+
+        const auto prefix = field.substring(0, by_length.first);
+        const auto by_prefix = by_length.second.find(prefix);
+
+        if (by_prefix == by_length.second.end())
+            continue;
+
+        for (const auto &subscription : by_prefix->second)
+            matches.push_back({prefix, subscription.first, subscription.second});
+    }
+
+    subscribe_mutex_.unlock_shared();
+    ///////////////////////////////////////////////////////////////////////////
+
+    // Subscriptions may be changed while this loop is executing.
+    // Remove subscribers that decline further notifications.
+    for (const auto &item : matches)
+    {
+        if (!item.subscription.notify(args...))
+        {
+            // Critical Section
+            ///////////////////////////////////////////////////////////////////
+            subscribe_mutex_.lock();
+            erase(item.key, item.prefix, nullptr);
+            subscribe_mutex_.unlock();
+            ///////////////////////////////////////////////////////////////////
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+// private
+template <typename Key, typename... Args>
+typename prefix_notifier<Key, Args...>::entries
+prefix_notifier<Key, Args...>::take_all()
+{
+    entries subscriptions;
+    subscriptions.reserve(count_);
+
+    for (const auto &by_length : subscriptions_)
+        for (const auto &by_prefix : by_length.second)
+            for (const auto &subscription : by_prefix.second)
+                subscriptions.push_back(
+                    {by_prefix.first, subscription.first, subscription.second});
+
+    subscriptions_.clear();
+    count_ = 0;
+    return subscriptions;
+}
+
+// private
+template <typename Key, typename... Args>
+void prefix_notifier<Key, Args...>::insert(const entry &item)
+{
+    auto &subscriptions = subscriptions_[item.prefix.size()][item.prefix];
+
+    if (subscriptions.emplace(item.key, item.subscription).second)
+        ++count_;
+}
+
+// private
+template <typename Key, typename... Args>
+bool prefix_notifier<Key, Args...>::erase(const Key &key,
+                                          const binary &prefix, handler *removed)
+{
+    const auto by_length = subscriptions_.find(prefix.size());
+
+    if (by_length == subscriptions_.end())
+        return false;
+
+    const auto by_prefix = by_length->second.find(prefix);
+
+    if (by_prefix == by_length->second.end())
+        return false;
+
+    const auto it = by_prefix->second.find(key);
+
+    if (it == by_prefix->second.end())
+        return false;
+
+    if (removed != nullptr)
+        *removed = it->second.notify;
+
+    by_prefix->second.erase(it);
+    --count_;
+
+    // Drop emptied tables so relay only probes populated prefix lengths.
+    if (by_prefix->second.empty())
+        by_length->second.erase(by_prefix);
+
+    if (by_length->second.empty())
+        subscriptions_.erase(by_length);
+
+    return true;
+}
+
+} // namespace libbitcoin
+
+#endif
@@ -21,6 +21,7 @@
 #define UC_AES256_HPP
 
 #include <cstdint>
+#include <memory>
 #include <UChain/coin/compat.hpp>
 #include <UChain/coin/define.hpp>
 #include <UChain/coin/utility/data.hpp>
@@ -40,6 +41,35 @@ typedef byte_array<aes256_key_size> aes_secret;
 BC_CONSTEXPR uint8_t aes256_block_size = 16;
 typedef byte_array<aes256_block_size> aes_block;
 
+/**
+ * An aes256 key with its schedule expanded once, for use on a sequence of
+ * data blocks. The AES instructions are used when the cpu supports them.
+ */
+class BC_API aes256_key
+{
+  public:
+    explicit aes256_key(const aes_secret &key);
+    ~aes256_key();
+
+    /// This class is not copyable, the schedule is erased on destruct.
+    aes256_key(const aes256_key &) = delete;
+    aes256_key &operator=(const aes256_key &) = delete;
+
+    /**
+     * Perform aes256 encryption on the specified data block.
+     */
+    void encrypt(aes_block &block);
+
+    /**
+     * Perform aes256 decryption on the specified data block.
+     */
+    void decrypt(aes_block &block);
+
+  private:
+    struct schedule;
+    std::unique_ptr<schedule> schedule_;
+};
+
 /**
  * Perform aes256 encryption on the specified data block.
  */
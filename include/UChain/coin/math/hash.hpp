@@ -167,6 +167,14 @@ BC_API hash_digest bitcoin_hash(data_slice data);
  */
 BC_API short_hash bitcoin_short_hash(data_slice data);
 
+/**
+ * Generate the bitcoin hash of each pair of adjacent hashes, as for a
+ * level of a merkle tree. The number of hashes must be even.
+ *
+ * sha256(sha256(left + right))
+ */
+BC_API hash_list bitcoin_hash_pairs(const hash_list &hashes);
+
 /**
  * Generate a scrypt hash of specified length.
  *
@@ -0,0 +1,126 @@
+/**
+ * Copyright (c) 2018-2020 UChain core developers (check UC-AUTHORS)
+ *
+ * This file is part of UChain.
+ *
+ * UChain is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef UC_PREFIX_NOTIFIER_HPP
+#define UC_PREFIX_NOTIFIER_HPP
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <UChain/coin/utility/asio.hpp>
+#include <UChain/coin/utility/binary.hpp>
+#include <UChain/coin/utility/dispatcher.hpp>
+#include <UChain/coin/utility/enable_shared_from_base.hpp>
+#include <UChain/coin/utility/thread.hpp>
+#include <UChain/coin/utility/threadpool.hpp>
+
+namespace libbitcoin
+{
+
+/// A notifier whose subscriptions are filtered by a binary prefix.
+/// Subscriptions are indexed by prefix length and then by prefix, so relay
+/// probes one table per distinct length and invokes only the handlers whose
+/// prefix matches the relayed field, rather than every subscriber.
+template <typename Key, typename... Args>
+class prefix_notifier
+    : public enable_shared_from_base<prefix_notifier<Key, Args...>>
+{
+  public:
+    typedef std::function<bool(Args...)> handler;
+    typedef std::shared_ptr<prefix_notifier<Key, Args...>> ptr;
+
+    /// Construct an instance.
+    /// A limit of zero is unlimited, the class_name is for debugging.
+    prefix_notifier(threadpool &pool, size_t limit,
+                    const std::string &class_name);
+    ~prefix_notifier();
+
+    /// Enable new subscriptions.
+    void start();
+
+    /// Prevent new subscriptions.
+    void stop();
+
+    /// Subscribe to notifications of fields matching prefix for duration.
+    /// Return true from the handler to resubscribe to notifications.
+    /// If key and prefix are matched the subscription is extended.
+    /// If stopped this will invoke the hander with the specified arguments.
+    void subscribe(handler handler, const Key &key, const binary &prefix,
+                   const asio::duration &duration, Args... stopped_args);
+
+    /// Remove the subscription matching the specified key and prefix.
+    /// If subscribed this invokes notification with the specified arguments.
+    void unsubscribe(const Key &key, const binary &prefix,
+                     Args... unsubscribed_args);
+
+    /// Remove any expired subscriptions (blocking).
+    /// Invokes expiration notification with the specified arguments.
+    void purge(Args... expired_args);
+
+    /// Invoke all handlers sequentially (blocking).
+    void invoke(Args... args);
+
+    /// Invoke handlers with a prefix of field sequentially (non-blocking).
+    void relay(const binary &field, Args... args);
+
+  private:
+    typedef struct
+    {
+        handler notify;
+        asio::time_point expires;
+    } value;
+
+    typedef struct
+    {
+        binary prefix;
+        Key key;
+        value subscription;
+    } entry;
+
+    typedef std::vector<entry> entries;
+    typedef std::unordered_map<Key, value> bucket;
+    typedef std::unordered_map<binary, bucket> table;
+    typedef std::map<size_t, table> tables;
+
+    void do_invoke(Args... args);
+    void do_relay(const binary &field, Args... args);
+
+    // These require subscribe_mutex_ to be held exclusively.
+    entries take_all();
+    void insert(const entry &item);
+    bool erase(const Key &key, const binary &prefix, handler *removed);
+
+    const size_t limit_;
+    bool stopped_;
+    size_t count_;
+    tables subscriptions_;
+    dispatcher dispatch_;
+    mutable upgrade_mutex invoke_mutex_;
+    mutable upgrade_mutex subscribe_mutex_;
+};
+
+} // namespace libbitcoin
+
+#include <UChain/coin/impl/utility/prefix_notifier.ipp>
+
+#endif
@@ -157,11 +157,19 @@ BC_API bool create_key_pair(encrypted_private &out_private,
 void aes256_common_encrypt(data_chunk &mnemonic, data_chunk &passphrase, data_chunk &encry_output);
 void aes256_common_decrypt(const data_chunk &mnemonic, data_chunk &passphrase, data_chunk &decry_output);
 
+/// The aes secret that encrypt_string and decrypt_string derive from a
+/// passphrase, construct one aes256_key from it to handle many strings.
+aes_secret passphrase_secret(const std::string &passphrase);
+
 void encrypt_string(const std::string &mnemonic,
                     std::string &passphrase, std::string &encry_output);
+void encrypt_string(const std::string &mnemonic,
+                    aes256_key &key, std::string &encry_output);
 
 void decrypt_string(const std::string &mnemonic,
                     std::string &passphrase, std::string &decry_output);
+void decrypt_string(const std::string &mnemonic,
+                    aes256_key &key, std::string &decry_output);
 
 #ifdef WITH_ICU
 
@@ -24,11 +24,15 @@
 #include <UChain/database/databases/spend_db.hpp>
 #include <UChain/database/databases/stealth_db.hpp>
 #include <UChain/database/databases/tx_db.hpp>
+#include <UChain/database/databases/utxo_db.hpp>
+#include <UChain/database/databases/address_balance_db.hpp>
+#include <UChain/database/databases/chain_work_db.hpp>
 #include <UChain/database/memory/accessor.hpp>
 #include <UChain/database/memory/allocator.hpp>
 #include <UChain/database/memory/memory.hpp>
 #include <UChain/database/memory/memory_map.hpp>
 #include <UChain/database/primitives/hash_table_header.hpp>
+#include <UChain/database/primitives/history_cursor.hpp>
 #include <UChain/database/primitives/record_hash_table.hpp>
 #include <UChain/database/primitives/record_list.hpp>
 #include <UChain/database/primitives/record_manager.hpp>
@@ -39,5 +43,6 @@
 #include <UChain/database/primitives/slab_manager.hpp>
 #include <UChain/database/result/block_result.hpp>
 #include <UChain/database/result/tx_result.hpp>
+#include <UChain/database/result/utxo_result.hpp>
 
 #endif
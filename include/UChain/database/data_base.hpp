@@ -22,14 +22,22 @@
 #define UC_DATABASE_DATA_BASE_HPP
 
 #include <atomic>
+#include <condition_variable>
 #include <cstddef>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
 #include <boost/filesystem.hpp>
 #include <boost/interprocess/sync/file_lock.hpp>
 #include <UChain/coin.hpp>
 #include <UChain/database/databases/block_db.hpp>
 #include <UChain/database/databases/spend_db.hpp>
 #include <UChain/database/databases/tx_db.hpp>
+#include <UChain/database/databases/utxo_db.hpp>
+#include <UChain/database/databases/address_balance_db.hpp>
+#include <UChain/database/databases/chain_work_db.hpp>
 #include <UChain/database/databases/history_db.hpp>
 #include <UChain/database/databases/stealth_db.hpp>
 #include <UChain/database/define.hpp>
@@ -46,6 +54,7 @@
 
 #include <UChainService/data/databases/wallet_db.hpp>
 #include <UChainService/data/databases/wallet_address_db.hpp>
+#include <UChainService/data/databases/wallet_history_db.hpp>
 #include <UChainService/data/databases/token_db.hpp>
 #include <UChainService/data/databases/blockchain_token_db.hpp>
 #include <UChainService/data/databases/address_token_db.hpp>
@@ -56,6 +65,7 @@
 #include <UChainService/data/databases/address_uid_db.hpp>
 #include <UChainService/data/databases/blockchain_candidate_db.hpp>
 #include <UChainService/data/databases/candidate_history_db.hpp>
+#include <UChainService/data/databases/candidate_vote_db.hpp>
 
 using namespace libbitcoin::wallet;
 using namespace libbitcoin::chain;
@@ -79,21 +89,44 @@ class BCD_API data_base
         bool touch_all() const;
         bool touch_uids() const;
         bool uids_exist() const;
+        bool touch_uid_addresses() const;
+        bool uid_addresses_complete() const;
+        bool complete_uid_addresses() const;
         bool touch_tokens() const;
         bool tokens_exist() const;
         bool touch_certs() const;
         bool certs_exist() const;
         bool touch_candidates() const;
         bool candidates_exist() const;
+        bool touch_utxos() const;
+        bool utxos_complete() const;
+        bool complete_utxos() const;
+        bool touch_balances() const;
+        bool balances_complete() const;
+        bool complete_balances() const;
+        bool touch_wallet_history() const;
+        bool wallet_history_complete() const;
+        bool complete_wallet_history() const;
+        bool touch_candidate_votes() const;
+        bool candidate_votes_complete() const;
+        bool complete_candidate_votes() const;
+        bool touch_chain_work() const;
+        bool chain_work_complete() const;
+        bool complete_chain_work() const;
 
         path database_lock;
         path blocks_lookup;
         path blocks_index;
+        path chain_work_index;
         path history_lookup;
         path history_rows;
         path stealth_rows;
         path spends_lookup;
         path transactions_lookup;
+        path utxos_lookup;
+        path balances_lookup;
+        path frozen_lookup;
+        path frozen_rows;
         /* begin database for wallet, token, address_token, uid relationship */
         path wallets_lookup;
         path tokens_lookup;
@@ -103,16 +136,32 @@ class BCD_API data_base
         path wallet_tokens_lookup;
         path wallet_tokens_rows;
         path uids_lookup;
+        path uid_addresses_lookup;
+        path uid_addresses_rows;
         path address_uids_lookup;
         path address_uids_rows;
         path wallet_addresses_lookup;
         path wallet_addresses_rows;
+        path wallet_history_lookup;
+        path wallet_history_rows;
+        path wallet_owners_lookup;
+        path wallet_owners_rows;
         /* end database for wallet, token, address_token, uid ,address_uid relationship */
         path candidates_lookup;
         path address_candidates_lookup;
         path address_candidates_rows;
         path candidate_history_lookup;
         path candidate_history_rows;
+        path candidate_votes_lookup;
+        path candidate_votes_rows;
+
+        // Written once an index is fully built, see utxos_complete().
+        path utxos_flag;
+        path balances_flag;
+        path uid_addresses_flag;
+        path wallet_history_flag;
+        path candidate_votes_flag;
+        path chain_work_flag;
     };
 
     class db_metadata
@@ -144,6 +193,24 @@ class BCD_API data_base
     static bool initialize(const path &prefix, const chain::block &genesis);
     /// If database exists then upgrades to version 63.
     static bool upgrade_version_63(const path &prefix);
+    /// If database exists without a complete utxo table then builds it
+    /// from the confirmed chain.
+    static bool upgrade_utxos(const path &prefix);
+    /// If database exists without a complete address balance table then
+    /// builds it from the confirmed chain.
+    static bool upgrade_balances(const path &prefix);
+    /// If database exists without a complete uid address index then builds it
+    /// from the uid table.
+    static bool upgrade_uid_addresses(const path &prefix);
+    /// If database exists without the wallet history timeline then builds it
+    /// from the wallet addresses.
+    static bool upgrade_wallet_history(const path &prefix);
+    /// If database exists without the candidate vote tally then builds it
+    /// from the confirmed chain.
+    static bool upgrade_candidate_votes(const path &prefix);
+    /// If database exists without the chain work index then builds it
+    /// from the block headers.
+    static bool upgrade_chain_work(const path &prefix);
 
     static bool touch_file(const path &file_path);
     static void write_metadata(const path &metadata_path, data_base::db_metadata &metadata);
@@ -162,6 +229,11 @@ class BCD_API data_base
     bool create_tokens();
     bool create_certs();
     bool create_candidates();
+    bool create_utxos();
+    bool create_balances();
+    bool create_wallet_history();
+    bool create_candidate_votes();
+    bool create_chain_work();
 
     /// Start all databases.
     bool start();
@@ -176,6 +248,11 @@ class BCD_API data_base
     // ------------------------------------------------------------------------
 
     handle begin_read();
+
+    /// Wait until no write is in progress, then begin a read. Writers notify
+    /// on completion, so the wait is bounded by the write, not a poll period.
+    handle begin_read_wait();
+
     bool begin_write();
     bool end_write();
     bool is_read_valid(handle handle);
@@ -194,9 +271,16 @@ class BCD_API data_base
     /// Throws if the chain is empty.
     chain::block pop();
 
+    /// Add the history of an address to the timeline of its wallet.
+    void push_wallet_address(const std::string &name, const std::string &address);
+
+    /// Drop the history of addresses removed from a wallet.
+    void pop_wallet_addresses(const std::string &name,
+                              const std::vector<std::string> &addresses);
+
     /* begin store token info into  database */
 
-    void push_asset(const asset &attach, const payment_address &address,
+    void push_asset(const asset &attach, const std::string &address_str,
                     const output_point &outpoint, uint32_t output_height, uint64_t value);
 
     void push_ucn(const ucn &ucn, const short_hash &key,
@@ -314,6 +398,8 @@ class BCD_API data_base
   private:
     typedef chain::input::list inputs;
     typedef chain::output::list outputs;
+    typedef chain::decoded_input::list decoded_inputs;
+    typedef chain::decoded_output::list decoded_outputs;
     typedef std::atomic<size_t> sequential_lock;
     typedef boost::interprocess::file_lock file_lock;
 
@@ -321,6 +407,12 @@ class BCD_API data_base
     static bool initialize_tokens(const path &prefix);
     static bool initialize_certs(const path &prefix);
     static bool initialize_candidates(const path &prefix);
+    static bool initialize_utxos(const path &prefix);
+    static bool initialize_balances(const path &prefix);
+    static bool initialize_uid_addresses(const path &prefix);
+    static bool initialize_wallet_history(const path &prefix);
+    static bool initialize_candidate_votes(const path &prefix);
+    static bool initialize_chain_work(const path &prefix);
 
     static void uninitialize_lock(const path &lock);
     static file_lock initialize_lock(const path &lock);
@@ -332,13 +424,32 @@ class BCD_API data_base
     void synchronize_candidates();
 
     void push_inputs(const hash_digest &tx_hash, size_t height,
-                     const inputs &inputs);
+                     const inputs &inputs, const decoded_inputs &decoded);
     void push_outputs(const hash_digest &tx_hash, size_t height,
-                      const outputs &outputs);
+                      const outputs &outputs, const decoded_outputs &decoded);
     void push_stealth(const hash_digest &tx_hash, size_t height,
-                      const outputs &outputs);
-    void pop_inputs(const inputs &inputs, size_t height);
-    void pop_outputs(const outputs &outputs, size_t height);
+                      const decoded_outputs &decoded);
+    void push_utxos(const chain::transaction &tx, const hash_digest &tx_hash,
+                    size_t height);
+    void pop_inputs(const inputs &inputs, const decoded_inputs &decoded,
+                    size_t height);
+    void pop_outputs(const outputs &outputs, const decoded_outputs &decoded,
+                     size_t height);
+    void pop_utxos(const chain::transaction &tx, const hash_digest &tx_hash);
+    bool get_previous_output(const chain::output_point &previous,
+                             chain::output &output) const;
+    void push_balances(const chain::transaction &tx, const hash_digest &tx_hash,
+                       size_t height);
+    void pop_balances(const chain::transaction &tx, size_t height);
+    void push_votes(const chain::transaction &tx, size_t height);
+    void pop_votes(const chain::transaction &tx, size_t height);
+    void push_vote(const chain::output &output, size_t height, bool spend);
+
+    typedef std::map<short_hash, wallet_tx::list> wallet_history_map;
+    std::vector<short_hash> wallet_history_owners(const chain::transaction &tx);
+    void push_wallet_history(const chain::transaction &tx, const hash_digest &tx_hash,
+                             size_t height, wallet_history_map &wallets);
+    void rebuild_wallet_history(const short_hash &wallet_key);
 
     const path lock_file_path_;
     const size_t history_height_;
@@ -347,6 +458,14 @@ class BCD_API data_base
     // Atomic counter for implementing the sequential lock pattern.
     sequential_lock sequential_lock_;
 
+    // Wakes readers waiting on a write in progress.
+    std::mutex write_mutex_;
+    std::condition_variable write_completed_;
+
+    // Serializes block push and pop with wallet address changes, which both
+    // write the wallet timelines.
+    std::mutex wallet_history_mutex_;
+
     // Allows us to restrict database access to our process (or fail).
     std::shared_ptr<file_lock> file_lock_;
 
@@ -359,10 +478,13 @@ class BCD_API data_base
   public:
     /// Individual database query engines.
     block_database blocks;
+    chain_work_database chain_work;
     history_database history;
     spend_database spends;
     stealth_database stealth;
     tx_database transactions;
+    utxo_database utxos;
+    address_balance_database balances;
     /* begin database for wallet, token, address_token,uid relationship */
     wallet_database wallets;
     blockchain_token_database tokens;
@@ -372,9 +494,11 @@ class BCD_API data_base
     blockchain_uid_database uids;
     address_uid_database address_uids;
     wallet_address_database wallet_addresses;
+    wallet_history_database wallet_history;
     /* end database for wallet, token, address_token relationship */
     blockchain_candidate_database candidates;
     candidate_history_database candidate_history;
+    candidate_vote_database candidate_votes;
 };
 
 } // namespace database
@@ -0,0 +1,159 @@
+/**
+ * Copyright (c) 2018-2020 UChain core developers (check UC-AUTHORS)
+ *
+ * This file is part of UChain.
+ *
+ * UChain is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef UC_DATABASE_ADDRESS_BALANCE_DATABASE_HPP
+#define UC_DATABASE_ADDRESS_BALANCE_DATABASE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <boost/filesystem.hpp>
+#include <UChain/coin.hpp>
+#include <UChain/database/define.hpp>
+#include <UChain/database/memory/memory_map.hpp>
+#include <UChain/database/primitives/record_hash_table.hpp>
+#include <UChain/database/primitives/record_multimap.hpp>
+
+namespace libbitcoin
+{
+namespace database
+{
+
+/// Confirmed totals of one (address, symbol) pair, symbol is empty for ucn.
+struct BCD_API address_balance
+{
+    uint64_t total_received;
+    uint64_t unspent_balance;
+
+    /// Largest lock height of any deposit ever made to the address.
+    uint32_t max_lock_height;
+};
+
+/// A deposit or coinbase output which may still be frozen.
+struct BCD_API frozen_output
+{
+    typedef std::vector<frozen_output> list;
+
+    chain::output_point point;
+    uint32_t output_height;
+    uint32_t lock_height;
+    bool coinbase;
+    uint64_t value;
+};
+
+/// Incrementally maintained balance aggregate of every address.
+/// The totals table is keyed by sha256(address + ':' + symbol) and updated
+/// in place as outputs are confirmed and spent. Deposit and coinbase outputs
+/// are also appended to a per-address row list, newest first, so that the
+/// frozen balance only scans the outputs which may not have expired yet.
+/// The data_base reverses every update on pop.
+class BCD_API address_balance_database
+{
+  public:
+    /// Construct the database.
+    address_balance_database(const boost::filesystem::path &totals_filename,
+                             const boost::filesystem::path &frozen_lookup_filename,
+                             const boost::filesystem::path &frozen_rows_filename,
+                             std::shared_ptr<shared_mutex> mutex = nullptr);
+
+    /// Close the database (all threads must first be stopped).
+    ~address_balance_database();
+
+    /// Initialize a new address balance database.
+    bool create();
+
+    /// Call before using the database.
+    bool start();
+
+    /// Call to signal a stop of current operations.
+    bool stop();
+
+    /// Call to unload the memory map.
+    bool close();
+
+    /// Fetch the totals of address, all zero if never used.
+    address_balance get(const std::string &address,
+                        const std::string &symbol = "") const;
+
+    /// Fetch the deposit and coinbase outputs of address which are still
+    /// frozen at the given top height.
+    frozen_output::list get_frozen(const std::string &address,
+                                   uint64_t top_height, uint32_t coinbase_maturity) const;
+
+    /// Account an output received by address.
+    void store_output(const std::string &address, const std::string &symbol,
+                      uint64_t value);
+
+    /// Account an output of address being spent.
+    void store_input(const std::string &address, const std::string &symbol,
+                     uint64_t value);
+
+    /// Reverse store_output.
+    void remove_output(const std::string &address, const std::string &symbol,
+                       uint64_t value);
+
+    /// Reverse store_input.
+    void remove_input(const std::string &address, const std::string &symbol,
+                      uint64_t value);
+
+    /// Append a deposit (lock_height > 0) or coinbase output of address.
+    void store_frozen(const std::string &address, const frozen_output &row);
+
+    /// Delete the last frozen row added to address.
+    void delete_last_frozen(const std::string &address);
+
+    /// Synchronise storage with disk so things are consistent.
+    /// Should be done at the end of every block write.
+    void sync();
+
+  private:
+    typedef record_hash_table<hash_digest> totals_map;
+    typedef record_hash_table<short_hash> record_map;
+    typedef record_multimap<short_hash> record_multiple_map;
+
+    void update(const std::string &address, const std::string &symbol,
+                int64_t received, int64_t unspent, uint32_t lock_height);
+
+    /// Hash table of the totals by address and symbol.
+    memory_map totals_file_;
+    record_hash_table_header totals_header_;
+    record_manager totals_manager_;
+    totals_map totals_map_;
+
+    /// Hash table used for start index lookup for frozen rows by address.
+    memory_map lookup_file_;
+    record_hash_table_header lookup_header_;
+    record_manager lookup_manager_;
+    record_map lookup_map_;
+
+    /// List of frozen rows.
+    memory_map rows_file_;
+    record_manager rows_manager_;
+    record_list rows_list_;
+    record_multiple_map rows_multimap_;
+
+    mutable shared_mutex mutex_;
+};
+
+} // namespace database
+} // namespace libbitcoin
+
+#endif
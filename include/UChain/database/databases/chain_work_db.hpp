@@ -0,0 +1,88 @@
+/**
+ * Copyright (c) 2018-2020 UChain core developers (check UC-AUTHORS)
+ *
+ * This file is part of UChain.
+ *
+ * UChain is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef UC_DATABASE_CHAIN_WORK_DATABASE_HPP
+#define UC_DATABASE_CHAIN_WORK_DATABASE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <boost/filesystem.hpp>
+#include <UChain/coin.hpp>
+#include <UChain/database/define.hpp>
+#include <UChain/database/memory/memory_map.hpp>
+#include <UChain/database/primitives/record_manager.hpp>
+
+namespace libbitcoin
+{
+namespace database
+{
+
+/// The cumulative work of the chain through each height, indexed by height
+/// like the block index. The work of the chain above a fork point is the
+/// difference of two records.
+class BCD_API chain_work_database
+{
+  public:
+    /// Construct the database.
+    chain_work_database(const boost::filesystem::path &index_filename,
+                        std::shared_ptr<shared_mutex> mutex = nullptr);
+
+    /// Close the database (all threads must first be stopped).
+    ~chain_work_database();
+
+    /// Initialize a new chain_work database.
+    bool create();
+
+    /// Call before using the database.
+    bool start();
+
+    /// Call to signal a stop of current operations.
+    bool stop();
+
+    /// Call to unload the memory map.
+    bool close();
+
+    /// The cumulative work through height, false if it is not indexed.
+    bool get(uint64_t &out_work, size_t height) const;
+
+    /// Add the work of the block header at height, which must be the next
+    /// height of the index. A gap leaves the heights above it unindexed.
+    void store(const chain::header &header, size_t height);
+
+    /// Unlink the work of all blocks upwards from (and including) from_height.
+    void unlink(size_t from_height);
+
+    /// Synchronise storage with disk so things are consistent.
+    /// Should be done at the end of every block write.
+    void sync();
+
+    /// The work of a single block header.
+    static uint64_t header_work(const chain::header &header);
+
+  private:
+    /// Table of cumulative work by height.
+    memory_map index_file_;
+    record_manager index_manager_;
+};
+
+} // namespace database
+} // namespace libbitcoin
+
+#endif
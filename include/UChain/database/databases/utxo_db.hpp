@@ -0,0 +1,97 @@
+/**
+ * Copyright (c) 2018-2020 UChain core developers (check UC-AUTHORS)
+ *
+ * This file is part of UChain.
+ *
+ * UChain is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef UC_DATABASE_UTXO_DATABASE_HPP
+#define UC_DATABASE_UTXO_DATABASE_HPP
+
+#include <cstddef>
+#include <memory>
+#include <boost/filesystem.hpp>
+#include <UChain/coin.hpp>
+#include <UChain/database/define.hpp>
+#include <UChain/database/memory/memory_map.hpp>
+#include <UChain/database/primitives/slab_hash_table.hpp>
+#include <UChain/database/primitives/slab_manager.hpp>
+#include <UChain/database/result/utxo_result.hpp>
+
+namespace libbitcoin
+{
+namespace database
+{
+
+/// This enables lookup of an unspent output by its output point, without
+/// deserializing the whole transaction which created it.
+/// Each record holds the output height, the coinbase flag and the
+/// serialized output (value, script and attachment).
+/// Records are added when an output is confirmed and removed when it is
+/// spent, the data_base restores spent records on pop.
+/// The slab file is append-only: a removed record is unlinked but its space
+/// is not reused, so the file grows with every output ever stored. It is
+/// compacted offline by deleting the utxo_table_complete flag, the next
+/// start then truncates the table and replays only the unspent outputs.
+class BCD_API utxo_database
+{
+  public:
+    /// Construct the database.
+    utxo_database(const boost::filesystem::path &map_filename,
+                  std::shared_ptr<shared_mutex> mutex = nullptr);
+
+    /// Close the database (all threads must first be stopped).
+    ~utxo_database();
+
+    /// Initialize a new utxo database.
+    bool create();
+
+    /// Call before using the database.
+    bool start();
+
+    /// Call to signal a stop of current operations.
+    bool stop();
+
+    /// Call to unload the memory map.
+    bool close();
+
+    /// Fetch the unspent output of the given output point.
+    utxo_result get(const chain::output_point &outpoint) const;
+
+    /// Store an unspent output.
+    void store(const chain::output_point &outpoint, size_t height,
+               bool coinbase, const chain::output &output);
+
+    /// Delete an unspent output, returns false if it is not indexed.
+    bool remove(const chain::output_point &outpoint);
+
+    /// Synchronise storage with disk so things are consistent.
+    /// Should be done at the end of every block write.
+    void sync();
+
+  private:
+    typedef slab_hash_table<chain::point> slab_map;
+
+    // Hash table used for looking up unspent outputs by output point.
+    memory_map lookup_file_;
+    slab_hash_table_header lookup_header_;
+    slab_manager lookup_manager_;
+    slab_map lookup_map_;
+};
+
+} // namespace database
+} // namespace libbitcoin
+
+#endif
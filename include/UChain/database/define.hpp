@@ -46,7 +46,11 @@
 #define LOG_DATABASE "database"
 
 // Remap safety is required if the mmap file is not fully preallocated.
+// With MEMORY_MAP_RESERVE each file reserves its address space up front and
+// grows in place, so the mapping never moves and records are raw pointers.
+#ifndef MEMORY_MAP_RESERVE
 #define REMAP_SAFETY
+#endif
 
 // Allocate safety is required for support of concurrent write operations.
 #define ALLOCATE_SAFETY
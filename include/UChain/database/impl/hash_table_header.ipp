@@ -21,9 +21,14 @@
 #ifndef UC_DATABASE_HASH_TABLE_HEADER_IPP
 #define UC_DATABASE_HASH_TABLE_HEADER_IPP
 
+#include <algorithm>
 #include <cstring>
+#include <limits>
 #include <stdexcept>
+#include <utility>
+#include <vector>
 #include <UChain/coin.hpp>
+#include <UChain/database/define.hpp>
 #include <UChain/database/memory/memory.hpp>
 
 namespace libbitcoin
@@ -39,14 +44,23 @@ const ValueType hash_table_header<IndexType, ValueType>::empty =
 
 template <typename IndexType, typename ValueType>
 hash_table_header<IndexType, ValueType>::hash_table_header(memory_map &file,
-                                                           IndexType buckets)
-    : file_(file), buckets_(buckets)
+                                                           IndexType buckets, bool resizable)
+    : file_(file),
+      buckets_(buckets),
+      resizable_(resizable),
+      minimum_(buckets),
+      entries_(0),
+      level_size_(buckets),
+      migrating_(false),
+      migrated_size_(0)
 {
     BITCOIN_ASSERT_MSG(empty == (ValueType)0xffffffffffffffff,
                        "Unexpected value for empty sentinel.");
 
     static_assert(std::is_unsigned<ValueType>::value,
                   "Hash table header requires unsigned type.");
+
+    segments_.fill(0);
 }
 
 template <typename IndexType, typename ValueType>
@@ -57,6 +71,22 @@ bool hash_table_header<IndexType, ValueType>::create()
     if (buckets_ == 0)
         return false;
 
+    if (resizable_)
+    {
+        const auto minimum_file_size =
+            resizable_hash_table_header_size<IndexType, ValueType>(buckets_);
+
+        // The inline segment follows the segment list.
+        segments_[0] = minimum_file_size - buckets_ * sizeof(ValueType);
+
+        // The accessor must remain in scope until the end of the block.
+        const auto memory = file_.resize(minimum_file_size);
+        const auto address = REMAP_ADDRESS(memory);
+        memset(address + segments_[0], 0xff, buckets_ * sizeof(ValueType));
+        write_state(address);
+        return true;
+    }
+
     // Calculate the minimum file size.
     const auto minimum_file_size = item_position(buckets_);
 
@@ -81,6 +111,9 @@ bool hash_table_header<IndexType, ValueType>::create()
 template <typename IndexType, typename ValueType>
 bool hash_table_header<IndexType, ValueType>::start()
 {
+    if (resizable_)
+        return start_resizable();
+
     const auto minimum_file_size = item_position(buckets_);
 
     // Header file is too small.
@@ -106,11 +139,11 @@ ValueType hash_table_header<IndexType, ValueType>::read(IndexType index) const
 
     // The accessor must remain in scope until the end of the block.
     const auto memory = file_.access();
-    const auto value_address = REMAP_ADDRESS(memory) + item_position(index);
 
     // Critical Section
     ///////////////////////////////////////////////////////////////////////////
     shared_lock lock(mutex_);
+    const auto value_address = REMAP_ADDRESS(memory) + item_position(index);
     return from_little_endian_unsafe<ValueType>(value_address);
     ///////////////////////////////////////////////////////////////////////////
 }
@@ -124,12 +157,12 @@ void hash_table_header<IndexType, ValueType>::write(IndexType index,
 
     // The accessor must remain in scope until the end of the block.
     const auto memory = file_.access();
-    const auto value_address = REMAP_ADDRESS(memory) + item_position(index);
-    auto serial = make_serializer(value_address);
 
     // Critical Section
     ///////////////////////////////////////////////////////////////////////////
     unique_lock lock(mutex_);
+    const auto value_address = REMAP_ADDRESS(memory) + item_position(index);
+    auto serial = make_serializer(value_address);
     serial.template write_little_endian<ValueType>(value);
     ///////////////////////////////////////////////////////////////////////////
 }
@@ -140,11 +173,364 @@ IndexType hash_table_header<IndexType, ValueType>::size() const
     return buckets_;
 }
 
+// Linear hashing, buckets below the split index have been split already and
+// are addressed at the next level.
+template <typename IndexType, typename ValueType>
+IndexType hash_table_header<IndexType, ValueType>::bucket(size_t hash) const
+{
+    if (level_size_ == 0)
+        return 0;
+
+    const auto index = hash % level_size_;
+    const auto split = buckets_ - level_size_;
+    return static_cast<IndexType>(index < split ?
+        hash % (level_size_ * 2) : index);
+}
+
+template <typename IndexType, typename ValueType>
+IndexType hash_table_header<IndexType, ValueType>::entries() const
+{
+    return entries_;
+}
+
+template <typename IndexType, typename ValueType>
+void hash_table_header<IndexType, ValueType>::set_entries(IndexType value)
+{
+    if (!resizable_)
+        return;
+
+    // The accessor must remain in scope until the end of the block.
+    const auto memory = file_.access();
+
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    unique_lock lock(mutex_);
+    entries_ = value;
+    write_state(REMAP_ADDRESS(memory));
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+template <typename IndexType, typename ValueType>
+bool hash_table_header<IndexType, ValueType>::overloaded() const
+{
+    static constexpr auto maximum = std::numeric_limits<IndexType>::max() / 2;
+    return resizable_ && entries_ > buckets_ && buckets_ < maximum;
+}
+
+template <typename IndexType, typename ValueType>
+IndexType hash_table_header<IndexType, ValueType>::split_index() const
+{
+    return static_cast<IndexType>(buckets_ - level_size_);
+}
+
+template <typename IndexType, typename ValueType>
+size_t hash_table_header<IndexType, ValueType>::segment_size() const
+{
+    const auto count = segment_count();
+
+    // Segment n holds as many buckets as the n segments before it.
+    return buckets_ < capacity(count) ? 0 :
+        capacity(count) * sizeof(ValueType);
+}
+
+template <typename IndexType, typename ValueType>
+void hash_table_header<IndexType, ValueType>::add_segment(
+    file_offset position)
+{
+    const auto count = segment_count();
+    BITCOIN_ASSERT(count < hash_table_segments);
+
+    // The accessor must remain in scope until the end of the block.
+    const auto memory = file_.access();
+    const auto address = REMAP_ADDRESS(memory);
+    memset(address + position, 0xff, capacity(count) * sizeof(ValueType));
+
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    unique_lock lock(mutex_);
+    segments_[count] = position;
+    write_state(address);
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+template <typename IndexType, typename ValueType>
+IndexType hash_table_header<IndexType, ValueType>::grow()
+{
+    // The accessor must remain in scope until the end of the block.
+    const auto memory = file_.access();
+
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    unique_lock lock(mutex_);
+    BITCOIN_ASSERT(buckets_ < capacity(segment_count()));
+
+    const auto index = buckets_++;
+
+    if (buckets_ == level_size_ * 2)
+        level_size_ = buckets_;
+
+    write_state(REMAP_ADDRESS(memory));
+    return index;
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+template <typename IndexType, typename ValueType>
+std::vector<ValueType> hash_table_header<IndexType, ValueType>::legacy_chains()
+{
+    auto chains = std::move(legacy_chains_);
+    legacy_chains_.clear();
+    return chains;
+}
+
+// The rehashed header is written before its first word is cleared, so a
+// header that reads as resizable never depends on the legacy image.
+template <typename IndexType, typename ValueType>
+void hash_table_header<IndexType, ValueType>::commit_migration()
+{
+    if (!migrating_)
+        return;
+
+    {
+        // The accessor must remain in scope until the end of the block.
+        const auto memory = file_.access();
+
+        // Critical Section
+        ///////////////////////////////////////////////////////////////////////
+        unique_lock lock(mutex_);
+        migrating_ = false;
+        write_state(REMAP_ADDRESS(memory));
+        ///////////////////////////////////////////////////////////////////////
+    }
+
+    // The image and trailer are beyond the payload, truncated on close.
+    file_.resize(migrated_size_);
+}
+
+// privates
+
 template <typename IndexType, typename ValueType>
 file_offset hash_table_header<IndexType, ValueType>::item_position(
     IndexType index) const
 {
-    return sizeof(IndexType) + index * sizeof(ValueType);
+    if (!resizable_)
+        return sizeof(IndexType) + index * sizeof(ValueType);
+
+    // Segment n > 0 starts at the bucket count of the segments before it.
+    size_t segment = 0;
+    while (segment + 1 < hash_table_segments && index >= capacity(segment + 1))
+        ++segment;
+
+    const auto offset = index - (segment == 0 ? 0 : capacity(segment));
+    return segments_[segment] + offset * sizeof(ValueType);
+}
+
+template <typename IndexType, typename ValueType>
+size_t hash_table_header<IndexType, ValueType>::capacity(size_t count) const
+{
+    return count == 0 ? 0 : size_t(minimum_) << (count - 1);
+}
+
+template <typename IndexType, typename ValueType>
+size_t hash_table_header<IndexType, ValueType>::segment_count() const
+{
+    size_t count = 1;
+    while (count < hash_table_segments && segments_[count] != 0)
+        ++count;
+
+    return count;
+}
+
+template <typename IndexType, typename ValueType>
+bool hash_table_header<IndexType, ValueType>::start_resizable()
+{
+    const auto header_size =
+        resizable_hash_table_header_size<IndexType, ValueType>(buckets_);
+
+    // Header file is too small.
+    if (sizeof(IndexType) > file_.size())
+        return false;
+
+    // Does not require atomicity (no concurrency during start).
+    auto legacy_buckets = read_first();
+
+    // An interrupted migration is redone from the legacy image.
+    if (legacy_buckets == std::numeric_limits<IndexType>::max())
+    {
+        if (!restore())
+            return false;
+
+        legacy_buckets = read_first();
+    }
+
+    // A legacy header starts with its (nonzero) bucket count.
+    if (legacy_buckets != 0)
+        return migrate(legacy_buckets);
+
+    if (header_size > file_.size())
+        return false;
+
+    // The accessor must remain in scope until the end of the block.
+    const auto memory = file_.access();
+    auto deserial = make_deserializer_unsafe(REMAP_ADDRESS(memory) +
+                                             sizeof(IndexType));
+    const auto minimum = deserial.template read_little_endian<IndexType>();
+    buckets_ = deserial.template read_little_endian<IndexType>();
+    entries_ = deserial.template read_little_endian<IndexType>();
+
+    for (auto &segment : segments_)
+        segment = deserial.template read_little_endian<file_offset>();
+
+    // The payload follows the initial buckets, so they must match.
+    if (minimum != minimum_ || buckets_ < minimum_ ||
+        segments_[0] != header_size - minimum_ * sizeof(ValueType))
+        return false;
+
+    level_size_ = minimum_;
+    while (level_size_ * 2 <= buckets_)
+        level_size_ *= 2;
+
+    return true;
+}
+
+template <typename IndexType, typename ValueType>
+IndexType hash_table_header<IndexType, ValueType>::read_first() const
+{
+    // The accessor must remain in scope until the end of the block.
+    const auto memory = file_.access();
+    return from_little_endian_unsafe<IndexType>(REMAP_ADDRESS(memory));
+}
+
+// The trailer is valid only if it ends the file right after its image.
+template <typename IndexType, typename ValueType>
+bool hash_table_header<IndexType, ValueType>::read_trailer(
+    file_offset &image, size_t &image_size) const
+{
+    static constexpr size_t trailer_size = 2 * sizeof(file_offset) +
+                                           sizeof(uint64_t);
+    const auto file_size = file_.size();
+
+    if (file_size < trailer_size)
+        return false;
+
+    // The accessor must remain in scope until the end of the block.
+    const auto memory = file_.access();
+    auto deserial = make_deserializer_unsafe(REMAP_ADDRESS(memory) +
+                                             file_size - trailer_size);
+    image = deserial.template read_little_endian<file_offset>();
+    image_size = deserial.template read_little_endian<file_offset>();
+    const auto marker = deserial.template read_little_endian<uint64_t>();
+
+    return marker == hash_table_image_marker && image >= image_size &&
+           image_size > sizeof(IndexType) &&
+           image + image_size + trailer_size == file_size;
+}
+
+// The legacy bucket count is copied last, until then the file still reads
+// as migrating and the copy is redone.
+template <typename IndexType, typename ValueType>
+bool hash_table_header<IndexType, ValueType>::restore()
+{
+    file_offset image;
+    size_t image_size;
+    if (!read_trailer(image, image_size))
+        return false;
+
+    log::info(LOG_DATABASE)
+        << "Restoring hash table interrupted during migration.";
+
+    // The accessor must remain in scope until the end of the block.
+    const auto memory = file_.access();
+    const auto address = REMAP_ADDRESS(memory);
+    memcpy(address + sizeof(IndexType), address + image + sizeof(IndexType),
+           image_size - sizeof(IndexType));
+    memcpy(address, address + image, sizeof(IndexType));
+    return true;
+}
+
+// Rows and slabs are addressed relative to the end of the header, so moving
+// the payload to follow the new header keeps all links valid. The legacy
+// buckets are kept in memory until the table rehashes them, and the legacy
+// file is copied past the payload until the table commits the rehash.
+template <typename IndexType, typename ValueType>
+bool hash_table_header<IndexType, ValueType>::migrate(IndexType legacy_buckets)
+{
+    static constexpr size_t trailer_size = 2 * sizeof(file_offset) +
+                                           sizeof(uint64_t);
+    const auto header_size =
+        resizable_hash_table_header_size<IndexType, ValueType>(buckets_);
+    const size_t legacy_size = sizeof(IndexType) +
+                               legacy_buckets * sizeof(ValueType);
+
+    // A previous attempt left its image, whose size excludes the copy.
+    file_offset image;
+    size_t image_size;
+    if (!read_trailer(image, image_size))
+        image_size = file_.size();
+
+    // Header file is too small.
+    if (legacy_size > image_size)
+        return false;
+
+    log::info(LOG_DATABASE)
+        << "Migrating hash table of " << legacy_buckets << " buckets to "
+        << buckets_ << " resizable buckets.";
+
+    const auto payload_size = image_size - legacy_size;
+    migrated_size_ = header_size + payload_size;
+    image = std::max(image_size, migrated_size_);
+
+    {
+        // The trailer is written before the copy, so a partial copy is
+        // redone from the legacy file, which is still intact.
+        // The accessor must remain in scope until the end of the block.
+        const auto memory = file_.resize(image + image_size + trailer_size);
+        const auto address = REMAP_ADDRESS(memory);
+        auto serial = make_serializer(address + image + image_size);
+        serial.template write_little_endian<file_offset>(image);
+        serial.template write_little_endian<file_offset>(image_size);
+        serial.template write_little_endian<uint64_t>(hash_table_image_marker);
+        memcpy(address + image, address, image_size);
+    }
+
+    // The accessor must remain in scope until the end of the block.
+    const auto memory = file_.access();
+    const auto address = REMAP_ADDRESS(memory);
+    const auto buckets_address = address + sizeof(IndexType);
+
+    for (IndexType index = 0; index < legacy_buckets; ++index)
+    {
+        const auto value = from_little_endian_unsafe<ValueType>(
+            buckets_address + index * sizeof(ValueType));
+
+        if (value != empty)
+            legacy_chains_.push_back(value);
+    }
+
+    // From here the file reads as migrating and is restored from the image.
+    migrating_ = true;
+    auto serial = make_serializer(address);
+    serial.template write_little_endian<IndexType>(
+        std::numeric_limits<IndexType>::max());
+
+    segments_[0] = header_size - buckets_ * sizeof(ValueType);
+    memmove(address + header_size, address + legacy_size, payload_size);
+    memset(address + segments_[0], 0xff, buckets_ * sizeof(ValueType));
+    write_state(address);
+    return true;
+}
+
+template <typename IndexType, typename ValueType>
+void hash_table_header<IndexType, ValueType>::write_state(uint8_t *address)
+{
+    auto serial = make_serializer(address);
+    serial.template write_little_endian<IndexType>(
+        migrating_ ? std::numeric_limits<IndexType>::max() : 0);
+    serial.template write_little_endian<IndexType>(minimum_);
+    serial.template write_little_endian<IndexType>(buckets_);
+    serial.template write_little_endian<IndexType>(entries_);
+
+    for (const auto segment : segments_)
+        serial.template write_little_endian<file_offset>(segment);
 }
 
 } // namespace database
@@ -22,6 +22,7 @@
 #define UC_DATABASE_RECORD_HASH_TABLE_IPP
 
 #include <string>
+#include <vector>
 #include <UChain/coin.hpp>
 #include <UChain/database/memory/memory.hpp>
 #include "record_row.ipp"
@@ -39,6 +40,35 @@ record_hash_table<KeyType>::record_hash_table(
 {
 }
 
+// A legacy header leaves its chains to be rehashed here. They are relinked
+// into the initial buckets, which allocates nothing over the legacy image
+// kept by the header, and the table splits to its load once committed.
+template <typename KeyType>
+bool record_hash_table<KeyType>::start()
+{
+    const auto chains = header_.legacy_chains();
+
+    std::vector<array_index> records;
+    for (const auto begin : chains)
+    {
+        const auto links = chain(begin);
+        records.insert(records.end(), links.begin(), links.end());
+    }
+
+    if (!records.empty())
+    {
+        header_.set_entries(static_cast<array_index>(records.size()));
+        relink(records);
+    }
+
+    header_.commit_migration();
+
+    while (header_.overloaded())
+        split();
+
+    return true;
+}
+
 // This is not limited to storing unique key values. If duplicate keyed values
 // are store then retrieval and unlinking will fail as these multiples cannot
 // be differentiated.
@@ -55,6 +85,17 @@ void record_hash_table<KeyType>::store(const KeyType &key,
 
     // Link record to header.
     link(key, new_begin);
+    header_.set_entries(header_.entries() + 1);
+
+    if (header_.overloaded())
+    {
+        // Critical Section
+        ///////////////////////////////////////////////////////////////////////
+        unique_lock lock(split_mutex_);
+        split();
+        ///////////////////////////////////////////////////////////////////////
+    }
+
     mutex_.unlock();
 }
 
@@ -62,6 +103,8 @@ void record_hash_table<KeyType>::store(const KeyType &key,
 template <typename KeyType>
 const memory_ptr record_hash_table<KeyType>::find(const KeyType &key) const
 {
+    shared_lock lock(split_mutex_);
+
     // Find start item...
     auto current = read_bucket_value(key);
 
@@ -92,6 +135,8 @@ template <typename KeyType>
 std::shared_ptr<std::vector<memory_ptr>> record_hash_table<KeyType>::find(array_index index) const
 {
     auto vec_memo = std::make_shared<std::vector<memory_ptr>>();
+    shared_lock lock(split_mutex_);
+
     // find first item
     auto current = header_.read(index);
     static_assert(sizeof(current) == sizeof(array_index), "Invalid size");
@@ -121,6 +166,10 @@ std::shared_ptr<std::vector<memory_ptr>> record_hash_table<KeyType>::find(array_
 template <typename KeyType>
 bool record_hash_table<KeyType>::unlink(const KeyType &key)
 {
+    // Writers share the bucket links and the entry count, as in store.
+    unique_lock write_lock(mutex_);
+    shared_lock lock(split_mutex_);
+
     // Find start item...
     const auto begin = read_bucket_value(key);
     const record_row<KeyType> begin_item(manager_, begin);
@@ -129,6 +178,7 @@ bool record_hash_table<KeyType>::unlink(const KeyType &key)
     if (begin_item.compare(key))
     {
         link(key, begin_item.next_index());
+        header_.set_entries(header_.entries() - 1);
         return true;
     }
 
@@ -145,6 +195,7 @@ bool record_hash_table<KeyType>::unlink(const KeyType &key)
         if (item.compare(key))
         {
             release(item, previous);
+            header_.set_entries(header_.entries() - 1);
             return true;
         }
 
@@ -165,7 +216,7 @@ template <typename KeyType>
 array_index record_hash_table<KeyType>::bucket_index(
     const KeyType &key) const
 {
-    const auto bucket = remainder(key, header_.size());
+    const auto bucket = header_.bucket(std::hash<KeyType>()(key));
     BITCOIN_ASSERT(bucket < header_.size());
     return bucket;
 }
@@ -195,6 +246,59 @@ void record_hash_table<KeyType>::release(const ListItem &item,
     previous_item.write_next_index(item.next_index());
 }
 
+template <typename KeyType>
+std::vector<array_index> record_hash_table<KeyType>::chain(
+    array_index begin) const
+{
+    std::vector<array_index> records;
+
+    for (auto current = begin; current != header_.empty;)
+    {
+        records.push_back(current);
+        const record_row<KeyType> item(manager_, current);
+
+        const auto previous = current;
+        current = item.next_index();
+
+        // This may otherwise produce an infinite loop here.
+        if (previous == current)
+            break;
+    }
+
+    return records;
+}
+
+// Pushing in reverse keeps records of the same key in their original order.
+template <typename KeyType>
+void record_hash_table<KeyType>::relink(const std::vector<array_index> &chain)
+{
+    for (auto record = chain.rbegin(); record != chain.rend(); ++record)
+    {
+        record_row<KeyType> item(manager_, *record);
+        const auto bucket = bucket_index(item.key());
+        item.write_next_index(header_.read(bucket));
+        header_.write(bucket, *record);
+    }
+}
+
+template <typename KeyType>
+void record_hash_table<KeyType>::split()
+{
+    // Synchronize the count at once so the segment is never reallocated.
+    const auto segment_size = header_.segment_size();
+    if (segment_size != 0)
+    {
+        header_.add_segment(manager_.new_segment(segment_size));
+        manager_.sync();
+    }
+
+    const auto index = header_.split_index();
+    const auto records = chain(header_.read(index));
+    header_.write(index, header_.empty);
+    header_.grow();
+    relink(records);
+}
+
 } // namespace database
 } // namespace libbitcoin
 
@@ -126,13 +126,17 @@ void record_multimap<KeyType>::delete_last_row(const KeyType &key)
 
     auto address = REMAP_ADDRESS(start_info);
 
-    // Critical Section
-    ///////////////////////////////////////////////////////////////////////////
-    mutex_.lock_shared();
-    const auto old_begin = from_little_endian_unsafe<array_index>(address);
-    mutex_.unlock_shared();
-    ///////////////////////////////////////////////////////////////////////////
+    array_index old_begin;
+    {
+        // Critical Section
+        ///////////////////////////////////////////////////////////////////////
+        shared_lock lock(mutex_);
+        old_begin = from_little_endian_unsafe<array_index>(address);
+        ///////////////////////////////////////////////////////////////////////
+    }
 
+    // The dropped row is not reused and keeps its next value, so a reader
+    // holding it still walks the rest of the list.
     BITCOIN_ASSERT(old_begin != records_.empty);
     const auto new_begin = records_.next(old_begin);
 
@@ -22,6 +22,7 @@
 #define UC_DATABASE_RECORD_ROW_IPP
 
 #include <UChain/database/memory/memory.hpp>
+#include "remainder.ipp"
 
 namespace libbitcoin
 {
@@ -50,6 +51,9 @@ class record_row
     /// Does this match?
     bool compare(const KeyType &key) const;
 
+    /// The key of this row.
+    KeyType key() const;
+
     /// The actual user data.
     const memory_ptr data() const;
 
@@ -109,6 +113,14 @@ bool record_row<KeyType>::compare(const KeyType &key) const
     return std::equal(key.begin(), key.end(), REMAP_ADDRESS(memory));
 }
 
+template <typename KeyType>
+KeyType record_row<KeyType>::key() const
+{
+    // Key data is at the start.
+    const auto memory = raw_data(0);
+    return read_key<KeyType>(REMAP_ADDRESS(memory));
+}
+
 template <typename KeyType>
 const memory_ptr record_row<KeyType>::data() const
 {
@@ -21,8 +21,10 @@
 #ifndef UC_DATABASE_REMAINDER_IPP
 #define UC_DATABASE_REMAINDER_IPP
 
+#include <algorithm>
 #include <cstdint>
 #include <functional>
+#include <tuple>
 #include <UChain/coin.hpp>
 
 namespace libbitcoin
@@ -37,6 +39,22 @@ Divisor remainder(const KeyType &key, const Divisor divisor)
     return divisor == 0 ? 0 : std::hash<KeyType>()(key) % divisor;
 }
 
+/// Read back a key as it was written to the start of a row.
+template <typename KeyType>
+KeyType read_key(const uint8_t *data)
+{
+    KeyType key;
+    std::copy(data, data + std::tuple_size<KeyType>::value, key.begin());
+    return key;
+}
+
+template <>
+inline chain::point read_key<chain::point>(const uint8_t *data)
+{
+    const auto size = std::tuple_size<chain::point>::value;
+    return chain::point::factory_from_data(data_chunk(data, data + size));
+}
+
 } // namespace database
 } // namespace libbitcoin
 
@@ -21,6 +21,7 @@
 #ifndef UC_DATABASE_SLAB_HASH_TABLE_IPP
 #define UC_DATABASE_SLAB_HASH_TABLE_IPP
 
+#include <vector>
 #include <UChain/coin.hpp>
 #include <UChain/database/memory/memory.hpp>
 #include "remainder.ipp"
@@ -38,6 +39,35 @@ slab_hash_table<KeyType>::slab_hash_table(slab_hash_table_header &header,
 {
 }
 
+// A legacy header leaves its chains to be rehashed here. They are relinked
+// into the initial buckets, which allocates nothing over the legacy image
+// kept by the header, and the table splits to its load once committed.
+template <typename KeyType>
+bool slab_hash_table<KeyType>::start()
+{
+    const auto chains = header_.legacy_chains();
+
+    std::vector<file_offset> slabs;
+    for (const auto begin : chains)
+    {
+        const auto links = chain(begin);
+        slabs.insert(slabs.end(), links.begin(), links.end());
+    }
+
+    if (!slabs.empty())
+    {
+        header_.set_entries(static_cast<array_index>(slabs.size()));
+        relink(slabs);
+    }
+
+    header_.commit_migration();
+
+    while (header_.overloaded())
+        split();
+
+    return true;
+}
+
 // This is not limited to storing unique key values. If duplicate keyed values
 // are store then retrieval and unlinking will fail as these multiples cannot
 // be differentiated. Therefore the database is not currently able to support
@@ -55,6 +85,16 @@ file_offset slab_hash_table<KeyType>::store(const KeyType &key,
 
     // Link record to header.
     link(key, new_begin);
+    header_.set_entries(header_.entries() + 1);
+
+    if (header_.overloaded())
+    {
+        // Critical Section
+        ///////////////////////////////////////////////////////////////////////
+        unique_lock lock(split_mutex_);
+        split();
+        ///////////////////////////////////////////////////////////////////////
+    }
 
     mutex_.unlock();
 
@@ -71,6 +111,8 @@ file_offset slab_hash_table<KeyType>::restore(const KeyType &key,
                                               write_function write, const size_t value_size)
 {
     mutex_.lock();
+    shared_lock lock(split_mutex_);
+
     // Store current bucket value.
     const auto old_begin = read_bucket_value(key);
     slab_row<KeyType> item(manager_, old_begin);
@@ -90,6 +132,8 @@ file_offset slab_hash_table<KeyType>::restore(const KeyType &key,
 template <typename KeyType>
 const memory_ptr slab_hash_table<KeyType>::find(const KeyType &key) const
 {
+    shared_lock lock(split_mutex_);
+
     // Find start item...
     auto current = read_bucket_value(key);
 
@@ -123,6 +167,8 @@ template <typename KeyType>
 const memory_ptr slab_hash_table<KeyType>::rfind(const KeyType &key) const
 {
     memory_ptr ret;
+    shared_lock lock(split_mutex_);
+
     // Find start item...
     auto current = read_bucket_value(key);
 
@@ -156,6 +202,8 @@ template <typename KeyType>
 std::vector<memory_ptr> slab_hash_table<KeyType>::finds(const KeyType &key) const
 {
     std::vector<memory_ptr> ret;
+    shared_lock lock(split_mutex_);
+
     // Find start item...
     auto current = read_bucket_value(key);
 
@@ -189,6 +237,8 @@ template <typename KeyType>
 std::shared_ptr<std::vector<memory_ptr>> slab_hash_table<KeyType>::find(uint64_t index) const
 {
     auto vec_memo = std::make_shared<std::vector<memory_ptr>>();
+    shared_lock lock(split_mutex_);
+
     // find first item
     auto current = header_.read(index);
     static_assert(sizeof(current) == sizeof(file_offset), "Invalid size");
@@ -217,10 +267,75 @@ std::shared_ptr<std::vector<memory_ptr>> slab_hash_table<KeyType>::find(uint64_t
     return vec_memo;
 }
 
+// This is limited to returning the positions of the items in the special index.
+template <typename KeyType>
+std::shared_ptr<std::vector<file_offset>> slab_hash_table<KeyType>::find_positions(uint64_t index) const
+{
+    auto vec_position = std::make_shared<std::vector<file_offset>>();
+    shared_lock lock(split_mutex_);
+
+    // find first item
+    auto current = header_.read(index);
+    static_assert(sizeof(current) == sizeof(file_offset), "Invalid size");
+
+    // Iterate through list...
+    while (current != header_.empty)
+    {
+        const slab_row<KeyType> item(manager_, current);
+
+        if (item.out_of_memory())
+            break;
+
+        // Found.
+        vec_position->push_back(current + item.value_begin);
+
+        const auto previous = current;
+        current = item.next_position();
+
+        // This may otherwise produce an infinite loop here.
+        // It indicates that a write operation has interceded.
+        // So we must return gracefully vs. looping forever.
+        if (previous == current)
+            break;
+    }
+
+    return vec_position;
+}
+
+template <typename KeyType>
+std::shared_ptr<std::vector<memory_ptr>> slab_hash_table<KeyType>::find_all() const
+{
+    auto vec_memo = std::make_shared<std::vector<memory_ptr>>();
+    shared_lock lock(split_mutex_);
+
+    for (array_index index = 0; index < header_.size(); ++index)
+        for (const auto slab : chain(header_.read(index)))
+            vec_memo->push_back(slab_row<KeyType>(manager_, slab).data());
+
+    return vec_memo;
+}
+
+template <typename KeyType>
+std::shared_ptr<std::vector<file_offset>> slab_hash_table<KeyType>::find_all_positions() const
+{
+    auto vec_position = std::make_shared<std::vector<file_offset>>();
+    shared_lock lock(split_mutex_);
+
+    for (array_index index = 0; index < header_.size(); ++index)
+        for (const auto slab : chain(header_.read(index)))
+            vec_position->push_back(slab + slab_row<KeyType>::value_begin);
+
+    return vec_position;
+}
+
 // This is limited to unlinking the first of multiple matching key values.
 template <typename KeyType>
 bool slab_hash_table<KeyType>::unlink(const KeyType &key)
 {
+    // Writers share the bucket links and the entry count, as in store.
+    unique_lock write_lock(mutex_);
+    shared_lock lock(split_mutex_);
+
     // Find start item...
     const auto begin = read_bucket_value(key);
     const slab_row<KeyType> begin_item(manager_, begin);
@@ -232,6 +347,7 @@ bool slab_hash_table<KeyType>::unlink(const KeyType &key)
     if (begin_item.compare(key))
     {
         link(key, begin_item.next_position());
+        header_.set_entries(header_.entries() - 1);
         return true;
     }
 
@@ -251,6 +367,7 @@ bool slab_hash_table<KeyType>::unlink(const KeyType &key)
         if (item.compare(key))
         {
             release(item, previous);
+            header_.set_entries(header_.entries() - 1);
             return true;
         }
 
@@ -270,7 +387,7 @@ bool slab_hash_table<KeyType>::unlink(const KeyType &key)
 template <typename KeyType>
 array_index slab_hash_table<KeyType>::bucket_index(const KeyType &key) const
 {
-    const auto bucket = remainder(key, header_.size());
+    const auto bucket = header_.bucket(std::hash<KeyType>()(key));
     BITCOIN_ASSERT(bucket < header_.size());
     return bucket;
 }
@@ -300,6 +417,63 @@ void slab_hash_table<KeyType>::release(const ListItem &item,
     previous_item.write_next_position(item.next_position());
 }
 
+template <typename KeyType>
+std::vector<file_offset> slab_hash_table<KeyType>::chain(
+    file_offset begin) const
+{
+    std::vector<file_offset> slabs;
+
+    for (auto current = begin; current != header_.empty;)
+    {
+        const slab_row<KeyType> item(manager_, current);
+
+        if (item.out_of_memory())
+            break;
+
+        slabs.push_back(current);
+
+        const auto previous = current;
+        current = item.next_position();
+
+        // This may otherwise produce an infinite loop here.
+        if (previous == current)
+            break;
+    }
+
+    return slabs;
+}
+
+// Pushing in reverse keeps slabs of the same key in their original order.
+template <typename KeyType>
+void slab_hash_table<KeyType>::relink(const std::vector<file_offset> &chain)
+{
+    for (auto slab = chain.rbegin(); slab != chain.rend(); ++slab)
+    {
+        slab_row<KeyType> item(manager_, *slab);
+        const auto bucket = bucket_index(item.key());
+        item.write_next_position(header_.read(bucket));
+        header_.write(bucket, *slab);
+    }
+}
+
+template <typename KeyType>
+void slab_hash_table<KeyType>::split()
+{
+    // Synchronize the size at once so the segment is never reallocated.
+    const auto segment_size = header_.segment_size();
+    if (segment_size != 0)
+    {
+        header_.add_segment(manager_.new_segment(segment_size));
+        manager_.sync();
+    }
+
+    const auto index = header_.split_index();
+    const auto slabs = chain(header_.read(index));
+    header_.write(index, header_.empty);
+    header_.grow();
+    relink(slabs);
+}
+
 } // namespace database
 } // namespace libbitcoin
 
@@ -22,6 +22,7 @@
 #define UC_DATABASE_SLAB_LIST_IPP
 
 #include <UChain/database/memory/memory.hpp>
+#include "remainder.ipp"
 
 namespace libbitcoin
 {
@@ -51,6 +52,9 @@ class slab_row
     /// Does this match?
     bool compare(const KeyType &key) const;
 
+    /// The key of this row.
+    KeyType key() const;
+
     /// The actual user data.
     const memory_ptr data() const;
 
@@ -84,7 +88,7 @@ template <typename KeyType>
 file_offset slab_row<KeyType>::create(const KeyType &key,
                                       const size_t value_size, const file_offset next)
 {
-    const file_offset info_size = key.size() + position_size;
+    const file_offset info_size = key_size + position_size;
 
     // Create new slab.
     //   [ KeyType  ]
@@ -116,6 +120,14 @@ bool slab_row<KeyType>::compare(const KeyType &key) const
     return std::equal(key.begin(), key.end(), REMAP_ADDRESS(memory));
 }
 
+template <typename KeyType>
+KeyType slab_row<KeyType>::key() const
+{
+    // Key data is at the start.
+    const auto memory = raw_data(0);
+    return read_key<KeyType>(REMAP_ADDRESS(memory));
+}
+
 template <typename KeyType>
 const memory_ptr slab_row<KeyType>::data() const
 {
@@ -88,6 +88,7 @@ class BCD_API memory_map
     bool truncate(size_t size);
     bool truncate_mapped(size_t size);
     bool validate(size_t size);
+    bool unmap_all();
 
     void log_mapping();
     void log_resizing(size_t size);
@@ -101,6 +102,7 @@ class BCD_API memory_map
     const boost::filesystem::path filename_;
 
     // Protected by internal mutex.
+    // With MEMORY_MAP_RESERVE data_ is fixed from start until close.
     uint8_t *data_;
     size_t file_size_;
     size_t logical_size_;
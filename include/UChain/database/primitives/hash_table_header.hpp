@@ -21,7 +21,10 @@
 #ifndef UC_DATABASE_HASH_TABLE_HEADER_HPP
 #define UC_DATABASE_HASH_TABLE_HEADER_HPP
 
+#include <array>
+#include <vector>
 #include <UChain/coin.hpp>
+#include <UChain/database/define.hpp>
 #include <UChain/database/memory/memory_map.hpp>
 
 namespace libbitcoin
@@ -29,6 +32,20 @@ namespace libbitcoin
 namespace database
 {
 
+/// Segments double in size, so this many cover any 32 bit bucket count.
+BC_CONSTEXPR size_t hash_table_segments = 32;
+
+/// Ends a file that keeps its legacy image while it is migrated.
+BC_CONSTEXPR uint64_t hash_table_image_marker = 0x6567616d69796361;
+
+/// The size of a resizable header with its initial (inline) buckets.
+template <typename IndexType, typename ValueType>
+BC_CONSTFUNC size_t resizable_hash_table_header_size(size_t buckets)
+{
+    return 4 * sizeof(IndexType) + hash_table_segments * sizeof(file_offset) +
+           buckets * sizeof(ValueType);
+}
+
 /**
  * Implements contigious memory array with a fixed size elements.
  *
@@ -40,6 +57,29 @@ namespace database
  *  [ [      ...       ] ]
  *
  * Empty elements are represented by the value hash_table_header.empty
+ *
+ * A resizable header grows one bucket at a time by linear hashing, the
+ * table splits the chain of split_index() across it and the new bucket.
+ * Buckets beyond the initial ones live in segments allocated from the
+ * table payload, each doubling the bucket count:
+ *
+ *  [     zero:IndexType     ]  (legacy headers start with the size)
+ *  [   minimum:IndexType    ]  (initial buckets, inline)
+ *  [   buckets:IndexType    ]
+ *  [   entries:IndexType    ]
+ *  [ [ segment:file_offset ] ] x hash_table_segments
+ *  [ [    item:ValueType   ] ] x minimum
+ *
+ * Starting a resizable header on a legacy file moves the payload down to
+ * the new header and leaves the legacy chains to be rehashed by the table.
+ * Until the table commits the rehash the first word is all ones and a copy
+ * of the legacy file follows the payload, ended by a trailer:
+ *
+ *  [  image:file_offset ]  (position of the copy)
+ *  [   size:file_offset ]  (size of the copy)
+ *  [ marker:uint64_t    ]
+ *
+ * Starting on an interrupted migration restores the copy and migrates again.
  */
 template <typename IndexType, typename ValueType>
 class hash_table_header
@@ -47,7 +87,8 @@ class hash_table_header
   public:
     static const ValueType empty;
 
-    hash_table_header(memory_map &file, IndexType buckets);
+    hash_table_header(memory_map &file, IndexType buckets,
+                      bool resizable = false);
 
     // Copy.
     hash_table_header(const hash_table_header &) = delete;
@@ -72,12 +113,66 @@ class hash_table_header
     /// The hash table size (bucket count).
     IndexType size() const;
 
+    /// The bucket of a key hash for the current size.
+    IndexType bucket(size_t hash) const;
+
+    // Resizing.
+    // ------------------------------------------------------------------------
+
+    /// The number of keys stored, maintained by the table.
+    IndexType entries() const;
+    void set_entries(IndexType value);
+
+    /// The load exceeds one key per bucket and the table should split.
+    bool overloaded() const;
+
+    /// The bucket to be split across the next new bucket.
+    IndexType split_index() const;
+
+    /// Bytes of the segment to add before the next split, zero if none.
+    size_t segment_size() const;
+
+    /// Add the next segment at the file position, populated with empty.
+    void add_segment(file_offset position);
+
+    /// Add a bucket and return its index, requires segment space.
+    IndexType grow();
+
+    /// The chains of a migrated legacy header, emptied by the call.
+    std::vector<ValueType> legacy_chains();
+
+    /// Called once the legacy chains are rehashed, drops the legacy image.
+    void commit_migration();
+
   private:
+    typedef std::array<file_offset, hash_table_segments> segment_list;
+
     // Locate the item in the memory map.
     file_offset item_position(IndexType index) const;
 
+    // The number of buckets covered by the first count segments.
+    size_t capacity(size_t count) const;
+    size_t segment_count() const;
+
+    bool start_resizable();
+    IndexType read_first() const;
+    bool read_trailer(file_offset &image, size_t &image_size) const;
+    bool restore();
+    bool migrate(IndexType legacy_buckets);
+    void write_state(uint8_t *address);
+
     memory_map &file_;
     IndexType buckets_;
+    const bool resizable_;
+
+    // Resizable state, buckets_ is the current size.
+    IndexType minimum_;
+    IndexType entries_;
+    size_t level_size_;
+    segment_list segments_;
+    std::vector<ValueType> legacy_chains_;
+    bool migrating_;
+    size_t migrated_size_;
     mutable shared_mutex mutex_;
 };
 
@@ -0,0 +1,75 @@
+/**
+ * Copyright (c) 2018-2020 UChain core developers (check UC-AUTHORS)
+ *
+ * This file is part of UChain.
+ *
+ * UChain is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef UC_DATABASE_HISTORY_CURSOR_HPP
+#define UC_DATABASE_HISTORY_CURSOR_HPP
+
+#include <cstdint>
+#include <string>
+#include <UChain/coin.hpp>
+#include <UChain/database/define.hpp>
+
+namespace libbitcoin
+{
+namespace database
+{
+
+/// A keyset position in a newest-first history, so that the next page
+/// resumes after the last row returned instead of recounting every earlier
+/// page. Rows order by height descending, then by tx hash descending.
+class BCD_API history_cursor
+{
+  public:
+    /// The cursor before the newest row.
+    history_cursor();
+
+    /// A row is a position in the list of one key only.
+    history_cursor(uint32_t height, const hash_digest &hash, array_index row,
+                   const short_hash &key);
+
+    /// True if no row has been passed yet.
+    bool is_head() const;
+
+    /// True if a row of height and tx hash sorts after the cursor.
+    bool follows(uint32_t height, const hash_digest &hash) const;
+
+    /// The height and tx hash of the last row passed.
+    uint32_t height() const;
+    const hash_digest &hash() const;
+
+    /// The list row to resume walking the list of key at, or
+    /// record_list::empty if the cursor was left in the list of another key.
+    /// A row comes from a client, so check it is in use before reading it.
+    array_index row(const short_hash &key) const;
+
+    /// Opaque text form handed to clients.
+    std::string encoded() const;
+    bool from_string(const std::string &text);
+
+  private:
+    uint32_t height_;
+    hash_digest hash_;
+    array_index row_;
+    short_hash key_;
+};
+
+} // namespace database
+} // namespace libbitcoin
+
+#endif
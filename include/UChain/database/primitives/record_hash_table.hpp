@@ -24,6 +24,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <tuple>
+#include <vector>
 #include <UChain/database/memory/memory.hpp>
 #include <UChain/database/primitives/hash_table_header.hpp>
 #include <UChain/database/primitives/record_manager.hpp>
@@ -41,6 +42,11 @@ BC_CONSTFUNC size_t hash_table_record_size(size_t value_size)
 
 typedef hash_table_header<array_index, array_index> record_hash_table_header;
 
+BC_CONSTFUNC size_t resizable_record_hash_table_header_size(size_t buckets)
+{
+  return resizable_hash_table_header_size<array_index, array_index>(buckets);
+}
+
 /**
  * A hashtable mapping hashes to fixed sized values (records).
  * Uses a combination of the hash_table and record_manager.
@@ -59,6 +65,9 @@ typedef hash_table_header<array_index, array_index> record_hash_table_header;
  * By using the record_manager instead of slabs, we can have smaller
  * indexes avoiding reading/writing extra bytes to the file.
  * Using fixed size records is therefore faster.
+ *
+ * With a resizable header the table splits a bucket whenever there are
+ * more keys than buckets, so chains stay short as the table grows.
  */
 template <typename KeyType>
 class record_hash_table
@@ -68,6 +77,10 @@ public:
 
   record_hash_table(record_hash_table_header &header, record_manager &manager);
 
+  /// Rehash the chains of a migrated legacy header, call after starting
+  /// the header and the manager.
+  bool start();
+
   /// Store a value. The provided write() function must write the correct
   /// number of bytes (record_size - key_size - sizeof(array_index)).
   void store(const KeyType &key, write_function write);
@@ -93,9 +106,21 @@ private:
   template <typename ListItem>
   void release(const ListItem &item, const file_offset previous);
 
+  // The record indexes of a chain, in order.
+  std::vector<array_index> chain(array_index begin) const;
+
+  // Push the records onto the front of their buckets, preserving order.
+  void relink(const std::vector<array_index> &chain);
+
+  // Add a bucket and split the chain at the split index across it.
+  void split();
+
   record_hash_table_header &header_;
   record_manager &manager_;
   shared_mutex mutex_;
+
+  // Readers share, a split reorders chains.
+  mutable shared_mutex split_mutex_;
 };
 
 } // namespace database
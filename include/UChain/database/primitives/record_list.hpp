@@ -37,11 +37,19 @@ BC_CONSTEXPR size_t record_list_offset = sizeof(array_index);
 /// This is a one-way linked list with a next value containing the index of the
 /// subsequent record. Records can be dropped by forgetting an index, and
 /// updating to the next value. We can think of this as a LIFO queue.
+///
+/// Records are allocated in blocks that a list fills in order, each block
+/// twice the length of the last (up to a limit). A list of many records is
+/// therefore mostly contiguous and a walk touches few pages. A dropped record
+/// is never reused, so its next value stays valid for readers.
 class BCD_API record_list
 {
 public:
   static const array_index empty;
 
+  /// The next value of a record in a block that is not yet in use.
+  static const array_index unused;
+
   record_list(record_manager &manager);
 
   /// Create new list with a single record.
@@ -50,6 +58,9 @@ public:
   /// Insert new record before index. Returns index of new record.
   array_index insert(array_index index);
 
+  /// True if index is an allocated record that a list holds.
+  bool in_use(array_index index) const;
+
   /// Read next index for record in list.
   array_index next(array_index index) const;
 
@@ -57,6 +68,13 @@ public:
   const memory_ptr get(array_index index) const;
 
 private:
+  // The next value, which is unused for a free record of a block.
+  array_index read_next(array_index index) const;
+  void write_next(array_index index, array_index next);
+
+  // The records to allocate after the block ending at index.
+  size_t block_size(array_index index) const;
+
   record_manager &manager_;
 };
 
@@ -68,6 +68,9 @@ class BCD_API record_manager
     /// Allocate records and return first logical index, sync() after writing.
     array_index new_records(size_t count);
 
+    /// Allocate records covering size bytes and return their file position.
+    file_offset new_segment(size_t size);
+
     /// Return memory object for the record at the specified index.
     const memory_ptr get(array_index record) const;
 
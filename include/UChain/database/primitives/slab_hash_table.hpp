@@ -23,6 +23,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <vector>
 #include <UChain/database/memory/memory.hpp>
 #include <UChain/database/primitives/hash_table_header.hpp>
 #include <UChain/database/primitives/slab_manager.hpp>
@@ -34,6 +35,11 @@ namespace database
 
 typedef hash_table_header<array_index, file_offset> slab_hash_table_header;
 
+BC_CONSTFUNC size_t resizable_slab_hash_table_header_size(size_t buckets)
+{
+    return resizable_hash_table_header_size<array_index, file_offset>(buckets);
+}
+
 /**
  * A hashtable mapping hashes to variable sized values (slabs).
  * Uses a combination of the hash_table and slab_manager.
@@ -62,6 +68,10 @@ class slab_hash_table
 
     slab_hash_table(slab_hash_table_header &header, slab_manager &manager);
 
+    /// Rehash the chains of a migrated legacy header, call after starting
+    /// the header and the manager.
+    bool start();
+
     /// Store a value. value_size is the requested size for the value.
     /// The provided write() function must write exactly value_size bytes.
     /// Returns the position of the inserted value in the slab_manager.
@@ -72,6 +82,13 @@ class slab_hash_table
     /// Find the slab for a given hash. Returns a null pointer if not found.
     const memory_ptr find(const KeyType &key) const;
     std::shared_ptr<std::vector<memory_ptr>> find(uint64_t index) const;
+    /// The value positions of all the items in the bucket of the index.
+    std::shared_ptr<std::vector<file_offset>> find_positions(uint64_t index) const;
+    /// All the items of all buckets, read under one split lock so that a
+    /// concurrent split can neither hide nor repeat an item.
+    std::shared_ptr<std::vector<memory_ptr>> find_all() const;
+    /// The value positions of all the items of all buckets.
+    std::shared_ptr<std::vector<file_offset>> find_all_positions() const;
     const memory_ptr rfind(const KeyType &key) const;
     std::vector<memory_ptr> finds(const KeyType &key) const;
 
@@ -92,9 +109,21 @@ class slab_hash_table
     template <typename ListItem>
     void release(const ListItem &item, const file_offset previous);
 
+    // The slab positions of a chain, in order.
+    std::vector<file_offset> chain(file_offset begin) const;
+
+    // Push the slabs onto the front of their buckets, preserving order.
+    void relink(const std::vector<file_offset> &chain);
+
+    // Add a bucket and split the chain at the split index across it.
+    void split();
+
     slab_hash_table_header &header_;
     slab_manager &manager_;
     shared_mutex mutex_;
+
+    // Readers share, a split reorders chains.
+    mutable shared_mutex split_mutex_;
 };
 
 } // namespace database
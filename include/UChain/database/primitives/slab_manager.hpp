@@ -58,6 +58,9 @@ class BCD_API slab_manager
     /// Allocate a slab and return its position, sync() after writing.
     file_offset new_slab(size_t size);
 
+    /// Allocate a slab of size bytes and return its file position.
+    file_offset new_segment(size_t size);
+
     /// Return memory object for the slab at the specified position.
     const memory_ptr get(file_offset position) const;
 
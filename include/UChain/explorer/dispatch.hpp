@@ -22,6 +22,7 @@
 #define BX_DISPATCH_HPP
 
 #include <iostream>
+#include <memory>
 #include <UChain/coin.hpp>
 #include <UChain/explorer/define.hpp>
 #include <UChainApp/ucd/server_node.hpp>
@@ -33,6 +34,8 @@ namespace libbitcoin
 namespace explorer
 {
 
+class command;
+
 /**
  * Dispatch the command with the raw arguments as provided on the command line.
  * @param[in]  argc    The number of elements in the argv array.
@@ -71,6 +74,28 @@ BCX_API console_result dispatch_command(int argc, const char *argv[],
                                         Json::Value &jv_output,
                                         bc::server::server_node &node, uint8_t api_version = 1);
 
+/**
+ * Find and parse the command identified by the specified arguments, without
+ * invoking it. Throws if the command is unknown, not permitted or invalid.
+ * @param[in]  argc      The number of elements in the argv parameter.
+ * @param[in]  argv      Array of command line arguments excluding the process.
+ * @param[out] jv_output Receives the help text when help is requested.
+ * @param[in]  node      server_node instance.
+ * @return               The parsed command, or nullptr if help was written.
+ */
+BCX_API std::shared_ptr<command> parse_command(int argc, const char *argv[],
+                                               Json::Value &jv_output, bc::server::server_node &node);
+
+/**
+ * Invoke a command returned by parse_command, the arguments are not needed.
+ * @param[in]  command   The parsed command.
+ * @param[in]  node      server_node instance.
+ * @param[in]  command version, defaults to v1.
+ * @return               The appropriate console return code { -1, 0, 1 }.
+ */
+BCX_API console_result invoke_command(command &command, Json::Value &jv_output,
+                                      bc::server::server_node &node, uint8_t api_version = 1);
+
 } // namespace explorer
 } // namespace libbitcoin
 
@@ -43,6 +43,7 @@ class BCS_API settings
 
     /// Properties.
     uint16_t query_workers;
+    uint16_t rpc_workers;
     uint32_t heartbeat_interval_seconds;
     uint32_t subscription_expiration_minutes;
     uint32_t subscription_limit;
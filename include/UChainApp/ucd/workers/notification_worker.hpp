@@ -77,15 +77,16 @@ class BCS_API notification_worker
     typedef std::shared_ptr<uint8_t> sequence_ptr;
     typedef bc::message::block_msg::ptr_list block_list;
 
-    typedef notifier<address_key, const code &,
-                     const bc::wallet::payment_address &, int32_t, const hash_digest &,
-                     const chain::transaction &>
+    // Prefix filtered subscriptions are indexed by prefix, keyed by route.
+    typedef prefix_notifier<route, const code &,
+                            const bc::wallet::payment_address &, int32_t, const hash_digest &,
+                            const chain::transaction &>
         payment_subscriber;
-    typedef notifier<address_key, const code &, uint32_t, uint32_t,
-                     const hash_digest &, const chain::transaction &>
+    typedef prefix_notifier<route, const code &, uint32_t, uint32_t,
+                            const hash_digest &, const chain::transaction &>
         stealth_subscriber;
-    typedef notifier<address_key, const code &, const binary &, uint32_t,
-                     const hash_digest &, const chain::transaction &>
+    typedef prefix_notifier<route, const code &, const binary &, uint32_t,
+                            const hash_digest &, const chain::transaction &>
         address_subscriber;
     typedef notifier<address_key, const code &, uint32_t,
                      const hash_digest &, const hash_digest &>
@@ -109,10 +110,10 @@ class BCS_API notification_worker
                             const chain::transaction &tx);
 
     // v2/v3 (deprecated)
-    void notify_payment(const bc::wallet::payment_address &address,
-                        uint32_t height, const hash_digest &block_hash,
+    void notify_payment(const binary &field,
+                        const bc::wallet::payment_address &address, uint32_t height, const hash_digest &block_hash,
                         const chain::transaction &tx);
-    void notify_stealth(uint32_t prefix, uint32_t height,
+    void notify_stealth(const binary &field, uint32_t prefix, uint32_t height,
                         const hash_digest &block_hash, const chain::transaction &tx);
 
     // v3
@@ -136,15 +137,13 @@ class BCS_API notification_worker
 
     bool handle_payment(const code &ec, const bc::wallet::payment_address &address,
                         uint32_t height, const hash_digest &block_hash,
-                        const chain::transaction &tx, const route &reply_to, uint32_t id,
-                        const binary &prefix_filter);
+                        const chain::transaction &tx, const route &reply_to, uint32_t id);
     bool handle_stealth(const code &ec, uint32_t prefix, uint32_t height,
                         const hash_digest &block_hash, const chain::transaction &tx,
-                        const route &reply_to, uint32_t id, const binary &prefix_filter);
+                        const route &reply_to, uint32_t id);
     bool handle_address(const code &ec, const binary &field, uint32_t height,
                         const hash_digest &block_hash, const chain::transaction &tx,
-                        const route &reply_to, uint32_t id, const binary &prefix_filter,
-                        sequence_ptr sequence);
+                        const route &reply_to, uint32_t id, sequence_ptr sequence);
 
     const bool secure_;
     const server::settings &settings_;
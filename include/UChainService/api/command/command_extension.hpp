@@ -172,6 +172,12 @@ class command_extension : public command
         return console_result::failure;
     }
 
+    /// The wallet named by the parsed arguments, empty if none.
+    const std::string &wallet_name() const
+    {
+        return auth_.name;
+    }
+
   protected:
     struct argument_base
     {
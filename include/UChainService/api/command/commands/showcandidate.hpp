@@ -71,6 +71,9 @@ class showcandidate : public command_extension
             "index,i",
             value<uint32_t>(&option_.index)->default_value(1),
             "Page index.")(
+            "cursor",
+            value<std::string>(&option_.cursor),
+            "Continue after the page that returned this next_cursor, instead of the page index. \"head\" starts at the latest record.")(
             "current,c",
             value<bool>(&option_.show_current)->default_value(false)->zero_tokens(),
             "If specified then show the lastest information of specified candidate. Default is not specified.");
@@ -99,6 +102,7 @@ class showcandidate : public command_extension
         bool show_current;
         uint32_t index;
         uint32_t limit;
+        std::string cursor;
     } option_;
 };
 
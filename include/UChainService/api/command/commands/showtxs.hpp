@@ -84,7 +84,10 @@ class showtxs : public command_extension
             "Transaction count per page.")(
             "index,i",
             value<uint64_t>(&argument_.index)->default_value(1),
-            "Page index.");
+            "Page index.")(
+            "cursor,c",
+            value<std::string>(&argument_.cursor),
+            "Continue after the page that returned this next_cursor, instead of the page index. A cursor is only valid for the query that returned it.");
 
         return options;
     }
@@ -98,11 +101,12 @@ class showtxs : public command_extension
 
     struct argument
     {
-        argument() : address(""), symbol(""), limit(100), index(0){};
+        argument() : address(""), symbol(""), limit(100), index(0), cursor(""){};
         std::string address;
         std::string symbol;
         uint64_t limit;
         uint64_t index;
+        std::string cursor;
     } argument_;
 
     struct option
@@ -22,6 +22,7 @@
 #include <string>
 #include <memory>
 #include <mongoose/mongoose.h>
+#include <jsoncpp/json/json.h>
 
 namespace mgbubble
 {
@@ -112,6 +113,7 @@ class MgServer
     bool send(struct mg_connection &nc, const char *msg, size_t len, bool close_required = false);
     bool send_frame(struct mg_connection &nc, const std::string &msg, bool binary = false);
     bool send_frame(struct mg_connection &nc, const char *msg, size_t len, bool binary = false);
+    bool send_frame(struct mg_connection &nc, const Json::Value &msg);
 
     void serve_http_static(struct mg_connection &nc, struct http_message &hm)
     {
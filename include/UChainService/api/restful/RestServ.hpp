@@ -18,8 +18,14 @@
  * along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <deque>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+
 #include <UChainService/api/restful/Mongoose.hpp>
 #include <UChainService/api/restful/MgServer.hpp>
+#include <UChainService/api/restful/utility/Json_writer.hpp>
 #include <UChainService/api/restful/utility/Stream_buf.hpp>
 #include <UChainService/api/restful/utility/Tokeniser.hpp>
 #include <UChainService/api/restful/exception/Instances.hpp>
@@ -34,6 +40,10 @@ namespace server
 {
 class server_node;
 }
+namespace explorer
+{
+class command;
+}
 } // namespace libbitcoin
 
 namespace mgbubble
@@ -69,6 +79,7 @@ class RestServ : public MgServer
     void reset(HttpMessage &data) noexcept;
 
     bool start() override;
+    void stop() override;
 
     void spawn_to_mongoose(const std::function<void(uint64_t)> &&handler);
 
@@ -79,6 +90,7 @@ class RestServ : public MgServer
     void on_notify_handler(struct mg_connection &nc, struct mg_event &ev) override;
     void on_ws_handshake_done_handler(struct mg_connection &nc) override;
     void on_ws_frame_handler(struct mg_connection &nc, struct websocket_message &msg) override;
+    void on_close_handler(struct mg_connection &nc) override;
 
   private:
     enum : int
@@ -100,6 +112,31 @@ class RestServ : public MgServer
 
     bool isSet(int bs) const noexcept { return (state_ & bs) == bs; }
 
+    typedef std::function<void()> Job;
+
+    // Commands are parsed on the mongoose thread and run on pool_. Commands
+    // sharing a lane run one at a time, in arrival order; the unnamed lane
+    // runs concurrently across the pool.
+    static std::string lane(explorer::command &command);
+    void execute(const std::string &lane, Job &&job);
+    void run_lane(const std::string &lane);
+
+    // Responses are written on the mongoose thread if the requesting
+    // connection is still open, in the order of its requests as HTTP/1.1
+    // requires of pipelined requests. Touched only on the mongoose thread.
+    typedef std::function<void(mg_connection &)> Reply;
+
+    struct Ticket
+    {
+        uint64_t generation;
+        uint64_t sequence;
+    };
+
+    Ticket track(mg_connection &nc);
+    void reply(mg_connection &nc, const Ticket &ticket, Reply &&response);
+    void send_http_response(mg_connection &nc, const std::string &body);
+    void send_http_response(mg_connection &nc, const Json::Value &body);
+
     // config
     static thread_local OStream out_;
     static thread_local Tokeniser<'/'> uri_;
@@ -107,6 +144,24 @@ class RestServ : public MgServer
     const char *const servername_{"UChain " UC_VERSION};
     libbitcoin::server::server_node &node_;
     string document_root_;
+
+    struct Pending
+    {
+        uint64_t generation;
+
+        // Sequence of the next request and of the next response to write.
+        uint64_t issued;
+        uint64_t written;
+
+        // Responses that are done but wait for an earlier one.
+        std::map<uint64_t, Reply> ready;
+    };
+
+    libbitcoin::threadpool pool_;
+    std::mutex lanes_mutex_;
+    std::unordered_map<std::string, std::deque<Job>> lanes_;
+    std::unordered_map<mg_connection *, Pending> pending_;
+    uint64_t generation_{0};
 };
 
 } // namespace mgbubble
@@ -21,7 +21,9 @@
 #include <vector>
 #include <atomic>
 #include <mutex>
+#include <map>
 #include <memory>
+#include <set>
 #include <unordered_map>
 #include <UChain/coin.hpp>
 #include <UChainService/api/restful/MgServer.hpp>
@@ -111,8 +113,6 @@ class WsPushServ : public MgServer
         struct mg_connection &nc, const std::string &event,
         const std::string &channel, Json::Value data = Json::nullValue);
 
-    void refresh_connections();
-
   protected:
     void run() override;
 
@@ -128,16 +128,34 @@ class WsPushServ : public MgServer
     typedef std::map<std::weak_ptr<mg_connection>, string_vector,
                      std::owner_less<std::weak_ptr<mg_connection>>>
         connection_string_map;
+    typedef std::set<std::weak_ptr<mg_connection>,
+                     std::owner_less<std::weak_ptr<mg_connection>>>
+        connection_set;
+    typedef std::unordered_map<std::string, connection_set> topic_connection_map;
+
+    // A serialized frame and the connections it is sent to.
+    typedef std::vector<std::pair<std::weak_ptr<mg_connection>,
+                                  std::shared_ptr<const std::string>>>
+        delivery_list;
+
+    // These require subscribers_lock_.
+    void subscribe_transactions(const std::weak_ptr<mg_connection> &con,
+                                const string_vector &addresses);
+    void unsubscribe_transactions(const std::weak_ptr<mg_connection> &con);
 
     void do_notify(
         const std::vector<std::weak_ptr<mg_connection>> &notify_cons,
-        Json::Value &value,
-        std::shared_ptr<connection_string_map> topic_map = nullptr);
+        const Json::Value &value);
+    void do_notify(const delivery_list &deliveries);
 
   private:
     libbitcoin::server::server_node &node_;
     std::unordered_map<void *, std::shared_ptr<mg_connection>> map_connections_;
+    // Transaction subscriptions by connection, indexed by address topic.
+    // Connections subscribed without addresses receive every transaction.
     connection_string_map subscribers_;
+    topic_connection_map topic_subscribers_;
+    connection_set all_subscribers_;
     std::mutex subscribers_lock_;
 
     connection_string_map block_subscribers_;
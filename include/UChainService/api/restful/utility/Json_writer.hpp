@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2018-2020 UChain core developers (check UC-AUTHORS).
+ * Copyright (C) 2013-2018 Swirly Cloud Limited.
+ *
+ * This program is free software; you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation; either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program; if
+ * not, write to the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ */
+#ifndef UCD_JSON_WRITER_HPP
+#define UCD_JSON_WRITER_HPP
+
+#include <ostream>
+#include <string>
+
+#include <jsoncpp/json/json.h>
+
+/**
+ * @addtogroup Util
+ * @{
+ */
+
+namespace mgbubble
+{
+
+/**
+ * Writes value to os as compact JSON, without building an intermediate
+ * string, so output can go straight into a connection's send buffer.
+ */
+void writeJson(std::ostream &os, const Json::Value &value);
+
+/**
+ * Compact JSON for output that is shared by several connections.
+ */
+std::string toJson(const Json::Value &value);
+
+} // namespace mgbubble
+
+/** @} */
+
+#endif // UCD_JSON_WRITER_HPP
@@ -24,6 +24,7 @@
 #include <cstddef>
 #include <UChainService/consensus/define.hpp>
 #include <UChainService/consensus/export.hpp>
+#include "primitives/transaction.h"
 #include "pubkey.h"
 #include "script/script_error.h"
 
@@ -45,6 +46,22 @@ class BCK_API TxInputStream
     size_t remaining_;
 };
 
+// The deserialized transaction behind the published opaque declaration.
+class BCK_API transaction_context
+{
+  public:
+    transaction_context(const unsigned char *transaction,
+                        size_t transaction_size);
+
+    /// verify_result_eval_true unless the transaction failed to deserialize.
+    verify_result_type status() const;
+    const CTransaction &transaction() const;
+
+  private:
+    CTransaction tx_;
+    verify_result_type status_;
+};
+
 // These are not published in the public header but are exposed here for test.
 BCK_API verify_result_type script_error_to_verify_result(ScriptError_t code);
 BCK_API unsigned int verify_flags_to_script_flags(unsigned int flags);
@@ -22,6 +22,7 @@
 #define UC_CONSENSUS_EXPORT_HPP
 
 #include <cstddef>
+#include <memory>
 #include <UChainService/consensus/define.hpp>
 #include <UChainService/consensus/version.hpp>
 
@@ -196,6 +197,38 @@ BCK_API verify_result_type verify_script(const unsigned char *transaction,
                                          size_t prevout_script_size, unsigned int tx_input_index,
                                          unsigned int flags);
 
+/**
+ * A transaction deserialized once for the verification of all of its inputs.
+ * The context is immutable once created and may be shared across threads.
+ */
+class transaction_context;
+typedef std::shared_ptr<const transaction_context> transaction_context_ptr;
+
+/**
+ * Deserialize a transaction for repeated calls to verify_script.
+ * @param[in]  transaction         The transaction with the scripts to verify.
+ * @param[in]  transaction_size    The byte length of the transaction.
+ * @returns                        The context, never null. Deserialization
+ *                                 errors are reported by each verification.
+ */
+BCK_API transaction_context_ptr create_transaction_context(
+    const unsigned char *transaction, size_t transaction_size);
+
+/**
+ * Verify that the transaction input correctly spends the previous output,
+ * using a transaction context in place of the serialized transaction.
+ * @param[in]  context             The deserialized transaction.
+ * @param[in]  prevout_script      The script public key to verify against.
+ * @param[in]  prevout_script_size The byte length of the script public key.
+ * @param[in]  tx_input_index      The zero-based index of the transaction
+ *                                 input with signature to be verified.
+ * @param[in]  flags               Verification constraint flags.
+ * @returns                        A script verification result code.
+ */
+BCK_API verify_result_type verify_script(const transaction_context &context,
+                                         const unsigned char *prevout_script, size_t prevout_script_size,
+                                         unsigned int tx_input_index, unsigned int flags);
+
 } // namespace consensus
 } // namespace libbitcoin
 
@@ -25,6 +25,7 @@
 #include <UChain/coin.hpp>
 #include <UChain/database/define.hpp>
 #include <UChain/database/memory/memory_map.hpp>
+#include <UChain/database/primitives/history_cursor.hpp>
 #include <UChain/database/primitives/record_multimap.hpp>
 #include <UChainService/txs/token/token_transfer.hpp>
 #include <UChainService/txs/asset_data.hpp>
@@ -100,6 +101,17 @@ class BCD_API address_token_database
     std::shared_ptr<business_record::list> get(const std::string &address, size_t start, size_t end) const;
     std::shared_ptr<business_record::list> get(const std::string &address, const std::string &symbol,
                                                size_t start_height, size_t end_height, uint64_t limit, uint64_t page_number) const;
+
+    /// The key of the history list of address.
+    static short_hash get_key(const std::string &address);
+
+    /// Rows of address after the cursor, newest first, for at least limit
+    /// transactions. The walk stops at a height boundary so that pages of
+    /// several addresses merge exactly, and resume is set to the first row
+    /// of the last height walked.
+    std::shared_ptr<business_record::list> get(const std::string &address, const std::string &symbol,
+                                               size_t start_height, size_t end_height, uint64_t limit,
+                                               const history_cursor &cursor, array_index &resume) const;
     std::shared_ptr<business_record::list> get(size_t idx) const;
     business_record get_record(size_t idx) const;
 
@@ -25,6 +25,7 @@
 #include <UChain/database/define.hpp>
 #include <UChain/database/memory/memory_map.hpp>
 #include <UChain/database/result/tx_result.hpp>
+#include <UChain/database/primitives/record_multimap.hpp>
 #include <UChain/database/primitives/slab_hash_table.hpp>
 #include <UChain/database/primitives/slab_manager.hpp>
 #include <UChainService/txs/uid/blockchain_uid.hpp>
@@ -44,6 +45,8 @@ class BCD_API blockchain_uid_database
 public:
   /// Construct the database.
   blockchain_uid_database(const boost::filesystem::path &map_filename,
+                          const boost::filesystem::path &index_lookup_filename,
+                          const boost::filesystem::path &index_rows_filename,
                           std::shared_ptr<shared_mutex> mutex = nullptr);
 
   /// Close the database (all threads must first be stopped).
@@ -52,6 +55,9 @@ public:
   /// Initialize a new transaction database.
   bool create();
 
+  /// Start an existing uid table and build its address index from it.
+  bool create_address_index();
+
   /// Call before using the database.
   bool start();
 
@@ -94,12 +100,30 @@ protected:
 
 private:
   typedef slab_hash_table<hash_digest> slab_map;
+  typedef record_hash_table<short_hash> record_map;
+  typedef record_multimap<short_hash> record_multiple_map;
+
+  /// Add the uid record at position to the address index.
+  void store_address_index(const std::string &address, file_offset position);
+
+  /// Remove the index row of the newest uid record of hash.
+  void remove_address_index(const hash_digest &hash);
 
   // Hash table used for looking up txs by hash.
   memory_map lookup_file_;
   slab_hash_table_header lookup_header_;
   slab_manager lookup_manager_;
   slab_map lookup_map_;
+
+  /// Address index, rows are the positions of uid records in lookup_file_.
+  memory_map index_lookup_file_;
+  record_hash_table_header index_lookup_header_;
+  record_manager index_lookup_manager_;
+  record_map index_lookup_map_;
+  memory_map index_rows_file_;
+  record_manager index_rows_manager_;
+  record_list index_rows_list_;
+  record_multiple_map index_rows_multimap_;
 };
 
 } // namespace database
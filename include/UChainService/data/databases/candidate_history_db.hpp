@@ -25,6 +25,7 @@
 #include <UChain/coin.hpp>
 #include <UChain/database/define.hpp>
 #include <UChain/database/memory/memory_map.hpp>
+#include <UChain/database/primitives/history_cursor.hpp>
 #include <UChain/database/primitives/record_multimap.hpp>
 #include <UChainService/txs/asset_data.hpp>
 
@@ -90,6 +91,12 @@ public:
                                                                          uint32_t start_height = 0, uint32_t end_height = 0,
                                                                          uint64_t limit = 0, uint64_t page_number = 0) const;
 
+  /// Rows of key after the cursor, newest first and one per height, up to
+  /// limit. The cursor is moved past the last row returned.
+  std::shared_ptr<candidate_info::list> get_history_candidates_by_height(const short_hash &key,
+                                                                         history_cursor &cursor,
+                                                                         uint64_t limit) const;
+
   std::shared_ptr<candidate_info::list> get_history_candidates_by_time(const short_hash &key,
                                                                        uint32_t time_begin, uint32_t time_end,
                                                                        uint64_t limit = 0, uint64_t page_number = 0) const;
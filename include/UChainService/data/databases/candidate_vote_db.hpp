@@ -0,0 +1,116 @@
+/**
+ * Copyright (c) 2018-2020 UChain core developers (check UC-AUTHORS)
+ *
+ * This file is part of UChain.
+ *
+ * UChain is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef UC_DATABASE_CANDIDATE_VOTE_DATABASE_HPP
+#define UC_DATABASE_CANDIDATE_VOTE_DATABASE_HPP
+
+#include <memory>
+#include <boost/filesystem.hpp>
+#include <UChain/coin.hpp>
+#include <UChain/database/define.hpp>
+#include <UChain/database/memory/memory_map.hpp>
+#include <UChain/database/primitives/record_multimap.hpp>
+
+namespace libbitcoin
+{
+namespace database
+{
+
+struct BCD_API candidate_vote_statinfo
+{
+    /// Number of buckets used in the hashtable.
+    /// load factor = candidates / buckets
+    const size_t buckets;
+
+    /// Total number of candidates with a tally.
+    const size_t candidates;
+
+    /// Total number of rows across all tallies.
+    const size_t rows;
+};
+
+/// The unspent vote tally of each candidate, keyed by the candidate uid hash.
+/// A row holds the tally after each block that changed it, newest first, so
+/// the tally at a cycle boundary is found by skipping the rows above it.
+class BCD_API candidate_vote_database
+{
+  public:
+    /// Construct the database.
+    candidate_vote_database(const boost::filesystem::path &lookup_filename,
+                            const boost::filesystem::path &rows_filename,
+                            std::shared_ptr<shared_mutex> mutex = nullptr);
+
+    /// Close the database (all threads must first be stopped).
+    ~candidate_vote_database();
+
+    /// Initialize a new candidate_vote database.
+    bool create();
+
+    /// Call before using the database.
+    bool start();
+
+    /// Call to signal a stop of current operations.
+    bool stop();
+
+    /// Call to unload the memory map.
+    bool close();
+
+    /// Add votes paid to the candidate in the block at height.
+    void credit(const short_hash &uid_key, uint32_t height, uint64_t amount);
+
+    /// Remove votes for the candidate spent in the block at height.
+    void debit(const short_hash &uid_key, uint32_t height, uint64_t amount);
+
+    /// Drop the rows at or above height from the tally of the candidate.
+    void unlink(const short_hash &uid_key, uint32_t height);
+
+    /// The tally of the candidate after the block at height.
+    uint64_t get(const short_hash &uid_key,
+                 uint32_t height = max_uint32) const;
+
+    /// Synchonise with disk.
+    void sync();
+
+    /// Return statistical info about the database.
+    candidate_vote_statinfo statinfo() const;
+
+  private:
+    typedef record_hash_table<short_hash> record_map;
+    typedef record_multimap<short_hash> record_multiple_map;
+
+    void update(const short_hash &uid_key, uint32_t height, uint64_t amount,
+                bool spend);
+
+    /// Hash table used for start index lookup for linked list by uid hash.
+    memory_map lookup_file_;
+    record_hash_table_header lookup_header_;
+    record_manager lookup_manager_;
+    record_map lookup_map_;
+
+    /// List of tally rows.
+    memory_map rows_file_;
+    record_manager rows_manager_;
+    record_list rows_list_;
+    record_multiple_map rows_multimap_;
+};
+
+} // namespace database
+} // namespace libbitcoin
+
+#endif
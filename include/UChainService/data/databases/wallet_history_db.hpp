@@ -0,0 +1,162 @@
+/**
+ * Copyright (c) 2018-2020 UChain core developers (check UC-AUTHORS)
+ *
+ * This file is part of UChain.
+ *
+ * UChain is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef UC_DATABASE_WALLET_HISTORY_DATABASE_HPP
+#define UC_DATABASE_WALLET_HISTORY_DATABASE_HPP
+
+#include <memory>
+#include <vector>
+#include <boost/filesystem.hpp>
+#include <UChain/coin.hpp>
+#include <UChain/database/define.hpp>
+#include <UChain/database/memory/memory_map.hpp>
+#include <UChain/database/primitives/history_cursor.hpp>
+#include <UChain/database/primitives/record_multimap.hpp>
+
+namespace libbitcoin
+{
+namespace database
+{
+
+/// A transaction that touches an address of a wallet.
+struct BCD_API wallet_tx
+{
+    typedef std::vector<wallet_tx> list;
+
+    uint32_t height;
+    uint32_t timestamp;
+    hash_digest hash;
+};
+
+struct BCD_API wallet_history_statinfo
+{
+    /// Number of buckets used in the hashtable.
+    /// load factor = wallets / buckets
+    const size_t buckets;
+
+    /// Total number of wallets with a timeline.
+    const size_t wallets;
+
+    /// Total number of rows across all timelines.
+    const size_t rows;
+};
+
+/// The transaction timeline of each wallet, keyed by the wallet name hash,
+/// with an index of the wallets that hold each address. Rows of a wallet
+/// order as history_cursor does, newest first, so a page of wallet history
+/// is one walk of at most limit rows.
+class BCD_API wallet_history_database
+{
+  public:
+    /// Construct the database.
+    wallet_history_database(const boost::filesystem::path &lookup_filename,
+                            const boost::filesystem::path &rows_filename,
+                            const boost::filesystem::path &owners_lookup_filename,
+                            const boost::filesystem::path &owners_rows_filename,
+                            std::shared_ptr<shared_mutex> mutex = nullptr);
+
+    /// Close the database (all threads must first be stopped).
+    ~wallet_history_database();
+
+    /// Initialize a new wallet_history database.
+    bool create();
+
+    /// Call before using the database.
+    bool start();
+
+    /// Call to signal a stop of current operations.
+    bool stop();
+
+    /// Call to unload the memory map.
+    bool close();
+
+    /// The wallets that hold the address.
+    std::vector<short_hash> owners(const short_hash &address_key) const;
+
+    /// Record that the wallet holds the address, once.
+    void add_owner(const short_hash &address_key, const short_hash &wallet_key);
+
+    /// Forget that the wallet holds the address.
+    void remove_owner(const short_hash &address_key, const short_hash &wallet_key);
+
+    /// Add the transactions of a block above the timeline of the wallet.
+    void store(const short_hash &wallet_key, wallet_tx::list txs);
+
+    /// Drop the rows at or above height from the timeline of the wallet.
+    void unlink(const short_hash &wallet_key, uint32_t height);
+
+    /// Replace the timeline of the wallet, txs may be in any order.
+    void rebuild(const short_hash &wallet_key, wallet_tx::list txs);
+
+    /// The whole timeline of the wallet, newest first.
+    wallet_tx::list get(const short_hash &wallet_key) const;
+
+    /// Rows of the wallet after the cursor within [start_height, end_height),
+    /// newest first, up to limit. The cursor is moved to the last row.
+    wallet_tx::list get(const short_hash &wallet_key, history_cursor &cursor,
+                        size_t start_height, size_t end_height, size_t limit) const;
+
+    /// The number of rows of the wallet within [start_height, end_height).
+    size_t count(const short_hash &wallet_key, size_t start_height = 0,
+                 size_t end_height = 0) const;
+
+    /// Synchonise with disk.
+    void sync();
+
+    /// Return statistical info about the database.
+    wallet_history_statinfo statinfo() const;
+
+  private:
+    typedef record_hash_table<short_hash> record_map;
+    typedef record_multimap<short_hash> record_multiple_map;
+
+    // Newest first, the order of history_cursor.
+    static bool newer(const wallet_tx &left, const wallet_tx &right);
+
+    void add_rows(const short_hash &wallet_key, wallet_tx::list &txs);
+
+    /// Hash table used for start index lookup for linked list by wallet hash.
+    memory_map lookup_file_;
+    record_hash_table_header lookup_header_;
+    record_manager lookup_manager_;
+    record_map lookup_map_;
+
+    /// List of timeline rows.
+    memory_map rows_file_;
+    record_manager rows_manager_;
+    record_list rows_list_;
+    record_multiple_map rows_multimap_;
+
+    /// Hash table of the wallets holding an address, by address hash.
+    memory_map owners_lookup_file_;
+    record_hash_table_header owners_lookup_header_;
+    record_manager owners_lookup_manager_;
+    record_map owners_lookup_map_;
+
+    /// List of owner rows.
+    memory_map owners_rows_file_;
+    record_manager owners_rows_manager_;
+    record_list owners_rows_list_;
+    record_multiple_map owners_rows_multimap_;
+};
+
+} // namespace database
+} // namespace libbitcoin
+
+#endif
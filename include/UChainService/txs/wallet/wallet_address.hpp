@@ -26,6 +26,7 @@
 #include <UChain/coin/chain/point.hpp>
 #include <UChain/coin/chain/script/script.hpp>
 #include <UChain/coin/define.hpp>
+#include <UChain/coin/math/crypto.hpp>
 #include <UChain/coin/utility/reader.hpp>
 #include <UChain/coin/utility/writer.hpp>
 
@@ -81,8 +82,10 @@ class BC_API wallet_address
     const std::string &get_name() const;
     void set_name(const std::string &name);
     const std::string get_prv_key(std::string &passphrase) const;
+    const std::string get_prv_key(aes256_key &key) const;
     const std::string get_prv_key() const;
     void set_prv_key(const std::string &prv_key, std::string &passphrase);
+    void set_prv_key(const std::string &prv_key, aes256_key &key);
     void set_prv_key(const std::string &prv_key);
     const std::string &get_pub_key() const;
     void set_pub_key(const std::string &pub_key);
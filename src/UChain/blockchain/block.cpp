@@ -29,6 +29,7 @@ namespace blockchain
 
 using namespace chain;
 
+// database::chain_work_database::header_work mirrors this.
 u256 block_work(u256 bits)
 {
     return bits;
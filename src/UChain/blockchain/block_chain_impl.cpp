@@ -40,6 +40,7 @@
 #include <UChain/blockchain/tx_pool.hpp>
 #include <UChain/blockchain/validate_tx_engine.hpp>
 #include <UChain/blockchain/wallet_security_strategy.hpp>
+#include <UChain/blockchain/wallet_session.hpp>
 namespace libbitcoin
 {
 namespace blockchain
@@ -58,10 +59,12 @@ block_chain_impl::block_chain_impl(threadpool &pool,
                                    const database::settings &database_settings)
     : stopped_(true),
       settings_(chain_settings),
+      pool_(pool),
       organizer_(pool, *this, chain_settings),
       ////read_dispatch_(pool, NAME),
       ////write_dispatch_(pool, NAME),
       tx_pool_(pool, *this, chain_settings),
+      script_cache_(chain_settings.script_cache_capacity),
       database_(database_settings)
 {
 }
@@ -95,6 +98,11 @@ tx_pool &block_chain_impl::pool()
     return tx_pool_;
 }
 
+script_cache &block_chain_impl::get_script_cache()
+{
+    return script_cache_;
+}
+
 const settings &block_chain_impl::chain_settings() const
 {
     return settings_;
@@ -113,6 +121,10 @@ bool block_chain_impl::start()
     organizer_.start();
     tx_pool_.start();
 
+    session_timer_ = std::make_shared<deadline>(pool_, asio::seconds(60));
+    session_timer_->start(std::bind(&block_chain_impl::handle_session_timer,
+                                    this, std::placeholders::_1));
+
     //init the single instance here, to avoid multi-thread init confilict
     auto *temp = wallet_security_strategy::get_instance();
 
@@ -125,6 +137,10 @@ bool block_chain_impl::stop()
     stopped_ = true;
     organizer_.stop();
     tx_pool_.stop();
+
+    if (session_timer_)
+        session_timer_->stop();
+
     return database_.stop();
 }
 
@@ -141,6 +157,17 @@ bool block_chain_impl::stopped() const
     return stopped_;
 }
 
+// Expired sessions are dropped even if their wallet is never used again.
+void block_chain_impl::handle_session_timer(const code &ec)
+{
+    if (ec || stopped())
+        return;
+
+    wallet_session::get_instance()->sweep();
+    session_timer_->start(std::bind(&block_chain_impl::handle_session_timer,
+                                    this, std::placeholders::_1));
+}
+
 // Subscriber
 // ------------------------------------------------------------------------
 
@@ -194,6 +221,21 @@ bool block_chain_impl::get_difficulty(u256 &out_difficulty,
         return false;
 
     out_difficulty = 0;
+    if (height > top)
+        return true;
+
+    // The work above the fork point is the difference of the cumulative
+    // work at the top and below the fork point.
+    uint64_t top_work;
+    uint64_t fork_work = 0;
+    if (database_.chain_work.get(top_work, top) &&
+        (height == 0 || database_.chain_work.get(fork_work, height - 1)))
+    {
+        out_difficulty = top_work - fork_work;
+        return true;
+    }
+
+    // Heights above a gap are not indexed, sum their headers.
     for (uint64_t index = height; index <= top; ++index)
     {
         const auto bits = database_.blocks.get(index).header().timestamp;
@@ -259,6 +301,32 @@ bool block_chain_impl::get_transaction(transaction &out_transaction,
     return true;
 }
 
+bool block_chain_impl::get_unspent_output(chain::output &out_output,
+                                          uint64_t &out_height, bool &out_coinbase,
+                                          const chain::output_point &outpoint) const
+{
+    const auto result = database_.utxos.get(outpoint);
+    if (!result)
+        return false;
+
+    out_output = result.output();
+    out_height = result.height();
+    out_coinbase = result.is_coinbase();
+    return true;
+}
+
+database::address_balance block_chain_impl::get_address_balance(
+    const std::string &address, const std::string &symbol) const
+{
+    return database_.balances.get(address, symbol);
+}
+
+database::frozen_output::list block_chain_impl::get_address_frozen(
+    const std::string &address, uint64_t height) const
+{
+    return database_.balances.get_frozen(address, height, coinbase_maturity);
+}
+
 // This is safe to call concurrently (but with no other methods).
 bool block_chain_impl::import(block::ptr block, uint64_t height)
 {
@@ -270,6 +338,7 @@ bool block_chain_impl::import(block::ptr block, uint64_t height)
     return true;
 }
 
+// The caller holds the write section, see organizer::replace_chain.
 bool block_chain_impl::push(block_info::ptr block)
 {
     database_.push(*block->actual());
@@ -352,15 +421,15 @@ void block_chain_impl::store(message::block_msg::ptr block,
 }
 
 // This processes the block through the organizer.
+// Validation only reads the chain, so the write lock is taken by the
+// organizer around the pops and pushes of a reorganization only.
 void block_chain_impl::do_store(message::block_msg::ptr block,
                                 block_store_handler handler)
 {
-    start_write();
-
     // fail fast if the block is already stored...
     if (database_.blocks.get(block->header.hash()))
     {
-        stop_write(handler, error::duplicate, 0);
+        handler(error::duplicate, 0);
         return;
     }
 
@@ -369,7 +438,7 @@ void block_chain_impl::do_store(message::block_msg::ptr block,
     // ...or if the block is already orphaned.
     if (!organizer_.add(detail))
     {
-        stop_write(handler, error::duplicate, 0);
+        handler(error::duplicate, 0);
         return;
     }
 
@@ -377,7 +446,7 @@ void block_chain_impl::do_store(message::block_msg::ptr block,
     organizer_.organize();
 
     //...and then get the particular block's status.
-    stop_write(handler, detail->error(), detail->height());
+    handler(detail->error(), detail->height());
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -390,20 +459,11 @@ void block_chain_impl::do_store(message::block_msg::ptr block,
 void block_chain_impl::fetch_serial(perform_read_functor perform_read)
 {
     // Post IBD writes are ordered on the strand, so never concurrent.
-    // Reads are unordered and concurrent, but effectively blocked by writes.
-    const auto try_read = [this, perform_read]() {
-        const auto handle = database_.begin_read();
-        return (!database_.is_write_locked(handle) && perform_read(handle));
-    };
-
-    const auto do_read = [try_read]() {
-        // Sleep while waiting for write to complete.
-        while (!try_read())
-            std::this_thread::sleep_for(asio::milliseconds(10));
-    };
-
-    // Initiate serial read operation.
-    do_read();
+    // Reads are unordered and concurrent, and wait only while a block is
+    // being written (never while one is validated). A read that overlaps a
+    // write is discarded by finish_fetch and retried once it is published.
+    while (!perform_read(database_.begin_read_wait()))
+        ;
 }
 
 ////void block_chain_impl::fetch_parallel(perform_read_functor perform_read)
@@ -894,9 +954,13 @@ void block_chain_impl::fetch_last_height(last_height_fetch_handler handler)
         return;
     }
 
+    // A reorganization pops below the new top first, so the height is
+    // only returned when no write overlapped the read.
     const auto do_fetch = [this, handler](size_t slock) {
         size_t last_height;
-        return database_.blocks.top(last_height) ? finish_fetch(slock, handler, error::success, last_height) : finish_fetch(slock, handler, error::not_found, 0);
+        return database_.blocks.top(last_height) ?
+            finish_fetch(slock, handler, error::success, last_height) :
+            finish_fetch(slock, handler, error::not_found, 0);
     };
     fetch_serial(do_fetch);
 }
@@ -1077,6 +1141,50 @@ std::string block_chain_impl::is_wallet_lastwd_valid(const libbitcoin::chain::wa
     return mnemonic;
 }
 
+// Decrypts every address key of the wallet once and keeps them in the
+// session until the timeout passes or the wallet is locked again.
+void block_chain_impl::unlock_wallet(const std::string &name, const std::string &passwd, uint32_t timeout)
+{
+    auto wallet = is_wallet_passwd_valid(name, passwd);
+    auto keyring = std::make_shared<wallet_keyring>(wallet->get_passwd(), wallet_session::now() + timeout);
+
+    aes256_key key(passphrase_secret(passwd));
+    auto pvaddr = get_wallet_addresses(name);
+    for (auto &each : *pvaddr)
+    {
+        keyring->store(each.get_address(), each.get_prv_key(key));
+    }
+
+    wallet_session::get_instance()->unlock(name, keyring);
+}
+
+void block_chain_impl::lock_wallet(const std::string &name)
+{
+    wallet_session::get_instance()->lock(name);
+}
+
+wallet_keyring::ptr block_chain_impl::get_wallet_keyring(const std::string &name, const std::string &passwd)
+{
+    return wallet_session::get_instance()->get(name, get_hash(passwd));
+}
+
+std::string block_chain_impl::get_wallet_prv_key(const wallet_address &address, const std::string &passwd)
+{
+    std::string prv_key;
+    const auto keyring = get_wallet_keyring(address.get_name(), passwd);
+    const auto copy = [&prv_key](const char *data, size_t size) {
+        prv_key.assign(data, size);
+    };
+
+    if (keyring && keyring->find(address.get_address(), copy))
+    {
+        return prv_key;
+    }
+
+    std::string passphrase(passwd);
+    return address.get_prv_key(passphrase);
+}
+
 void block_chain_impl::set_wallet_passwd(const std::string &name, const std::string &passwd)
 {
     auto wallet = get_wallet(name);
@@ -1151,6 +1259,7 @@ operation_result block_chain_impl::delete_wallet(const std::string &name)
     // Critical Section.
     unique_lock lock(mutex_);
 
+    lock_wallet(name);
     database_.wallets.remove(get_hash(name));
     database_.wallets.sync();
     ///////////////////////////////////////////////////////////////////////////
@@ -1176,6 +1285,7 @@ operation_result block_chain_impl::store_wallet_address(std::shared_ptr<wallet_a
     const auto hash = get_short_hash(address->get_name());
     database_.wallet_addresses.store(hash, *address);
     database_.wallet_addresses.sync();
+    database_.push_wallet_address(address->get_name(), address->get_address());
     ///////////////////////////////////////////////////////////////////////////
     return operation_result::okay;
 }
@@ -1192,11 +1302,17 @@ operation_result block_chain_impl::delete_wallet_address(const std::string &name
     // Critical Section.
     unique_lock lock(mutex_);
 
+    lock_wallet(name);
     auto hash = get_short_hash(name);
     auto addr_vec = database_.wallet_addresses.get(hash);
+    std::vector<std::string> addresses;
     for (auto each : addr_vec)
+    {
+        addresses.push_back(each.get_address());
         database_.wallet_addresses.delete_last_row(hash);
+    }
     database_.wallet_addresses.sync();
+    database_.pop_wallet_addresses(name, addresses);
     ///////////////////////////////////////////////////////////////////////////
     return operation_result::okay;
 }
@@ -1217,9 +1333,15 @@ operation_result block_chain_impl::delete_n_wallet_address(const std::string &na
     auto addr_vec = database_.wallet_addresses.get(hash);
     if (count >= addr_vec.size())
         throw std::logic_error{"Parameter count should less than the count of your address!"};
+    // rows are newest first, as delete_last_row drops them
+    std::vector<std::string> addresses;
     for (size_t i = 0; i < count; i++)
+    {
+        addresses.push_back(addr_vec[i].get_address());
         database_.wallet_addresses.delete_last_row(hash);
+    }
     database_.wallet_addresses.sync();
+    database_.pop_wallet_addresses(name, addresses);
     ///////////////////////////////////////////////////////////////////////////
     return operation_result::okay;
 }
@@ -1439,8 +1561,9 @@ std::shared_ptr<token_cert> block_chain_impl::get_wallet_token_cert(
     if (!pvaddr)
         return nullptr;
 
-    chain::transaction tx_temp;
-    uint64_t tx_height;
+    chain::output output;
+    uint64_t output_height;
+    bool coinbase;
 
     for (auto &each : *pvaddr)
     {
@@ -1450,10 +1573,8 @@ std::shared_ptr<token_cert> block_chain_impl::get_wallet_token_cert(
         for (auto &row : rows)
         {
             // spend unconfirmed (or no spend attempted)
-            if ((row.spend.hash == null_hash) && get_transaction(row.output.hash, tx_temp, tx_height))
+            if ((row.spend.hash == null_hash) && get_utxo(row.output, output, output_height, coinbase))
             {
-                BITCOIN_ASSERT(row.output.index < tx_temp.outputs.size());
-                const auto &output = tx_temp.outputs.at(row.output.index);
                 if (output.is_token_cert())
                 {
                     auto cert = output.get_token_cert();
@@ -1551,6 +1672,15 @@ bool block_chain_impl::exist_in_candidates(std::string uid)
     return false;
 }
 
+uint64_t block_chain_impl::get_candidate_votes(const std::string &uid,
+                                               uint64_t height)
+{
+    BITCOIN_ASSERT(!uid.empty());
+    const auto snapshot = std::min<uint64_t>(height, max_uint32);
+    return database_.candidate_votes.get(get_short_hash(uid),
+                                         static_cast<uint32_t>(snapshot));
+}
+
 std::shared_ptr<candidate_info::list> block_chain_impl::get_candidate_history(
     const std::string &symbol, uint64_t limit, uint64_t page_number)
 {
@@ -1559,6 +1689,13 @@ std::shared_ptr<candidate_info::list> block_chain_impl::get_candidate_history(
     return database_.candidate_history.get_history_candidates_by_height(get_short_hash(symbol), 0, 0, limit, page_number);
 }
 
+std::shared_ptr<candidate_info::list> block_chain_impl::get_candidate_history(
+    const std::string &symbol, database::history_cursor &cursor, uint64_t limit)
+{
+    BITCOIN_ASSERT(!symbol.empty());
+    return database_.candidate_history.get_history_candidates_by_height(get_short_hash(symbol), cursor, limit);
+}
+
 std::shared_ptr<candidate::list> block_chain_impl::get_wallet_candidates(
     const std::string &wallet, const std::string &symbol)
 {
@@ -1568,8 +1705,9 @@ std::shared_ptr<candidate::list> block_chain_impl::get_wallet_candidates(
     if (!pvaddr)
         return sp_vec;
 
-    chain::transaction tx_temp;
-    uint64_t tx_height;
+    chain::output output;
+    uint64_t output_height;
+    bool coinbase;
 
     for (auto &each : *pvaddr)
     {
@@ -1579,10 +1717,8 @@ std::shared_ptr<candidate::list> block_chain_impl::get_wallet_candidates(
         for (auto &row : rows)
         {
             // spend unconfirmed (or no spend attempted)
-            if ((row.spend.hash == null_hash) && get_transaction(row.output.hash, tx_temp, tx_height))
+            if ((row.spend.hash == null_hash) && get_utxo(row.output, output, output_height, coinbase))
             {
-                BITCOIN_ASSERT(row.output.index < tx_temp.outputs.size());
-                const auto &output = tx_temp.outputs.at(row.output.index);
                 if (output.is_candidate())
                 {
                     auto &&token = output.get_candidate();
@@ -1609,15 +1745,15 @@ uint64_t block_chain_impl::get_address_token_volume(const std::string &addr, con
     auto address = payment_address(addr);
     auto &&rows = get_address_history(address);
 
-    chain::transaction tx_temp;
-    uint64_t tx_height;
+    chain::output output;
+    uint64_t output_height;
+    bool coinbase;
 
     for (auto &row : rows)
     {
         // spend unconfirmed (or no spend attempted)
-        if ((row.spend.hash == null_hash) && get_transaction(tx_temp, tx_height, row.output.hash))
+        if ((row.spend.hash == null_hash) && get_utxo(row.output, output, output_height, coinbase))
         {
-            auto output = tx_temp.outputs.at(row.output.index);
             if ((output.is_token_transfer() || output.is_token_issue() || output.is_token_secondaryissue()))
             {
                 if (output.get_token_symbol() == token)
@@ -1746,6 +1882,28 @@ std::shared_ptr<business_record::list> block_chain_impl::get_address_business_re
     return database_.address_tokens.get(address, symbol, start_height, end_height, limit, page_number);
 }
 
+// get records of the address after the cursor, see address_token_database
+std::shared_ptr<business_record::list> block_chain_impl::get_address_business_record(const std::string &address,
+                                                                                     const std::string &symbol, size_t start_height, size_t end_height, uint64_t limit,
+                                                                                     const database::history_cursor &cursor, array_index &resume) const
+{
+    return database_.address_tokens.get(address, symbol, start_height, end_height, limit, cursor, resume);
+}
+
+// get the wallet timeline after the cursor, newest first
+std::shared_ptr<database::wallet_tx::list> block_chain_impl::get_wallet_history(const std::string &name,
+                                                                                database::history_cursor &cursor, uint64_t start_height, uint64_t end_height, uint64_t limit)
+{
+    return std::make_shared<database::wallet_tx::list>(
+        database_.wallet_history.get(get_short_hash(name), cursor, start_height, end_height, limit));
+}
+
+uint64_t block_chain_impl::get_wallet_history_count(const std::string &name,
+                                                    uint64_t start_height, uint64_t end_height)
+{
+    return database_.wallet_history.count(get_short_hash(name), start_height, end_height);
+}
+
 // get special tokens of the wallet/name, just used for token_detail/token_transfer
 std::shared_ptr<business_history::list> block_chain_impl::get_address_business_history(const std::string &addr,
                                                                                        business_kind kind, uint8_t confirmed)
@@ -2299,6 +2457,38 @@ bool block_chain_impl::get_transaction(const hash_digest &hash,
     return ret;
 }
 
+// Read the compact utxo record. Every confirmed unspent output has one, so
+// only pooled outputs are read from their transaction.
+bool block_chain_impl::get_utxo(const chain::output_point &outpoint,
+                                chain::output &output, uint64_t &output_height, bool &coinbase)
+{
+    if (stopped())
+        return false;
+
+    if (get_unspent_output(output, output_height, coinbase, outpoint))
+        return true;
+
+    boost::mutex mutex;
+    tx_message::ptr tx_ptr = nullptr;
+
+    mutex.lock();
+    auto f = [&tx_ptr, &mutex](const code &ec, tx_message::ptr tx_) -> void {
+        if ((code)error::success == ec)
+            tx_ptr = tx_;
+        mutex.unlock();
+    };
+
+    pool().fetch(outpoint.hash, f);
+    boost::unique_lock<boost::mutex> lock(mutex);
+    if (!tx_ptr || outpoint.index >= tx_ptr->outputs.size())
+        return false;
+
+    output = tx_ptr->outputs[outpoint.index];
+    output_height = 0;
+    coinbase = tx_ptr->is_coinbase();
+    return true;
+}
+
 bool block_chain_impl::get_transaction_callback(const hash_digest &hash,
                                                 std::function<void(const code &, const chain::transaction &)> handler)
 {
@@ -2560,6 +2750,9 @@ void block_chain_impl::safe_store_wallet(libbitcoin::chain::wallet &acc, const s
     }
     database_.wallet_addresses.sync();
 
+    for (auto &address : addresses)
+        database_.push_wallet_address(address->get_name(), address->get_address());
+
     database_.wallets.store(acc);
     database_.wallets.sync();
 }
@@ -53,6 +53,7 @@ organizer::organizer(threadpool &pool, simple_chain &chain,
     : stopped_(true),
       use_testnet_rules_(settings.use_testnet_rules),
       checkpoints_(checkpoint::sort(settings.checkpoints)),
+      pool_(pool),
       chain_(chain),
       orphan_pool_(settings.block_pool_capacity),
       subscriber_(std::make_shared<reorganize_subscriber>(pool, NAME))
@@ -110,7 +111,7 @@ code organizer::verify(uint64_t fork_point,
 
     // Validates current_block
     validate_block_impl validate(chain_, fork_point, orphan_chain, orphan_index, height,
-                                 *current_block, use_testnet_rules_, checkpoints_, callback);
+                                 *current_block, use_testnet_rules_, checkpoints_, callback, &pool_);
 
     // Checks that are independent of the chain.
     auto ec = validate.check_block(static_cast<blockchain::block_chain_impl &>(this->chain_));
@@ -164,10 +165,13 @@ code organizer::verify(uint64_t fork_point,
     const auto ms_per_input = ms_per_block / total_inputs;
     const auto seconds_per_block = ms_per_block / 1000;
     const auto verified = ec ? "unverified" : "verified";
+    const auto &scripts = static_cast<block_chain_impl &>(chain_).get_script_cache();
 
     log::info(LOG_BLOCKCHAIN)
         << "Block [" << height << "] " << verified << " in ("
-        << seconds_per_block << ") secs or (" << ms_per_input << ") ms/input";
+        << seconds_per_block << ") secs or (" << ms_per_input << ") ms/input on ("
+        << validate.script_threads() << ") script threads, script cache ("
+        << scripts.hits() << ") hits and (" << scripts.misses() << ") misses";
 
     return ec;
 }
@@ -307,6 +311,12 @@ void organizer::replace_chain(uint64_t fork_index,
     }
 
     // Replace! Switch!
+    // Readers must not see the chain between the pops and the pushes.
+    // The section is closed on every exit, including a throw from the store.
+    chain_.start_write();
+    const auto stop_write = [](simple_chain *chain) { chain->stop_write(); };
+    std::unique_ptr<simple_chain, decltype(stop_write)> write_section(&chain_, stop_write);
+
     block_info::list released_blocks;
     auto success = chain_.pop_from(released_blocks, begin_index);
 
@@ -358,6 +368,8 @@ void organizer::replace_chain(uint64_t fork_index,
         }
     }
 
+    write_section.reset();
+
     // Add the old blocks back to the pool (as processed with orphan height).
     for (const auto replaced_block : released_blocks)
     {
@@ -22,6 +22,7 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <iterator>
 #include <UChain/blockchain/block_info.hpp>
 
 namespace libbitcoin
@@ -30,36 +31,43 @@ namespace blockchain
 {
 
 orphan_pool::orphan_pool(size_t capacity)
+    : sequence_(0)
 {
-    buffer_.reserve(capacity == 0 ? 1 : capacity);
+    blocks_.reserve(capacity == 0 ? 1 : capacity);
 }
 
 // There is no validation whatsoever of the block up to this pont.
 bool orphan_pool::add(block_info::ptr block)
 {
     const auto &header = block->actual()->header;
+    const auto hash = block->hash();
 
     ///////////////////////////////////////////////////////////////////////////
     // Critical Section
     mutex_.lock_upgrade();
 
     // No duplicates allowed.
-    if (exists(header))
+    if (exists(hash))
     {
         mutex_.unlock_upgrade();
         //-----------------------------------------------------------------
         return false;
     }
 
-    const auto old_size = buffer_.size();
+    const auto old_size = blocks_.size();
     //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
     mutex_.unlock_upgrade_and_lock();
-    buffer_.push_back(block);
+    const auto sequence = sequence_++;
+    blocks_.emplace(hash, entry{block, sequence});
+
+    if (!block->processed())
+        unprocessed_.emplace(sequence, block);
+
     mutex_.unlock();
     ///////////////////////////////////////////////////////////////////////////
 
     log::debug(LOG_BLOCKCHAIN)
-        << "Orphan pool added block [" << encode_hash(block->hash())
+        << "Orphan pool added block [" << encode_hash(hash)
         << "] previous [" << encode_hash(header.previous_block_hash)
         << "] old size (" << old_size << ").";
 
@@ -72,19 +80,20 @@ void orphan_pool::remove(block_info::ptr block)
     // Critical Section
     mutex_.lock_upgrade();
 
-    const auto it = std::find(buffer_.begin(), buffer_.end(), block);
+    const auto it = blocks_.find(block->hash());
 
-    if (it == buffer_.end())
+    if (it == blocks_.end() || it->second.block != block)
     {
         mutex_.unlock_upgrade();
         //-----------------------------------------------------------------
         return;
     }
 
-    const auto old_size = buffer_.size();
+    const auto old_size = blocks_.size();
     //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
     mutex_.unlock_upgrade_and_lock();
-    buffer_.erase(it);
+    unprocessed_.erase(it->second.sequence);
+    blocks_.erase(it);
     mutex_.unlock();
     ///////////////////////////////////////////////////////////////////////////
 
@@ -93,7 +102,6 @@ void orphan_pool::remove(block_info::ptr block)
         << "] old size (" << old_size << "). with status: " << block->error().message();
 }
 
-// TODO: use hash table pool to eliminate this O(n^2) search.
 void orphan_pool::filter(message::get_data::ptr message) const
 {
     auto &inventories = message->inventories;
@@ -113,7 +121,6 @@ void orphan_pool::filter(message::get_data::ptr message) const
 block_info::list orphan_pool::trace(block_info::ptr end) const
 {
     block_info::list trace;
-    trace.reserve(buffer_.size());
     trace.push_back(end);
     auto hash = end->actual()->header.previous_block_hash;
 
@@ -121,10 +128,14 @@ block_info::list orphan_pool::trace(block_info::ptr end) const
     // Critical Section
     mutex_.lock_shared();
 
-    for (auto it = rfind(buffer_.rbegin(), hash); it != buffer_.rend(); it = rfind(it, hash))
+    // Each link is a lookup, so this is linear in the length of the chain.
+    // The size bound guards against a cycle, which would need a hash cycle.
+    for (auto it = blocks_.find(hash);
+         it != blocks_.end() && trace.size() <= blocks_.size();
+         it = blocks_.find(hash))
     {
-        trace.push_back(*it);
-        hash = (*it)->actual()->header.previous_block_hash;
+        trace.push_back(it->second.block);
+        hash = it->second.block->actual()->header.previous_block_hash;
     }
 
     mutex_.unlock_shared();
@@ -132,28 +143,35 @@ block_info::list orphan_pool::trace(block_info::ptr end) const
 
     BITCOIN_ASSERT(!trace.empty());
     std::reverse(trace.begin(), trace.end());
-    trace.shrink_to_fit();
     return trace;
 }
 
 block_info::list orphan_pool::unprocessed() const
 {
     block_info::list unprocessed;
-    unprocessed.reserve(buffer_.size());
 
     ///////////////////////////////////////////////////////////////////////////
     // Critical Section
-    mutex_.lock_shared();
+    unique_lock lock(mutex_);
 
-    // Earlier blocks enter pool first, so reversal helps avoid fragmentation.
-    for (auto it = buffer_.rbegin(); it != buffer_.rend(); ++it)
-        if (!(*it)->processed())
-            unprocessed.push_back(*it);
+    unprocessed.reserve(unprocessed_.size());
 
-    mutex_.unlock_shared();
+    // Earlier blocks enter pool first, so reversal helps avoid fragmentation.
+    // Blocks processed since the last call are dropped, each only once.
+    for (auto it = unprocessed_.rbegin(); it != unprocessed_.rend();)
+    {
+        if (it->second->processed())
+        {
+            it = sequence_map::reverse_iterator(
+                unprocessed_.erase(std::next(it).base()));
+            continue;
+        }
+
+        unprocessed.push_back(it->second);
+        ++it;
+    }
     ///////////////////////////////////////////////////////////////////////////
 
-    unprocessed.shrink_to_fit();
     return unprocessed;
 }
 
@@ -189,41 +207,7 @@ block_info::ptr orphan_pool::delete_pending_block(const hash_digest &needed_bloc
 
 bool orphan_pool::exists(const hash_digest &hash) const
 {
-    const auto match = [&hash](const block_info::ptr &entry) {
-        return hash == entry->hash();
-    };
-
-    return std::any_of(buffer_.begin(), buffer_.end(), match);
-}
-
-bool orphan_pool::exists(const chain::header &header) const
-{
-    const auto match = [&header](const block_info::ptr &entry) {
-        return header == entry->actual()->header;
-    };
-
-    return std::any_of(buffer_.begin(), buffer_.end(), match);
-}
-
-/*
-orphan_pool::const_iterator orphan_pool::find(buffer::const_iterator begin, const hash_digest& hash) const
-{
-    const auto match = [&hash](const block_info::ptr& entry)
-    {
-        return hash == entry->hash();
-    };
-
-    return std::find_if(begin, buffer_.end(), match);
-}
-*/
-
-orphan_pool::const_reverse_iterator orphan_pool::rfind(buffer::const_reverse_iterator begin, const hash_digest &hash) const
-{
-    const auto match = [&hash](const block_info::ptr &entry) {
-        return hash == entry->hash();
-    };
-
-    return std::find_if(begin, buffer_.rend(), match);
+    return blocks_.find(hash) != blocks_.end();
 }
 
 } // namespace blockchain
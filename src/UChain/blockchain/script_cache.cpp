@@ -0,0 +1,128 @@
+/**
+ * Copyright (c) 2018-2020 UChain core developers (check UC-AUTHORS)
+ *
+ * This file is part of UChain.
+ *
+ * UChain is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <UChain/blockchain/script_cache.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <UChain/coin.hpp>
+
+namespace libbitcoin
+{
+namespace blockchain
+{
+
+using namespace chain;
+
+// Only these flags change the outcome of an input script check. Mempool and
+// block validation pass different unrelated bits, which must not split keys.
+static constexpr uint32_t script_flags_mask =
+    script_context::bip16_enabled | script_context::bip65_enabled |
+    script_context::bip66_enabled | script_context::attenuation_enabled;
+
+script_cache::script_cache(size_t capacity)
+    : capacity_(capacity),
+      salt_(hash_size),
+      next_(0),
+      hits_(0),
+      misses_(0)
+{
+    pseudo_random_fill(salt_);
+    entries_.reserve(capacity_);
+}
+
+hash_digest script_cache::key(const hash_digest &tx_hash,
+                              uint32_t input_index, uint32_t flags) const
+{
+    data_chunk data;
+    data.reserve(salt_.size() + hash_size + 2 * sizeof(uint32_t));
+    extend_data(data, salt_);
+    extend_data(data, tx_hash);
+    extend_data(data, to_little_endian(input_index));
+    extend_data(data, to_little_endian(flags & script_flags_mask));
+    return sha256_hash(data);
+}
+
+bool script_cache::contains(const hash_digest &tx_hash, uint32_t input_index,
+                            uint32_t flags) const
+{
+    if (capacity_ == 0)
+        return false;
+
+    const auto entry = key(tx_hash, input_index, flags);
+
+    bool found;
+    {
+        shared_lock lock(mutex_);
+        found = entries_.find(entry) != entries_.end();
+    }
+
+    ++(found ? hits_ : misses_);
+    return found;
+}
+
+void script_cache::insert(const hash_digest &tx_hash, uint32_t input_index,
+                          uint32_t flags)
+{
+    if (capacity_ == 0)
+        return;
+
+    const auto entry = key(tx_hash, input_index, flags);
+
+    unique_lock lock(mutex_);
+    if (!entries_.insert(entry).second)
+        return;
+
+    if (order_.size() < capacity_)
+    {
+        order_.push_back(entry);
+        return;
+    }
+
+    entries_.erase(order_[next_]);
+    order_[next_] = entry;
+    next_ = (next_ + 1) % capacity_;
+}
+
+void script_cache::clear()
+{
+    unique_lock lock(mutex_);
+    entries_.clear();
+    order_.clear();
+    next_ = 0;
+}
+
+size_t script_cache::size() const
+{
+    shared_lock lock(mutex_);
+    return entries_.size();
+}
+
+uint64_t script_cache::hits() const
+{
+    return hits_;
+}
+
+uint64_t script_cache::misses() const
+{
+    return misses_;
+}
+
+} // namespace blockchain
+} // namespace libbitcoin
@@ -34,6 +34,7 @@ using namespace boost::filesystem;
 settings::settings()
     : block_pool_capacity(5000),
       tx_pool_capacity(4096),
+      script_cache_capacity(200000),
       tx_pool_consistency(false),
       use_testnet_rules(false)
 {
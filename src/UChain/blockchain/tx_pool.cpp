@@ -44,7 +44,7 @@ tx_pool::tx_pool(threadpool &pool, block_chain &chain,
                                    const settings &settings)
     : stopped_(true),
       maintain_consistency_(settings.tx_pool_consistency),
-      buffer_(settings.tx_pool_capacity),
+      capacity_(settings.tx_pool_capacity),
       dispatch_(pool, NAME),
       blockchain_(chain),
       index_(pool, chain),
@@ -158,6 +158,8 @@ void tx_pool::handle_validated(const code &ec, transaction_ptr tx,
     handler(error::success, tx, unconfirmed);
 }
 
+// Only the outputs of tx are walked, the pooled transactions are looked up
+// in the reservations maintained by add and erase.
 code tx_pool::check_symbol_repeat(transaction_ptr tx)
 {
     std::set<string> tokens;
@@ -167,121 +169,171 @@ code tx_pool::check_symbol_repeat(transaction_ptr tx)
     std::set<string> uidaddreses;
     std::set<string> uidattaches;
 
-    auto check_outputs = [&](transaction_ptr txs) -> code {
-        for (auto &output : txs->outputs)
+    const auto reserved = [](const reservation_map &pool,
+                             const std::set<string> &local, const string &key) {
+        return pool.count(key) != 0 || local.count(key) != 0;
+    };
+
+    for (auto &output : tx->outputs)
+    {
+        //add asset check;avoid send with uid while transfer
+        if (output.attach_data.get_version() == UID_ASSET_VERIFY_VERSION)
         {
-            //add asset check;avoid send with uid while transfer
-            if (output.attach_data.get_version() == UID_ASSET_VERIFY_VERSION)
-            {
-                auto check_uid = [&uids, &uidattaches](string attach_uid) {
-                    if (!attach_uid.empty() && uids.find(attach_uid) != uids.end())
-                    {
-                        log::debug(LOG_BLOCKCHAIN)
-                            << "check_symbol_repeat asset uid: " + attach_uid
-                            << " already exists in txpool!";
-                        return false;
-                    }
-
-                    uidattaches.insert(attach_uid);
+            auto check_uid = [&](string attach_uid) {
+                if (attach_uid.empty())
                     return true;
-                };
 
-                if (!check_uid(output.attach_data.get_from_uid()) || !check_uid(output.attach_data.get_to_uid()))
+                if (reserved(reserved_.uids, uids, attach_uid))
                 {
                     log::debug(LOG_BLOCKCHAIN)
-                        << "check_symbol_repeat from_uid " + output.attach_data.get_from_uid()
-                        << " to_uid " + output.attach_data.get_to_uid()
-                        << " check failed!"
-                        << " " << tx->to_string(1);
-                    return error::uid_exist;
+                        << "check_symbol_repeat asset uid: " + attach_uid
+                        << " already exists in txpool!";
+                    return false;
                 }
+
+                uidattaches.insert(attach_uid);
+                return true;
+            };
+
+            if (!check_uid(output.attach_data.get_from_uid()) || !check_uid(output.attach_data.get_to_uid()))
+            {
+                log::debug(LOG_BLOCKCHAIN)
+                    << "check_symbol_repeat from_uid " + output.attach_data.get_from_uid()
+                    << " to_uid " + output.attach_data.get_to_uid()
+                    << " check failed!"
+                    << " " << tx->to_string(1);
+                return error::uid_exist;
             }
+        }
 
-            if (output.is_token_issue())
+        if (output.is_token_issue())
+        {
+            const auto symbol = output.get_token_symbol();
+            if (reserved(reserved_.tokens, tokens, symbol))
             {
-                auto r = tokens.insert(output.get_token_symbol());
-                if (r.second == false)
-                {
-                    log::debug(LOG_BLOCKCHAIN)
-                        << "check_symbol_repeat token " + output.get_token_symbol()
-                        << " already exists in txpool!"
-                        << " " << tx->to_string(1);
-                    return error::token_exist;
-                }
+                log::debug(LOG_BLOCKCHAIN)
+                    << "check_symbol_repeat token " + symbol
+                    << " already exists in txpool!"
+                    << " " << tx->to_string(1);
+                return error::token_exist;
             }
-            else if (output.is_token_cert())
+
+            tokens.insert(symbol);
+        }
+        else if (output.is_token_cert())
+        {
+            auto &&key = output.get_token_cert().get_key();
+            if (reserved(reserved_.token_certs, token_certs, key))
             {
-                auto &&key = output.get_token_cert().get_key();
-                auto r = token_certs.insert(key);
-                if (r.second == false)
-                {
-                    log::debug(LOG_BLOCKCHAIN)
-                        << "check_symbol_repeat cert " + output.get_token_cert_symbol()
-                        << " with type " << output.get_token_cert_type()
-                        << " already exists in txpool!"
-                        << " " << tx->to_string(1);
-                    return error::token_cert_exist;
-                }
+                log::debug(LOG_BLOCKCHAIN)
+                    << "check_symbol_repeat cert " + output.get_token_cert_symbol()
+                    << " with type " << output.get_token_cert_type()
+                    << " already exists in txpool!"
+                    << " " << tx->to_string(1);
+                return error::token_cert_exist;
             }
-            else if (output.is_candidate())
+
+            token_certs.insert(key);
+        }
+        else if (output.is_candidate())
+        {
+            const auto symbol = output.get_token_symbol();
+            if (reserved(reserved_.candidates, candidates, symbol))
             {
-                auto r = candidates.insert(output.get_token_symbol());
-                if (r.second == false)
-                {
-                    log::debug(LOG_BLOCKCHAIN)
-                        << "check_symbol_repeat candidate " + output.get_token_symbol()
-                        << " already exists in txpool!"
-                        << " " << tx->to_string(1);
-                    return error::candidate_exist;
-                }
+                log::debug(LOG_BLOCKCHAIN)
+                    << "check_symbol_repeat candidate " + symbol
+                    << " already exists in txpool!"
+                    << " " << tx->to_string(1);
+                return error::candidate_exist;
             }
-            else if (output.is_uid())
+
+            candidates.insert(symbol);
+        }
+        else if (output.is_uid())
+        {
+            auto uidsymbol = output.get_uid_symbol();
+            if (reserved(reserved_.uids, uids, uidsymbol))
             {
-                auto uidsymbol = output.get_uid_symbol();
-                auto uidexist = uids.insert(uidsymbol);
-                if (uidexist.second == false)
-                {
-                    log::debug(LOG_BLOCKCHAIN)
-                        << "check_symbol_repeat uid " + uidsymbol
-                        << " already exists in txpool!"
-                        << " " << tx->to_string(1);
-                    return error::uid_exist;
-                }
+                log::debug(LOG_BLOCKCHAIN)
+                    << "check_symbol_repeat uid " + uidsymbol
+                    << " already exists in txpool!"
+                    << " " << tx->to_string(1);
+                return error::uid_exist;
+            }
 
-                auto uidaddress = uidaddreses.insert(output.get_uid_address());
-                if (uidaddress.second == false)
-                {
-                    log::debug(LOG_BLOCKCHAIN)
-                        << "check_symbol_repeat uid address " + output.get_uid_address()
-                        << " already has uid on it in txpool!"
-                        << " " << tx->to_string(1);
-                    return error::address_registered_uid;
-                }
+            uids.insert(uidsymbol);
 
-                if (uidattaches.find(uidsymbol) != uidattaches.end())
-                {
-                    log::debug(LOG_BLOCKCHAIN)
-                        << "check_symbol_repeat asset uid: " + uidsymbol
-                        << " already transfer in txpool!"
-                        << " " << tx->to_string(1);
-                    return error::uid_exist;
-                }
+            const auto uidaddress = output.get_uid_address();
+            if (reserved(reserved_.uid_addresses, uidaddreses, uidaddress))
+            {
+                log::debug(LOG_BLOCKCHAIN)
+                    << "check_symbol_repeat uid address " + uidaddress
+                    << " already has uid on it in txpool!"
+                    << " " << tx->to_string(1);
+                return error::address_registered_uid;
+            }
+
+            uidaddreses.insert(uidaddress);
+
+            if (reserved(reserved_.uid_attaches, uidattaches, uidsymbol))
+            {
+                log::debug(LOG_BLOCKCHAIN)
+                    << "check_symbol_repeat asset uid: " + uidsymbol
+                    << " already transfer in txpool!"
+                    << " " << tx->to_string(1);
+                return error::uid_exist;
             }
         }
-        return error::success;
+    }
+
+    return error::success;
+}
+
+// Count the symbols claimed by a pooled tx, delta is 1 on add, -1 on erase.
+void tx_pool::reserve_symbols(const transaction &tx, int delta)
+{
+    const auto update = [delta](reservation_map &map, const string &key) {
+        if (delta > 0)
+        {
+            ++map[key];
+            return;
+        }
+
+        const auto it = map.find(key);
+        if (it != map.end() && --it->second == 0)
+            map.erase(it);
     };
 
-    code ec;
-    for (auto &item : buffer_)
+    for (const auto &output : tx.outputs)
     {
-        if (!item.tx)
-            continue;
+        if (output.attach_data.get_version() == UID_ASSET_VERIFY_VERSION)
+        {
+            const auto from_uid = output.attach_data.get_from_uid();
+            const auto to_uid = output.attach_data.get_to_uid();
+            if (!from_uid.empty())
+                update(reserved_.uid_attaches, from_uid);
+            if (!to_uid.empty())
+                update(reserved_.uid_attaches, to_uid);
+        }
 
-        if ((ec = check_outputs(item.tx)) != error::success)
-            break;
+        if (output.is_token_issue())
+        {
+            update(reserved_.tokens, output.get_token_symbol());
+        }
+        else if (output.is_token_cert())
+        {
+            update(reserved_.token_certs, output.get_token_cert().get_key());
+        }
+        else if (output.is_candidate())
+        {
+            update(reserved_.candidates, output.get_token_symbol());
+        }
+        else if (output.is_uid())
+        {
+            update(reserved_.uids, output.get_uid_symbol());
+            update(reserved_.uid_addresses, output.get_uid_address());
+        }
     }
-
-    return ec != error::success ? ec : check_outputs(tx);
 }
 
 // handle_confirm will never fire if handle_validate returns a failure code.
@@ -322,7 +374,12 @@ void tx_pool::do_store(const code &ec, transaction_ptr tx,
     };
 
     // Add to pool, save confirmation handler.
-    add(tx, do_deindex);
+    const auto added = add(tx, do_deindex);
+    if (added)
+    {
+        handle_validate(added, tx, {});
+        return;
+    }
 
     const auto handle_indexed = [this, handle_validate, tx, unconfirmed](
                                     const code ec) {
@@ -336,6 +393,9 @@ void tx_pool::do_store(const code &ec, transaction_ptr tx,
         handle_validate(ec, tx, unconfirmed);
     };
 
+    // Decode the scripts once for the subscribers, the index decodes its copy.
+    tx->decoded();
+
     // Add to index and invoke handler to indicate validation and indexing.
     index_.add(*tx, handle_indexed);
 }
@@ -370,14 +430,11 @@ void tx_pool::delete_tx(const hash_digest &tx_hash)
 
     log::debug(LOG_BLOCKCHAIN) << " delete_tx hash:" << libbitcoin::encode_hash(tx_hash);
     const auto tx_delete = [this, tx_hash]() {
-        for (auto item = buffer_.begin(); item != buffer_.end(); ++item)
+        const auto it = entries_.find(tx_hash);
+        if (it != entries_.end())
         {
-            if (item->tx->hash() == tx_hash)
-            {
-                log::debug(LOG_BLOCKCHAIN) << " delete_tx hash:" << libbitcoin::encode_hash(tx_hash) << " success";
-                buffer_.erase(item);
-                break;
-            }
+            log::debug(LOG_BLOCKCHAIN) << " delete_tx hash:" << libbitcoin::encode_hash(tx_hash) << " success";
+            erase(it->second);
         }
     };
 
@@ -413,7 +470,6 @@ void tx_pool::fetch_history(const payment_address &address,
     index_.fetch_all_history(address, limit, from_height, handler);
 }
 
-// TODO: use hash table pool to eliminate this O(n^2) search.
 void tx_pool::filter(get_data_ptr message, result_handler handler)
 {
     if (stopped())
@@ -517,13 +573,40 @@ void tx_pool::notify_transaction(const point::indexes &unconfirmed,
 // ----------------------------------------------------------------------------
 
 // A new transaction has been received, add it to the memory pool.
-void tx_pool::add(transaction_ptr tx, confirm_handler handler)
+// Returns false if the pool can not hold it or it is already pooled.
+// A disabled (zero capacity) pool rejects the tx as filled, not duplicate.
+code tx_pool::add(transaction_ptr tx, confirm_handler handler)
 {
+    if (capacity_ == 0)
+        return error::pool_filled;
+
+    const auto tx_hash = tx->hash();
+    if (entries_.count(tx_hash) != 0)
+        return error::duplicate;
+
     // When a new tx is added to the buffer drop the oldest.
-    if (maintain_consistency_ && buffer_.size() == buffer_.capacity())
-        delete_package(error::pool_filled);
+    if (buffer_.size() >= capacity_)
+    {
+        if (maintain_consistency_)
+            delete_package(error::pool_filled);
+        else
+            delete_single(buffer_.front().tx->hash(), error::pool_filled);
+    }
+
+    const auto it = buffer_.insert(buffer_.end(), {tx, handler});
+    entries_.emplace(tx_hash, it);
 
-    buffer_.push_back({tx, handler});
+    for (const auto &input : tx->inputs)
+    {
+        const auto &previous = input.previous_output;
+        spent_[previous] = tx_hash;
+
+        if (entries_.count(previous.hash) != 0)
+            children_.emplace(previous.hash, tx_hash);
+    }
+
+    reserve_symbols(*tx, 1);
+    return error::success;
 }
 
 // There has been a reorg, clear the memory pool using the given reason code.
@@ -533,6 +616,10 @@ void tx_pool::clear(const code &ec)
         entry.handle_confirm(ec, entry.tx);
 
     buffer_.clear();
+    entries_.clear();
+    spent_.clear();
+    children_.clear();
+    reserved_ = reservations();
 }
 
 // Delete memory pool txs that are obsoleted by a new block acceptance.
@@ -573,46 +660,37 @@ void tx_pool::delete_spent_in_blocks(const block_list &blocks)
                                     error::double_spend);
 }
 
-// Delete any tx that spends any output of this tx.
+// Delete the tx that spends this output.
 void tx_pool::delete_dependencies(const output_point &point,
-                                           const code &ec)
+                                  const code &ec)
 {
-    const auto comparitor = [&point](const input &input) {
-        return input.previous_output == point;
-    };
+    const auto it = spent_.find(point);
+    if (it == spent_.end())
+        return;
 
-    delete_dependencies(comparitor, ec);
+    // Copy the hash, the spender is going to be unindexed.
+    const auto spender = it->second;
+    const auto entry = entries_.find(spender);
+    if (entry != entries_.end())
+        delete_package(entry->second->tx, ec);
 }
 
 // Delete any tx that spends any output of this tx.
 void tx_pool::delete_dependencies(const hash_digest &tx_hash,
-                                           const code &ec)
-{
-    const auto comparitor = [&tx_hash](const input &input) {
-        return input.previous_output.hash == tx_hash;
-    };
-
-    delete_dependencies(comparitor, ec);
-}
-
-// This is horribly inefficient, but it's simple.
-// TODO: Create persistent multi-indexed memory pool (including age and
-// children) and perform this pruning trivialy (and add policy over it).
-void tx_pool::delete_dependencies(input_compare is_dependency,
-                                           const code &ec)
+                                  const code &ec)
 {
-    std::vector<entry> dependencies;
-    for (const auto &entry : buffer_)
-        for (const auto &input : entry.tx->inputs)
-            if (is_dependency(input))
-            {
-                dependencies.push_back(entry);
-                break;
-            }
+    // Copy the children, each unlinks itself from the parent when deleted.
+    std::vector<hash_digest> dependencies;
+    const auto range = children_.equal_range(tx_hash);
+    for (auto it = range.first; it != range.second; ++it)
+        dependencies.push_back(it->second);
 
-    // We queue deletion to protect the iterator.
     for (const auto &dependency : dependencies)
-        delete_package(dependency.tx, ec);
+    {
+        const auto entry = entries_.find(dependency);
+        if (entry != entries_.end())
+            delete_package(entry->second->tx, ec);
+    }
 }
 
 void tx_pool::delete_package(const code &ec)
@@ -638,30 +716,44 @@ bool tx_pool::delete_single(const hash_digest &tx_hash, const code &ec)
     if (stopped())
         return false;
 
-    const auto matched = [&tx_hash](const entry &entry) {
-        return entry.tx->hash() == tx_hash;
-    };
-
-    const auto it = std::find_if(buffer_.begin(), buffer_.end(), matched);
-
-    if (it == buffer_.end())
+    const auto it = entries_.find(tx_hash);
+    if (it == entries_.end())
         return false;
 
-    it->handle_confirm(ec, it->tx);
-    buffer_.erase(it);
+    // Must copy the entry because it is going to be deleted from the list.
+    const auto entry = *it->second;
+    erase(it->second);
+    entry.handle_confirm(ec, entry.tx);
+    return true;
+}
 
-    while (1)
-    {
-        const auto it = std::find_if(buffer_.begin(), buffer_.end(), matched);
+// The children of the erased tx stay linked to it, so that delete_package
+// can still find them as dependencies.
+void tx_pool::erase(buffer::iterator it)
+{
+    const auto tx = it->tx;
+    const auto tx_hash = tx->hash();
 
-        if (it == buffer_.end())
-            break;
+    for (const auto &input : tx->inputs)
+    {
+        const auto &previous = input.previous_output;
+        const auto spent = spent_.find(previous);
+        if (spent != spent_.end() && spent->second == tx_hash)
+            spent_.erase(spent);
 
-        it->handle_confirm(ec, it->tx);
-        buffer_.erase(it);
+        const auto range = children_.equal_range(previous.hash);
+        for (auto child = range.first; child != range.second;)
+        {
+            if (child->second == tx_hash)
+                child = children_.erase(child);
+            else
+                ++child;
+        }
     }
 
-    return true;
+    reserve_symbols(*tx, -1);
+    entries_.erase(tx_hash);
+    buffer_.erase(it);
 }
 
 bool tx_pool::find(transaction_ptr &out_tx,
@@ -694,16 +786,16 @@ bool tx_pool::find(chain::transaction &out_tx,
 tx_pool::const_iterator tx_pool::find(
     const hash_digest &tx_hash) const
 {
-    const auto found = [&tx_hash](const entry &entry) {
-        return entry.tx->hash() == tx_hash;
-    };
+    const auto it = entries_.find(tx_hash);
+    if (it == entries_.end())
+        return buffer_.end();
 
-    return std::find_if(buffer_.begin(), buffer_.end(), found);
+    return it->second;
 }
 
 bool tx_pool::is_in_pool(const hash_digest &tx_hash) const
 {
-    return find(tx_hash) != buffer_.end();
+    return entries_.count(tx_hash) != 0;
 }
 
 bool tx_pool::is_spent_in_pool(transaction_ptr tx) const
@@ -723,11 +815,7 @@ bool tx_pool::is_spent_in_pool(const transaction &tx) const
 
 bool tx_pool::is_spent_in_pool(const output_point &outpoint) const
 {
-    const auto found = [&outpoint](const entry &entry) {
-        return is_spent_by_tx(outpoint, entry.tx);
-    };
-
-    return std::any_of(buffer_.begin(), buffer_.end(), found);
+    return spent_.count(outpoint) != 0;
 }
 
 bool tx_pool::is_spent_by_tx(const output_point &outpoint,
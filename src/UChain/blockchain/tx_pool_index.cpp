@@ -108,37 +108,31 @@ void tx_pool_index::add(const transaction &tx,
 void tx_pool_index::do_add(const transaction &tx,
                                     completion_handler handler)
 {
-    uint32_t index = 0;
     const auto tx_hash = tx.hash();
+    const auto decoded = tx.decoded();
 
-    for (const auto &input : tx.inputs)
+    for (uint32_t index = 0; index < tx.inputs.size(); ++index)
     {
-        const auto address = payment_address::extract(input.script);
+        const auto &address = decoded->inputs[index].address;
 
         if (address)
         {
             const input_point point{tx_hash, index};
-            const spend_info info{point, input.previous_output};
-            spends_map_.emplace(std::move(address), std::move(info));
+            const spend_info info{point, tx.inputs[index].previous_output};
+            spends_map_.emplace(address, std::move(info));
         }
-
-        ++index;
     }
 
-    index = 0;
-
-    for (const auto &output : tx.outputs)
+    for (uint32_t index = 0; index < tx.outputs.size(); ++index)
     {
-        const auto address = payment_address::extract(output.script);
+        const auto &address = decoded->outputs[index].address;
 
         if (address)
         {
             const output_point point{tx_hash, index};
-            const output_info info{point, output.value};
-            outputs_map_.emplace(std::move(address), std::move(info));
+            const output_info info{point, tx.outputs[index].value};
+            outputs_map_.emplace(address, std::move(info));
         }
-
-        ++index;
     }
 
     // This is the end of the add sequence.
@@ -159,29 +153,23 @@ void tx_pool_index::remove(const transaction &tx,
 void tx_pool_index::do_remove(const transaction &tx,
                                        completion_handler handler)
 {
-    uint32_t index = 0;
     const auto tx_hash = tx.hash();
+    const auto decoded = tx.decoded();
 
-    for (const auto &input : tx.inputs)
+    for (uint32_t index = 0; index < tx.inputs.size(); ++index)
     {
-        const auto address = payment_address::extract(input.script);
+        const auto &address = decoded->inputs[index].address;
 
         if (address)
             erase(address, input_point{tx_hash, index}, spends_map_);
-
-        ++index;
     }
 
-    index = 0;
-
-    for (const auto &output : tx.outputs)
+    for (uint32_t index = 0; index < tx.outputs.size(); ++index)
     {
-        const auto address = payment_address::extract(output.script);
+        const auto &address = decoded->outputs[index].address;
 
         if (address)
             erase(address, output_point{tx_hash, index}, outputs_map_);
-
-        ++index;
     }
 
     // This is the end of the remove sequence.
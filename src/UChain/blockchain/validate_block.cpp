@@ -22,10 +22,15 @@
 
 #include <set>
 #include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <cstddef>
 #include <cstdint>
+#include <memory>
+#include <mutex>
 #include <system_error>
+#include <thread>
 #include <vector>
 #include <UChain/coin.hpp>
 #include <UChain/blockchain/block.hpp>
@@ -90,6 +95,9 @@ static constexpr uint64_t target_timespan_seconds = 2 * 7 * 24 * 60 * 60;
 static constexpr uint64_t retargeting_interval = target_timespan_seconds /
                                                  target_spacing_seconds;
 
+// Blocks with fewer input scripts than this are verified on the caller thread.
+static constexpr size_t minimum_parallel_scripts = 16;
+
 // The window by which a time stamp may exceed our current time (2 hours).
 //static const auto time_stamp_window = asio::seconds(2 * 60 * 60);
 static const auto time_stamp_window = asio::seconds(time_stamp_window_senconds);
@@ -97,14 +105,17 @@ static const auto time_stamp_window = asio::seconds(time_stamp_window_senconds);
 
 // The nullptr option is for backward compatibility only.
 validate_block::validate_block(size_t height, const block &block, bool testnet,
-                               const config::checkpoint::list &checks, stopped_callback callback)
+                               const config::checkpoint::list &checks, stopped_callback callback,
+                               threadpool *pool)
     : testnet_(testnet),
       height_(height),
       activations_(script_context::none_enabled),
       minimum_version_(0),
       current_block_(block),
       checkpoints_(checks),
-      stop_callback_(callback)
+      stop_callback_(callback),
+      pool_(pool),
+      script_threads_(0)
 {
 }
 
@@ -205,6 +216,11 @@ bool validate_block::stopped() const
     return stop_callback_();
 }
 
+size_t validate_block::script_threads() const
+{
+    return script_threads_;
+}
+
 code validate_block::check_block(blockchain::block_chain_impl &chain) const
 {
     // These are checks that are independent of the blockchain
@@ -594,7 +610,9 @@ code validate_block::connect_block(hash_digest &err_tx, blockchain::block_chain_
     size_t coinage_reward_coinbase_index = 1;
     size_t get_coinage_reward_tx_count = 0;
 
-    ////////////// TODO: parallelize. //////////////
+    // Fees and coinage rewards are tallied here in block order, the input
+    // scripts are collected and verified in parallel below.
+    script_checks checks;
     for (size_t tx_index = 0; tx_index < count; ++tx_index)
     {
         uint64_t value_in = 0;
@@ -635,7 +653,7 @@ code validate_block::connect_block(hash_digest &err_tx, blockchain::block_chain_
         RETURN_IF_STOPPED();
 
         // Consensus checks here.
-        if (!validate_inputs(tx, tx_index, value_in, total_sigops))
+        if (!validate_inputs(tx, tx_index, value_in, total_sigops, checks))
         {
             log::debug(LOG_BLOCKCHAIN) << "validate inputs of block failed. tx hash:"
                                        << encode_hash(tx.hash());
@@ -659,6 +677,21 @@ code validate_block::connect_block(hash_digest &err_tx, blockchain::block_chain_
 
     RETURN_IF_STOPPED();
 
+    const auto failed = verify_scripts(checks, &chain.get_script_cache());
+
+    RETURN_IF_STOPPED();
+
+    if (failed != checks.size())
+    {
+        const auto &check = checks[failed];
+        const auto &tx = transactions[check.tx_index];
+        log::warning(LOG_BLOCKCHAIN) << "Input script invalid consensus ["
+                                     << encode_hash(tx.hash()) << ":"
+                                     << check.input_index << "]";
+        err_tx = tx.hash();
+        return error::validate_inputs_failed;
+    }
+
     const auto &coinbase = transactions.front();
     const auto reward = coinbase.total_output_value();
     const auto value = consensus::miner::calculate_block_subsidy(height_, testnet_) + fees;
@@ -686,14 +719,14 @@ bool validate_block::is_spent_duplicate(const transaction &tx) const
 }
 
 bool validate_block::validate_inputs(const transaction &tx,
-                                     size_t index_in_parent, uint64_t &value_in, size_t &total_sigops) const
+                                     size_t index_in_parent, uint64_t &value_in, size_t &total_sigops,
+                                     script_checks &checks) const
 {
     //BITCOIN_ASSERT(!tx.is_coinbase());
 
-    ////////////// TODO: parallelize. //////////////
     for (size_t input_index = 0; input_index < tx.inputs.size(); ++input_index)
         if (!connect_input(index_in_parent, tx, input_index, value_in,
-                           total_sigops))
+                           total_sigops, checks))
         {
             log::warning(LOG_BLOCKCHAIN) << "Invalid input ["
                                          << encode_hash(tx.hash()) << ":"
@@ -736,19 +769,21 @@ bool validate_block::get_transaction(const hash_digest &tx_hash,
 
 bool validate_block::connect_input(size_t index_in_parent,
                                    const transaction &current_tx, size_t input_index, uint64_t &value_in,
-                                   size_t &total_sigops) const
+                                   size_t &total_sigops, script_checks &checks) const
 {
     BITCOIN_ASSERT(input_index < current_tx.inputs.size());
 
     // Lookup previous output
     size_t previous_height;
-    transaction previous_tx;
+    bool previous_coinbase;
+    chain::output previous_tx_out;
     const auto &input = current_tx.inputs[input_index];
     const auto &previous_output = input.previous_output;
 
-    // This searches the blockchain and then the orphan pool up to and
-    // including the current (orphan) block and excluding blocks above fork.
-    if (!fetch_transaction(previous_tx, previous_height, previous_output.hash))
+    // This searches the utxo store, then the blockchain and the orphan pool up
+    // to and including the current (orphan) block and excluding blocks above fork.
+    if (!fetch_unspent_output(previous_tx_out, previous_height,
+                              previous_coinbase, previous_output))
     {
         log::warning(LOG_BLOCKCHAIN)
             << "Failure fetching input transaction ["
@@ -756,8 +791,6 @@ bool validate_block::connect_input(size_t index_in_parent,
         return false;
     }
 
-    const auto &previous_tx_out = previous_tx.outputs[previous_output.index];
-
     // Signature operations count if script_hash payment type.
     size_t count;
     if (!script_hash_signature_operations_count(count,
@@ -783,7 +816,7 @@ bool validate_block::connect_input(size_t index_in_parent,
     }
 
     // Check coinbase maturity has been reached
-    if (previous_tx.is_coinbase())
+    if (previous_coinbase)
     {
         BITCOIN_ASSERT(previous_height <= height_);
         const auto height_difference = height_ - previous_height;
@@ -794,12 +827,8 @@ bool validate_block::connect_input(size_t index_in_parent,
         }
     }
 
-    if (!validate_tx_engine::check_consensus(previous_tx_out.script,
-                                               current_tx, input_index, activations_))
-    {
-        log::warning(LOG_BLOCKCHAIN) << "Input script invalid consensus.";
-        return false;
-    }
+    // The script is verified by verify_scripts once all inputs are connected.
+    checks.push_back({index_in_parent, input_index, previous_tx_out.script});
 
     // Search for double spends.
     if (is_output_spent(previous_output, index_in_parent, input_index))
@@ -819,6 +848,105 @@ bool validate_block::connect_input(size_t index_in_parent,
     return true;
 }
 
+// Workers claim checks in index order, so every check below the first failure
+// has been run when the stage completes and the reported failure does not
+// depend on thread scheduling. Checks above a known failure are skipped.
+size_t validate_block::verify_scripts(const script_checks &checks,
+                                      script_cache *cache) const
+{
+    // Each transaction is serialized once, by the first worker to need it.
+    struct prepared
+    {
+        std::once_flag once;
+        std::shared_ptr<const validate_tx_engine::verify_context> context;
+    };
+
+    struct stage
+    {
+        explicit stage(size_t transactions)
+          : contexts(transactions)
+        {
+        }
+
+        std::vector<prepared> contexts;
+        std::atomic<size_t> next;
+        std::atomic<size_t> failed;
+        std::atomic<size_t> threads;
+        size_t done;
+        std::mutex mutex;
+        std::condition_variable finished;
+    };
+
+    const auto &transactions = current_block_.transactions;
+    const auto count = checks.size();
+    const auto state = std::make_shared<stage>(transactions.size());
+    state->next = 0;
+    state->failed = count;
+    state->threads = 0;
+    state->done = 0;
+
+    const auto flags = activations_;
+    const auto stop = stop_callback_;
+
+    // Helpers may start after the stage completed, they then claim nothing.
+    const auto work = [state, &checks, &transactions, flags, stop, count, cache]() {
+        size_t index;
+        auto counted = false;
+        while ((index = state->next++) < count)
+        {
+            if (!counted)
+            {
+                ++state->threads;
+                counted = true;
+            }
+
+            const auto &check = checks[index];
+            const auto input32 = static_cast<uint32_t>(check.input_index);
+            if (index < state->failed && !stop() && !(cache != nullptr &&
+                cache->contains(transactions[check.tx_index].hash(), input32, flags)))
+            {
+                auto &slot = state->contexts[check.tx_index];
+                std::call_once(slot.once, [&slot, &transactions, &check]() {
+                    slot.context = std::make_shared<const validate_tx_engine::verify_context>(
+                        transactions[check.tx_index]);
+                });
+
+                if (!validate_tx_engine::check_consensus(check.previous_script,
+                                                         *slot.context, check.input_index, flags))
+                {
+                    auto failed = state->failed.load();
+                    while (index < failed &&
+                           !state->failed.compare_exchange_weak(failed, index))
+                        ;
+                }
+            }
+
+            std::lock_guard<std::mutex> lock(state->mutex);
+            if (++state->done == count)
+                state->finished.notify_all();
+        }
+    };
+
+    if (pool_ != nullptr && count >= minimum_parallel_scripts)
+    {
+        const auto cores = std::max(std::thread::hardware_concurrency(), 1u);
+        const auto helpers = std::min<size_t>(cores, count) - 1;
+        for (size_t helper = 0; helper < helpers; ++helper)
+            pool_->service().post(work);
+    }
+
+    // The caller works too, so this completes even if the pool is busy.
+    work();
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->finished.wait(lock, [state, count]() {
+        return state->done == count;
+    });
+
+    script_threads_ = state->threads;
+    return state->failed;
+}
+
 #undef RETURN_IF_STOPPED
 
 } // namespace blockchain
@@ -40,8 +40,8 @@ validate_block_impl::validate_block_impl(simple_chain &chain,
                                          size_t fork_index, const block_info::list &orphan_chain,
                                          size_t orphan_index, size_t height, const chain::block &block,
                                          bool testnet, const config::checkpoint::list &checks,
-                                         stopped_callback stopped)
-    : validate_block(height, block, testnet, checks, stopped),
+                                         stopped_callback stopped, threadpool *pool)
+    : validate_block(height, block, testnet, checks, stopped, pool),
       chain_(chain),
       height_(height),
       fork_index_(fork_index),
@@ -177,6 +177,31 @@ bool validate_block_impl::fetch_transaction(chain::transaction &tx,
     return true;
 }
 
+bool validate_block_impl::fetch_unspent_output(chain::output &output,
+                                                size_t &output_height, bool &coinbase,
+                                                const chain::output_point &outpoint) const
+{
+    uint64_t out_height;
+
+    // The utxo store reflects the main chain, only outputs at or below the
+    // fork point are also unspent outputs of the orphan chain.
+    if (chain_.get_unspent_output(output, out_height, coinbase, outpoint) &&
+        !tx_after_fork(static_cast<size_t>(out_height), fork_index_))
+    {
+        output_height = static_cast<size_t>(out_height);
+        return true;
+    }
+
+    transaction tx;
+    if (!fetch_transaction(tx, output_height, outpoint.hash) ||
+        outpoint.index >= tx.outputs.size())
+        return false;
+
+    output = tx.outputs[outpoint.index];
+    coinbase = tx.is_coinbase();
+    return true;
+}
+
 bool validate_block_impl::fetch_orphan_transaction(chain::transaction &tx,
                                                    size_t &tx_height, const hash_digest &tx_hash) const
 {
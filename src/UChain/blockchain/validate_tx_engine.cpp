@@ -158,6 +158,7 @@ void validate_tx_engine::reset(size_t last_height)
     // Used for checking coinbase maturity
     last_block_height_ = last_height;
     current_input_ = 0;
+    verify_context_.reset();
     value_in_ = 0;
     token_amount_in_ = 0;
     token_certs_in_.clear();
@@ -1702,10 +1703,28 @@ code validate_tx_engine::check_transaction_basic() const
     return error::success;
 }
 
+validate_tx_engine::verify_context::verify_context(const transaction &tx)
+    : tx(tx)
+{
+#ifdef WITH_CONSENSUS
+    const auto data = tx.to_data();
+    prepared = consensus::create_transaction_context(data.data(), data.size());
+#endif
+}
+
 // Validate script consensus conformance based on flags provided.
 bool validate_tx_engine::check_consensus(const script &prevout_script,
                                            const transaction &current_tx, size_t input_index, uint32_t flags)
 {
+    const verify_context context(current_tx);
+    return check_consensus(prevout_script, context, input_index, flags);
+}
+
+// The context is read only here, so one may be shared by concurrent checks.
+bool validate_tx_engine::check_consensus(const script &prevout_script,
+                                           const verify_context &context, size_t input_index, uint32_t flags)
+{
+    const auto &current_tx = context.tx;
     BITCOIN_ASSERT(input_index <= max_uint32);
     BITCOIN_ASSERT(input_index < current_tx.inputs.size());
     const auto input_index32 = static_cast<uint32_t>(input_index);
@@ -1713,7 +1732,6 @@ bool validate_tx_engine::check_consensus(const script &prevout_script,
 #ifdef WITH_CONSENSUS
     using namespace bc::consensus;
     const auto previous_output_script = prevout_script.to_data(false);
-    data_chunk current_transaction = current_tx.to_data();
 
     // Convert native flags to libbitcoin-consensus flags.
     uint32_t consensus_flags = verify_flags_none;
@@ -1730,9 +1748,10 @@ bool validate_tx_engine::check_consensus(const script &prevout_script,
     if ((flags & script_context::attenuation_enabled) != 0)
         consensus_flags |= verify_flags_checkattenuationverify;
 
-    const auto result = verify_script(current_transaction.data(),
-                                      current_transaction.size(), previous_output_script.data(),
-                                      previous_output_script.size(), input_index32, consensus_flags);
+    BITCOIN_ASSERT(context.prepared);
+    const auto result = verify_script(*context.prepared,
+                                      previous_output_script.data(), previous_output_script.size(),
+                                      input_index32, consensus_flags);
 
     const auto valid = (result == verify_result::verify_result_eval_true);
 #else
@@ -1823,12 +1842,21 @@ bool validate_tx_engine::connect_input(const transaction &previous_tx, size_t pa
         }
     }*/
 
-    if (!check_consensus(previous_output.script, *tx_, current_input_, script_context::all_enabled))
+    // The tx is serialized once and reused for each of its inputs.
+    if (!verify_context_)
+        verify_context_.reset(new verify_context(*tx_));
+
+    if (!check_consensus(previous_output.script, *verify_context_, current_input_, script_context::all_enabled))
     {
         log::debug(LOG_BLOCKCHAIN) << "check_consensus failed";
         return false;
     }
 
+    // Spare block validation the script check once this tx is mined.
+    if (pool_ != nullptr)
+        blockchain_.get_script_cache().insert(tx_hash_, current_input_,
+                                              script_context::all_enabled);
+
     value_in_ += output_value;
 
     //for block token amount +1
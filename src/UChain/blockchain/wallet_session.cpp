@@ -0,0 +1,252 @@
+/**
+ * Copyright (c) 2018-2020 UChain core developers (check UC-AUTHORS)
+ *
+ * This file is part of UChain.
+ *
+ * UChain is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <UChain/blockchain/wallet_session.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace libbitcoin
+{
+namespace blockchain
+{
+
+namespace
+{
+
+void wipe(void *buffer, std::size_t size)
+{
+    volatile auto *bytes = static_cast<volatile uint8_t *>(buffer);
+    while (size-- > 0)
+        *bytes++ = 0;
+}
+
+std::size_t page_size()
+{
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwPageSize;
+#else
+    return static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+#endif
+}
+
+// Hands out whole pages so that unlocking one buffer never unlocks a page
+// shared with another. Locking is best effort, the process may not be
+// permitted to pin memory, but the contents are always wiped on release.
+template <typename Type>
+struct locked_allocator
+{
+    typedef Type value_type;
+
+    locked_allocator() = default;
+
+    template <typename Other>
+    locked_allocator(const locked_allocator<Other> &)
+    {
+    }
+
+    Type *allocate(std::size_t count)
+    {
+        const auto size = round_up(count * sizeof(Type));
+#ifdef _WIN32
+        auto buffer = VirtualAlloc(nullptr, size, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+        if (buffer == nullptr)
+            throw std::bad_alloc();
+
+        VirtualLock(buffer, size);
+#else
+        auto buffer = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (buffer == MAP_FAILED)
+            throw std::bad_alloc();
+
+        mlock(buffer, size);
+#endif
+        return static_cast<Type *>(buffer);
+    }
+
+    void deallocate(Type *buffer, std::size_t count)
+    {
+        const auto size = round_up(count * sizeof(Type));
+        wipe(buffer, size);
+#ifdef _WIN32
+        VirtualUnlock(buffer, size);
+        VirtualFree(buffer, 0, MEM_RELEASE);
+#else
+        munlock(buffer, size);
+        munmap(buffer, size);
+#endif
+    }
+
+    static std::size_t round_up(std::size_t size)
+    {
+        static const auto page = page_size();
+        return size == 0 ? page : (size + page - 1) / page * page;
+    }
+};
+
+template <typename Left, typename Right>
+bool operator==(const locked_allocator<Left> &, const locked_allocator<Right> &)
+{
+    return true;
+}
+
+template <typename Left, typename Right>
+bool operator!=(const locked_allocator<Left> &, const locked_allocator<Right> &)
+{
+    return false;
+}
+
+} // namespace
+
+// All keys of the wallet share one locked buffer, the index only holds
+// the address and the position of its key.
+struct wallet_keyring::material
+{
+    std::vector<char, locked_allocator<char>> buffer;
+    std::map<std::string, std::pair<std::size_t, std::size_t>> index;
+};
+
+wallet_keyring::wallet_keyring(const hash_digest &passwd_hash, uint32_t expiry)
+    : passwd_hash_(passwd_hash), expiry_(expiry), material_(new material)
+{
+}
+
+wallet_keyring::~wallet_keyring()
+{
+}
+
+void wallet_keyring::store(const std::string &address, const std::string &prv_key)
+{
+    auto &buffer = material_->buffer;
+    const auto offset = buffer.size();
+    buffer.insert(buffer.end(), prv_key.begin(), prv_key.end());
+    material_->index[address] = std::make_pair(offset, prv_key.size());
+}
+
+bool wallet_keyring::find(const std::string &address, const key_handler &handler) const
+{
+    const auto it = material_->index.find(address);
+    if (it == material_->index.end())
+        return false;
+
+    handler(material_->buffer.data() + it->second.first, it->second.second);
+    return true;
+}
+
+bool wallet_keyring::matches(const hash_digest &passwd_hash) const
+{
+    return passwd_hash_ == passwd_hash;
+}
+
+bool wallet_keyring::expired(uint32_t now) const
+{
+    return now >= expiry_;
+}
+
+wallet_session::wallet_session()
+{
+}
+
+wallet_session::~wallet_session()
+{
+}
+
+wallet_session *wallet_session::get_instance()
+{
+    static wallet_session instance;
+    return &instance;
+}
+
+uint32_t wallet_session::now()
+{
+    return std::chrono::duration_cast<std::chrono::seconds>(
+               std::chrono::system_clock::now().time_since_epoch())
+        .count();
+}
+
+void wallet_session::unlock(const std::string &wallet_name, std::shared_ptr<wallet_keyring> keyring)
+{
+    unique_lock lock(mutex_);
+    erase_expired(now());
+    sessions_[wallet_name] = keyring;
+}
+
+void wallet_session::lock(const std::string &wallet_name)
+{
+    unique_lock lock(mutex_);
+    erase_expired(now());
+    sessions_.erase(wallet_name);
+}
+
+void wallet_session::sweep()
+{
+    unique_lock lock(mutex_);
+    erase_expired(now());
+}
+
+void wallet_session::erase_expired(uint32_t now)
+{
+    for (auto it = sessions_.begin(); it != sessions_.end();)
+    {
+        if (it->second->expired(now))
+            it = sessions_.erase(it);
+        else
+            ++it;
+    }
+}
+
+wallet_keyring::ptr wallet_session::get(const std::string &wallet_name, const hash_digest &passwd_hash)
+{
+    wallet_keyring::ptr keyring;
+    {
+        shared_lock lock(mutex_);
+        const auto it = sessions_.find(wallet_name);
+        if (it == sessions_.end())
+            return nullptr;
+
+        keyring = it->second;
+    }
+
+    if (keyring->expired(now()))
+    {
+        unique_lock lock(mutex_);
+        const auto it = sessions_.find(wallet_name);
+        if (it != sessions_.end() && it->second == keyring)
+            sessions_.erase(it);
+
+        return nullptr;
+    }
+
+    return keyring->matches(passwd_hash) ? keyring : nullptr;
+}
+
+} // namespace blockchain
+} // namespace libbitcoin
@@ -192,31 +192,8 @@ hash_digest build_merkle_tree(hash_list &merkle)
         // List size is now even.
         BITCOIN_ASSERT(merkle.size() % 2 == 0);
 
-        // New hash list.
-        hash_list new_merkle;
-
-        // Loop through hashes 2 at a time.
-        for (auto it = merkle.begin(); it != merkle.end(); it += 2)
-        {
-            // Join both current hashes together (concatenate).
-            data_chunk concat_data;
-            data_sink concat_stream(concat_data);
-            ostream_writer concat_sink(concat_stream);
-            concat_sink.write_hash(*it);
-            concat_sink.write_hash(*(it + 1));
-            concat_stream.flush();
-
-            BITCOIN_ASSERT(concat_data.size() == (2 * hash_size));
-
-            // Hash both of the hashes.
-            const auto new_root = bitcoin_hash(concat_data);
-
-            // Add this to the new list.
-            new_merkle.push_back(new_root);
-        }
-
-        // This is the new list.
-        merkle = new_merkle;
+        // Hash each pair of hashes into the next level, several at once.
+        merkle = bitcoin_hash_pairs(merkle);
     }
 
     // Finally we end up with a single item.
@@ -227,6 +204,7 @@ hash_digest block::generate_merkle_root(const transaction::list &transactions)
 {
     // Generate list of transaction hashes.
     hash_list tx_hashes;
+    tx_hashes.reserve(transactions.size() + 1);
     for (const auto &tx : transactions)
         tx_hashes.push_back(tx.hash());
 
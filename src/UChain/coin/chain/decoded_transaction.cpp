@@ -0,0 +1,83 @@
+/**
+ * Copyright (c) 2018-2020 UChain core developers (check UC-AUTHORS)
+ *
+ * This file is part of UChain.
+ *
+ * UChain is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <UChain/coin/chain/decoded_transaction.hpp>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <UChain/coin/math/stealth.hpp>
+
+namespace libbitcoin
+{
+namespace chain
+{
+
+using namespace bc::wallet;
+
+decoded_transaction::decoded_transaction(const transaction &tx)
+{
+    inputs.reserve(tx.inputs.size());
+    for (const auto &input : tx.inputs)
+    {
+        const auto address = payment_address::extract(input.script);
+        inputs.push_back({address, address ? address.encoded() : ""});
+    }
+
+    outputs.reserve(tx.outputs.size());
+    for (const auto &output : tx.outputs)
+    {
+        decoded_output decoded{};
+        decoded.address = payment_address::extract(output.script);
+        decoded.encoded = decoded.address ? decoded.address.encoded() : "";
+        decoded.attachment_type = output.attach_data.get_type();
+        decoded.symbol = output.get_token_symbol();
+        decoded.stealth = to_stealth_prefix(decoded.stealth_prefix, output.script);
+        decoded.ephemeral = decoded.stealth &&
+            extract_ephemeral_key(decoded.ephemeral_key, output.script);
+        outputs.push_back(std::move(decoded));
+    }
+}
+
+std::vector<std::string> decoded_transaction::addresses() const
+{
+    std::vector<std::string> result;
+    const auto add = [&result](const std::string &encoded) {
+        if (!encoded.empty() &&
+            std::find(result.begin(), result.end(), encoded) == result.end())
+            result.push_back(encoded);
+    };
+
+    for (const auto &input : inputs)
+        add(input.encoded);
+
+    for (const auto &output : outputs)
+        add(output.encoded);
+
+    return result;
+}
+
+bool decoded_transaction::is_stealth_payment(size_t index) const
+{
+    return index + 1 < outputs.size() && outputs[index].stealth &&
+           outputs[index + 1].address;
+}
+
+} // namespace chain
+} // namespace libbitcoin
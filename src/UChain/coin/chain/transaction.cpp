@@ -24,6 +24,7 @@
 #include <sstream>
 #include <utility>
 #include <boost/iostreams/stream.hpp>
+#include <UChain/coin/chain/decoded_transaction.hpp>
 #include <UChain/coin/chain/input.hpp>
 #include <UChain/coin/chain/output.hpp>
 #include <UChain/coin/constants.hpp>
@@ -85,6 +86,7 @@ transaction::transaction(transaction &&other)
                   std::forward<input::list>(other.inputs),
                   std::forward<output::list>(other.outputs))
 {
+    decoded_ = std::move(other.decoded_);
 }
 
 transaction::transaction(uint32_t version, uint32_t locktime,
@@ -103,6 +105,10 @@ transaction &transaction::operator=(transaction &&other)
     locktime = other.locktime;
     inputs = std::move(other.inputs);
     outputs = std::move(other.outputs);
+
+    mutex_.lock();
+    decoded_ = std::move(other.decoded_);
+    mutex_.unlock();
     return *this;
 }
 
@@ -113,6 +119,11 @@ transaction &transaction::operator=(const transaction &other)
     locktime = other.locktime;
     inputs = other.inputs;
     outputs = other.outputs;
+
+    // Copies are mutated, as when signing, so they decode their own scripts.
+    mutex_.lock();
+    decoded_.reset();
+    mutex_.unlock();
     return *this;
 }
 
@@ -133,6 +144,7 @@ void transaction::reset()
 
     mutex_.lock();
     hash_.reset();
+    decoded_.reset();
     mutex_.unlock();
 }
 
@@ -293,6 +305,28 @@ hash_digest transaction::hash() const
     return hash;
 }
 
+std::shared_ptr<const decoded_transaction> transaction::decoded() const
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    mutex_.lock_upgrade();
+
+    if (!decoded_)
+    {
+        //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+        mutex_.unlock_upgrade_and_lock();
+        decoded_ = std::make_shared<const decoded_transaction>(*this);
+        mutex_.unlock_and_lock_upgrade();
+        //---------------------------------------------------------------------
+    }
+
+    const auto decoded = decoded_;
+    mutex_.unlock_upgrade();
+    ///////////////////////////////////////////////////////////////////////////
+
+    return decoded;
+}
+
 hash_digest transaction::hash(uint32_t sighash_type) const
 {
     auto serialized = to_data();
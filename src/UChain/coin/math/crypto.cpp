@@ -25,24 +25,75 @@
 #include <UChain/coin/utility/assert.hpp>
 #include <UChain/coin/utility/data.hpp>
 #include "external/aes256.h"
+#include "external/aes256_ni.h"
+#include "external/zeroize.h"
 
 namespace libbitcoin
 {
 
-void aes256_encrypt(const aes_secret &key, aes_block &block)
+struct aes256_key::schedule
 {
+    bool native;
     aes256_context context;
-    aes256_init(&context, key.data());
-    aes256_encrypt_ecb(&context, block.data());
-    aes256_done(&context);
+    aes256_ni_context rounds;
+};
+
+aes256_key::aes256_key(const aes_secret &key)
+  : schedule_(new schedule)
+{
+    schedule_->native = aes256_ni_available() != 0;
+
+#ifdef UC_AES256_NI
+    if (schedule_->native)
+    {
+        aes256_ni_init(&schedule_->rounds, key.data());
+        return;
+    }
+#endif
+
+    aes256_init(&schedule_->context, key.data());
+}
+
+aes256_key::~aes256_key()
+{
+    aes256_done(&schedule_->context);
+    zeroize(&schedule_->rounds, sizeof(schedule_->rounds));
+}
+
+void aes256_key::encrypt(aes_block &block)
+{
+#ifdef UC_AES256_NI
+    if (schedule_->native)
+    {
+        aes256_ni_encrypt_ecb(&schedule_->rounds, block.data());
+        return;
+    }
+#endif
+
+    aes256_encrypt_ecb(&schedule_->context, block.data());
+}
+
+void aes256_key::decrypt(aes_block &block)
+{
+#ifdef UC_AES256_NI
+    if (schedule_->native)
+    {
+        aes256_ni_decrypt_ecb(&schedule_->rounds, block.data());
+        return;
+    }
+#endif
+
+    aes256_decrypt_ecb(&schedule_->context, block.data());
+}
+
+void aes256_encrypt(const aes_secret &key, aes_block &block)
+{
+    aes256_key(key).encrypt(block);
 }
 
 void aes256_decrypt(const aes_secret &key, aes_block &block)
 {
-    aes256_context context;
-    aes256_init(&context, key.data());
-    aes256_decrypt_ecb(&context, block.data());
-    aes256_done(&context);
+    aes256_key(key).decrypt(block);
 }
 
 } // namespace libbitcoin
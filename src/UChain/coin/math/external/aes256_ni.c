@@ -0,0 +1,165 @@
+/**
+ * Copyright (c) 2018-2020 UChain core developers (check UC-AUTHORS)
+ *
+ * This file is part of UChain.
+ *
+ * UChain is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "aes256_ni.h"
+
+#include <stdint.h>
+
+#ifdef UC_AES256_NI
+#include <cpuid.h>
+#include <immintrin.h>
+
+int aes256_ni_available(void)
+{
+    static int available = -1;
+    int result = __atomic_load_n(&available, __ATOMIC_RELAXED);
+    unsigned int eax, ebx, ecx, edx;
+
+    if (result < 0)
+    {
+        result = __get_cpuid(1, &eax, &ebx, &ecx, &edx) &&
+                 ((ecx >> 25) & 1);
+        __atomic_store_n(&available, result, __ATOMIC_RELAXED);
+    }
+
+    return result;
+}
+
+#define AES_NI_TARGET __attribute__((target("aes")))
+
+/* The next even round key from the previous pair, with round constant. */
+#define EXPAND_EVEN(even, odd, rcon)                                  \
+    do                                                                \
+    {                                                                 \
+        __m128i assist = _mm_aeskeygenassist_si128(odd, rcon);        \
+        assist = _mm_shuffle_epi32(assist, 0xff);                     \
+        even = _mm_xor_si128(even, _mm_slli_si128(even, 4));          \
+        even = _mm_xor_si128(even, _mm_slli_si128(even, 4));          \
+        even = _mm_xor_si128(even, _mm_slli_si128(even, 4));          \
+        even = _mm_xor_si128(even, assist);                           \
+    } while (0)
+
+/* The next odd round key from the previous pair. */
+#define EXPAND_ODD(even, odd)                                         \
+    do                                                                \
+    {                                                                 \
+        __m128i assist = _mm_aeskeygenassist_si128(even, 0x00);       \
+        assist = _mm_shuffle_epi32(assist, 0xaa);                     \
+        odd = _mm_xor_si128(odd, _mm_slli_si128(odd, 4));             \
+        odd = _mm_xor_si128(odd, _mm_slli_si128(odd, 4));             \
+        odd = _mm_xor_si128(odd, _mm_slli_si128(odd, 4));             \
+        odd = _mm_xor_si128(odd, assist);                             \
+    } while (0)
+
+#define STORE_KEY(context, round, value) \
+    _mm_storeu_si128((__m128i *)context->enckey[round], value)
+
+AES_NI_TARGET
+void aes256_ni_init(aes256_ni_context *context,
+                    const uint8_t key[AES256_KEY_LENGTH])
+{
+    __m128i even = _mm_loadu_si128((const __m128i *)key);
+    __m128i odd = _mm_loadu_si128((const __m128i *)(key + 16));
+    unsigned int round;
+
+    STORE_KEY(context, 0, even);
+    STORE_KEY(context, 1, odd);
+    EXPAND_EVEN(even, odd, 0x01);
+    STORE_KEY(context, 2, even);
+    EXPAND_ODD(even, odd);
+    STORE_KEY(context, 3, odd);
+    EXPAND_EVEN(even, odd, 0x02);
+    STORE_KEY(context, 4, even);
+    EXPAND_ODD(even, odd);
+    STORE_KEY(context, 5, odd);
+    EXPAND_EVEN(even, odd, 0x04);
+    STORE_KEY(context, 6, even);
+    EXPAND_ODD(even, odd);
+    STORE_KEY(context, 7, odd);
+    EXPAND_EVEN(even, odd, 0x08);
+    STORE_KEY(context, 8, even);
+    EXPAND_ODD(even, odd);
+    STORE_KEY(context, 9, odd);
+    EXPAND_EVEN(even, odd, 0x10);
+    STORE_KEY(context, 10, even);
+    EXPAND_ODD(even, odd);
+    STORE_KEY(context, 11, odd);
+    EXPAND_EVEN(even, odd, 0x20);
+    STORE_KEY(context, 12, even);
+    EXPAND_ODD(even, odd);
+    STORE_KEY(context, 13, odd);
+    EXPAND_EVEN(even, odd, 0x40);
+    STORE_KEY(context, 14, even);
+
+    /* The equivalent inverse cipher uses the keys in reverse order, with
+     * the inner ones passed through InvMixColumns. */
+    _mm_storeu_si128((__m128i *)context->deckey[0],
+                     _mm_loadu_si128((const __m128i *)context->enckey[14]));
+    for (round = 1; round < 14; round++)
+        _mm_storeu_si128((__m128i *)context->deckey[round],
+                         _mm_aesimc_si128(_mm_loadu_si128(
+                             (const __m128i *)context->enckey[14 - round])));
+    _mm_storeu_si128((__m128i *)context->deckey[14],
+                     _mm_loadu_si128((const __m128i *)context->enckey[0]));
+}
+
+AES_NI_TARGET
+void aes256_ni_encrypt_ecb(const aes256_ni_context *context,
+                           uint8_t plain_text[AES256_BLOCK_LENGTH])
+{
+    __m128i block = _mm_loadu_si128((const __m128i *)plain_text);
+    unsigned int round;
+
+    block = _mm_xor_si128(block,
+                          _mm_loadu_si128((const __m128i *)context->enckey[0]));
+    for (round = 1; round < 14; round++)
+        block = _mm_aesenc_si128(block,
+                                 _mm_loadu_si128((const __m128i *)context->enckey[round]));
+    block = _mm_aesenclast_si128(block,
+                                 _mm_loadu_si128((const __m128i *)context->enckey[14]));
+
+    _mm_storeu_si128((__m128i *)plain_text, block);
+}
+
+AES_NI_TARGET
+void aes256_ni_decrypt_ecb(const aes256_ni_context *context,
+                           uint8_t cypher_text[AES256_BLOCK_LENGTH])
+{
+    __m128i block = _mm_loadu_si128((const __m128i *)cypher_text);
+    unsigned int round;
+
+    block = _mm_xor_si128(block,
+                          _mm_loadu_si128((const __m128i *)context->deckey[0]));
+    for (round = 1; round < 14; round++)
+        block = _mm_aesdec_si128(block,
+                                 _mm_loadu_si128((const __m128i *)context->deckey[round]));
+    block = _mm_aesdeclast_si128(block,
+                                 _mm_loadu_si128((const __m128i *)context->deckey[14]));
+
+    _mm_storeu_si128((__m128i *)cypher_text, block);
+}
+
+#else
+
+int aes256_ni_available(void)
+{
+    return 0;
+}
+
+#endif
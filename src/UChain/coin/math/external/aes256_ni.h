@@ -0,0 +1,66 @@
+/**
+ * Copyright (c) 2018-2020 UChain core developers (check UC-AUTHORS)
+ *
+ * This file is part of UChain.
+ *
+ * UChain is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef UC_AES256_NI_H
+#define UC_AES256_NI_H
+
+#include <stdint.h>
+#include "aes256.h"
+
+/* AES-NI is compiled with function target attributes and only used once
+ * the cpu has been found to support it. */
+#if (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__GNUC__) || defined(__clang__))
+#define UC_AES256_NI
+#endif
+
+#define AES256_ROUND_KEYS 15U
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    typedef struct
+    {
+        uint8_t enckey[AES256_ROUND_KEYS][AES256_BLOCK_LENGTH];
+        uint8_t deckey[AES256_ROUND_KEYS][AES256_BLOCK_LENGTH];
+    } aes256_ni_context;
+
+    /* Nonzero if the cpu supports the AES instructions. */
+    int aes256_ni_available(void);
+
+#ifdef UC_AES256_NI
+
+    void aes256_ni_init(aes256_ni_context *context,
+                        const uint8_t key[AES256_KEY_LENGTH]);
+
+    void aes256_ni_encrypt_ecb(const aes256_ni_context *context,
+                               uint8_t plain_text[AES256_BLOCK_LENGTH]);
+
+    void aes256_ni_decrypt_ecb(const aes256_ni_context *context,
+                               uint8_t cypher_text[AES256_BLOCK_LENGTH]);
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -27,6 +27,7 @@
 
 #include <stdint.h>
 #include <string.h>
+#include "sha256_simd.h"
 #include "zeroize.h"
 
 static uint32_t be32dec(const void *pp)
@@ -138,8 +139,8 @@ void SHA256Pad(SHA256CTX *context)
     SHA256Update(context, len, 8);
 }
 
-void SHA256Transform(uint32_t state[SHA256_STATE_LENGTH],
-                     const uint8_t block[SHA256_BLOCK_LENGTH])
+static void sha256_transform(uint32_t state[SHA256_STATE_LENGTH],
+                             const uint8_t block[SHA256_BLOCK_LENGTH])
 {
     int i;
     uint32_t W[64];
@@ -231,6 +232,76 @@ void SHA256Transform(uint32_t state[SHA256_STATE_LENGTH],
     zeroize((void *)&t1, sizeof t1);
 }
 
+/* Transform count consecutive blocks with the fastest available backend. */
+static void sha256_transform_blocks(uint32_t state[SHA256_STATE_LENGTH],
+                                    const uint8_t *blocks, size_t count)
+{
+#ifdef UC_SHA256_X86
+    if (SHA256Features() & SHA256_FEATURE_SHANI)
+    {
+        SHA256TransformSHANI(state, blocks, count);
+        return;
+    }
+#endif
+
+    for (; count > 0; count--, blocks += SHA256_BLOCK_LENGTH)
+        sha256_transform(state, blocks);
+}
+
+void SHA256Transform(uint32_t state[SHA256_STATE_LENGTH],
+                     const uint8_t block[SHA256_BLOCK_LENGTH])
+{
+    sha256_transform_blocks(state, block, 1);
+}
+
+/* The padding block of a 64 byte message and the padded block of a 32 byte
+ * message, as big endian words. */
+static const uint32_t PAD64[16] =
+    {
+        0x80000000, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 512};
+
+static const uint32_t PAD32[8] =
+    {
+        0x80000000, 0, 0, 0, 0, 0, 0, 256};
+
+static void sha256_double64(uint8_t digest[SHA256_DIGEST_LENGTH],
+                            const uint8_t input[SHA256_BLOCK_LENGTH])
+{
+    SHA256CTX context;
+    uint8_t block[SHA256_BLOCK_LENGTH];
+
+    SHA256Init(&context);
+    be32enc_vect(block, PAD64, SHA256_BLOCK_LENGTH);
+    sha256_transform_blocks(context.state, input, 1);
+    sha256_transform_blocks(context.state, block, 1);
+
+    be32enc_vect(block, context.state, SHA256_DIGEST_LENGTH);
+    be32enc_vect(block + SHA256_DIGEST_LENGTH, PAD32, SHA256_DIGEST_LENGTH);
+    SHA256Init(&context);
+    sha256_transform_blocks(context.state, block, 1);
+    be32enc_vect(digest, context.state, SHA256_DIGEST_LENGTH);
+}
+
+void SHA256Double64(uint8_t *digests, const uint8_t *inputs, size_t count)
+{
+#ifdef UC_SHA256_X86
+    const int features = SHA256Features();
+
+    /* Eight AVX2 lanes keep pace with SHA-NI, four SSE4.1 lanes do not. */
+    if (features & SHA256_FEATURE_AVX2)
+        for (; count >= 8; count -= 8, inputs += 8 * 64, digests += 8 * 32)
+            SHA256Double64AVX2(digests, inputs);
+
+    if ((features & SHA256_FEATURE_SSE41) && !(features & SHA256_FEATURE_SHANI))
+        for (; count >= 4; count -= 4, inputs += 4 * 64, digests += 4 * 32)
+            SHA256Double64SSE41(digests, inputs);
+#endif
+
+    for (; count > 0; count--, inputs += 64, digests += 32)
+        sha256_double64(digests, inputs);
+}
+
 void SHA256Update(SHA256CTX *context, const uint8_t *input, size_t length)
 {
     uint32_t bitlen[2];
@@ -253,17 +324,14 @@ void SHA256Update(SHA256CTX *context, const uint8_t *input, size_t length)
     }
 
     memcpy(&context->buf[r], input, 64 - r);
-    SHA256Transform(context->state, context->buf);
+    sha256_transform_blocks(context->state, context->buf, 1);
 
     input += 64 - r;
     length -= 64 - r;
 
-    while (length >= 64)
-    {
-        SHA256Transform(context->state, input);
-        input += 64;
-        length -= 64;
-    }
+    sha256_transform_blocks(context->state, input, length / 64);
+    input += length & ~(size_t)63;
+    length &= 63;
 
     memcpy(context->buf, input, length);
 }
@@ -60,6 +60,11 @@ extern "C"
 
     void SHA256Update(SHA256CTX *context, const uint8_t *input, size_t length);
 
+    /* Double SHA256 of count consecutive 64 byte inputs into count
+     * consecutive 32 byte digests, several inputs at once where the cpu
+     * allows it. */
+    void SHA256Double64(uint8_t *digests, const uint8_t *inputs, size_t count);
+
 #ifdef __cplusplus
 }
 #endif
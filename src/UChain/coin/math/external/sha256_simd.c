@@ -0,0 +1,327 @@
+/**
+ * Copyright (c) 2018-2020 UChain core developers (check UC-AUTHORS)
+ *
+ * This file is part of UChain.
+ *
+ * UChain is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "sha256_simd.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#ifdef UC_SHA256_X86
+#include <cpuid.h>
+#include <immintrin.h>
+
+static const uint32_t sha256_h[8] =
+    {
+        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+        0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+
+static const uint32_t sha256_k[64] =
+    {
+        0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5,
+        0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+        0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+        0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+        0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc,
+        0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+        0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7,
+        0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+        0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+        0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+        0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3,
+        0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+        0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5,
+        0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+        0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+        0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+
+static uint32_t be32dec(const uint8_t *p)
+{
+    return ((uint32_t)(p[3]) + ((uint32_t)(p[2]) << 8) +
+            ((uint32_t)(p[1]) << 16) + ((uint32_t)(p[0]) << 24));
+}
+
+static void be32enc(uint8_t *p, uint32_t x)
+{
+    p[3] = x & 0xff;
+    p[2] = (x >> 8) & 0xff;
+    p[1] = (x >> 16) & 0xff;
+    p[0] = (x >> 24) & 0xff;
+}
+
+/* Cpu detection.
+ * ------------------------------------------------------------------------- */
+
+static int sha256_detect(void)
+{
+    unsigned int eax, ebx, ecx, edx;
+    unsigned int xcr0_eax = 0, xcr0_edx = 0;
+    int features = 0;
+    int sse41, avx;
+
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+        return 0;
+
+    sse41 = (ecx >> 19) & 1;
+
+    /* AVX state must also be saved by the operating system. */
+    avx = (ecx >> 27) & 1 && (ecx >> 28) & 1;
+    if (avx)
+    {
+        __asm__("xgetbv"
+                : "=a"(xcr0_eax), "=d"(xcr0_edx)
+                : "c"(0));
+        avx = (xcr0_eax & 6) == 6;
+    }
+
+    if (sse41)
+        features |= SHA256_FEATURE_SSE41;
+
+    if (__get_cpuid_max(0, NULL) < 7)
+        return features;
+
+    __cpuid_count(7, 0, eax, ebx, ecx, edx);
+
+    if (sse41 && ((ebx >> 29) & 1))
+        features |= SHA256_FEATURE_SHANI;
+
+    if (avx && ((ebx >> 5) & 1))
+        features |= SHA256_FEATURE_AVX2;
+
+    return features;
+}
+
+int SHA256Features(void)
+{
+    static int features = -1;
+    int result = __atomic_load_n(&features, __ATOMIC_RELAXED);
+
+    if (result < 0)
+    {
+        result = sha256_detect();
+        __atomic_store_n(&features, result, __ATOMIC_RELAXED);
+    }
+
+    return result;
+}
+
+/* SHA-NI, one block at a time.
+ * ------------------------------------------------------------------------- */
+
+#define SHANI_TARGET __attribute__((target("sha,sse4.1")))
+
+/* Four rounds with the message words m and the constants from k. */
+#define SHANI_ROUNDS(s0, s1, m, k)                                  \
+    do                                                              \
+    {                                                               \
+        const __m128i msg = _mm_add_epi32(m,                        \
+            _mm_loadu_si128((const __m128i *)(k)));                 \
+        s1 = _mm_sha256rnds2_epu32(s1, s0, msg);                    \
+        s0 = _mm_sha256rnds2_epu32(s0, s1,                          \
+                                   _mm_shuffle_epi32(msg, 0x0e));   \
+    } while (0)
+
+/* Complete m2 from the preceding words of the schedule. */
+#define SHANI_SCHEDULE(m0, m1, m2)                                  \
+    m2 = _mm_sha256msg2_epu32(                                      \
+        _mm_add_epi32(m2, _mm_alignr_epi8(m1, m0, 4)), m1)
+
+#define SHANI_MESSAGE(m0, m1) m0 = _mm_sha256msg1_epu32(m0, m1)
+
+SHANI_TARGET
+void SHA256TransformSHANI(uint32_t state[8], const uint8_t *blocks,
+                          size_t count)
+{
+    const __m128i mask = _mm_set_epi64x(0x0c0d0e0f08090a0bULL,
+                                        0x0405060700010203ULL);
+    __m128i m0, m1, m2, m3, s0, s1, t0, t1, saved0, saved1;
+
+    /* The instructions take the state as ABEF and CDGH. */
+    t0 = _mm_loadu_si128((const __m128i *)state);
+    t1 = _mm_loadu_si128((const __m128i *)(state + 4));
+    t0 = _mm_shuffle_epi32(t0, 0xb1);
+    t1 = _mm_shuffle_epi32(t1, 0x1b);
+    s0 = _mm_alignr_epi8(t0, t1, 8);
+    s1 = _mm_blend_epi16(t1, t0, 0xf0);
+
+    for (; count > 0; count--, blocks += 64)
+    {
+        saved0 = s0;
+        saved1 = s1;
+
+        m0 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)blocks), mask);
+        SHANI_ROUNDS(s0, s1, m0, sha256_k + 0);
+        m1 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(blocks + 16)), mask);
+        SHANI_ROUNDS(s0, s1, m1, sha256_k + 4);
+        SHANI_MESSAGE(m0, m1);
+        m2 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(blocks + 32)), mask);
+        SHANI_ROUNDS(s0, s1, m2, sha256_k + 8);
+        SHANI_MESSAGE(m1, m2);
+        m3 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(blocks + 48)), mask);
+        SHANI_ROUNDS(s0, s1, m3, sha256_k + 12);
+        SHANI_SCHEDULE(m2, m3, m0);
+        SHANI_MESSAGE(m2, m3);
+        SHANI_ROUNDS(s0, s1, m0, sha256_k + 16);
+        SHANI_SCHEDULE(m3, m0, m1);
+        SHANI_MESSAGE(m3, m0);
+        SHANI_ROUNDS(s0, s1, m1, sha256_k + 20);
+        SHANI_SCHEDULE(m0, m1, m2);
+        SHANI_MESSAGE(m0, m1);
+        SHANI_ROUNDS(s0, s1, m2, sha256_k + 24);
+        SHANI_SCHEDULE(m1, m2, m3);
+        SHANI_MESSAGE(m1, m2);
+        SHANI_ROUNDS(s0, s1, m3, sha256_k + 28);
+        SHANI_SCHEDULE(m2, m3, m0);
+        SHANI_MESSAGE(m2, m3);
+        SHANI_ROUNDS(s0, s1, m0, sha256_k + 32);
+        SHANI_SCHEDULE(m3, m0, m1);
+        SHANI_MESSAGE(m3, m0);
+        SHANI_ROUNDS(s0, s1, m1, sha256_k + 36);
+        SHANI_SCHEDULE(m0, m1, m2);
+        SHANI_MESSAGE(m0, m1);
+        SHANI_ROUNDS(s0, s1, m2, sha256_k + 40);
+        SHANI_SCHEDULE(m1, m2, m3);
+        SHANI_MESSAGE(m1, m2);
+        SHANI_ROUNDS(s0, s1, m3, sha256_k + 44);
+        SHANI_SCHEDULE(m2, m3, m0);
+        SHANI_MESSAGE(m2, m3);
+        SHANI_ROUNDS(s0, s1, m0, sha256_k + 48);
+        SHANI_SCHEDULE(m3, m0, m1);
+        SHANI_MESSAGE(m3, m0);
+        SHANI_ROUNDS(s0, s1, m1, sha256_k + 52);
+        SHANI_SCHEDULE(m0, m1, m2);
+        SHANI_ROUNDS(s0, s1, m2, sha256_k + 56);
+        SHANI_SCHEDULE(m1, m2, m3);
+        SHANI_ROUNDS(s0, s1, m3, sha256_k + 60);
+
+        s0 = _mm_add_epi32(s0, saved0);
+        s1 = _mm_add_epi32(s1, saved1);
+    }
+
+    t0 = _mm_shuffle_epi32(s0, 0x1b);
+    t1 = _mm_shuffle_epi32(s1, 0xb1);
+    s0 = _mm_blend_epi16(t0, t1, 0xf0);
+    s1 = _mm_alignr_epi8(t1, t0, 8);
+    _mm_storeu_si128((__m128i *)state, s0);
+    _mm_storeu_si128((__m128i *)(state + 4), s1);
+}
+
+/* SSE4.1 and AVX2, one input per 32 bit lane.
+ * ------------------------------------------------------------------------- */
+
+typedef uint32_t sha256_v4 __attribute__((vector_size(16)));
+typedef uint32_t sha256_v8 __attribute__((vector_size(32)));
+
+/* These expand to the same operators for a word or a vector of words. */
+#define CH(x, y, z) (((x) & ((y) ^ (z))) ^ (z))
+#define MAJ(x, y, z) (((x) & ((y) | (z))) | ((y) & (z)))
+#define ROTR(x, n) (((x) >> (n)) | ((x) << (32 - (n))))
+#define BSIG0(x) (ROTR(x, 2) ^ ROTR(x, 13) ^ ROTR(x, 22))
+#define BSIG1(x) (ROTR(x, 6) ^ ROTR(x, 11) ^ ROTR(x, 25))
+#define SSIG0(x) (ROTR(x, 7) ^ ROTR(x, 18) ^ ((x) >> 3))
+#define SSIG1(x) (ROTR(x, 17) ^ ROTR(x, 19) ^ ((x) >> 10))
+
+/* Transform the lanes of the state s with the 16 message words of w, the
+ * rest of w is overwritten by the schedule. */
+#define LANES_TRANSFORM(vec, s, w)                                   \
+    do                                                               \
+    {                                                                \
+        vec a = s[0], b = s[1], c = s[2], d = s[3];                  \
+        vec e = s[4], f = s[5], g = s[6], h = s[7];                  \
+        vec t1, t2;                                                  \
+        int r;                                                       \
+        for (r = 16; r < 64; r++)                                    \
+            w[r] = SSIG1(w[r - 2]) + w[r - 7] +                      \
+                   SSIG0(w[r - 15]) + w[r - 16];                     \
+        for (r = 0; r < 64; r++)                                     \
+        {                                                            \
+            t1 = h + BSIG1(e) + CH(e, f, g) + sha256_k[r] + w[r];    \
+            t2 = BSIG0(a) + MAJ(a, b, c);                            \
+            h = g;                                                   \
+            g = f;                                                   \
+            f = e;                                                   \
+            e = d + t1;                                              \
+            d = c;                                                   \
+            c = b;                                                   \
+            b = a;                                                   \
+            a = t1 + t2;                                             \
+        }                                                            \
+        s[0] += a;                                                   \
+        s[1] += b;                                                   \
+        s[2] += c;                                                   \
+        s[3] += d;                                                   \
+        s[4] += e;                                                   \
+        s[5] += f;                                                   \
+        s[6] += g;                                                   \
+        s[7] += h;                                                   \
+    } while (0)
+
+/* The 64 byte input is followed by a padding block, the 32 byte digest of
+ * that is padded within its single block. */
+#define LANES_DOUBLE64(vec, lanes, digests, inputs)                  \
+    do                                                               \
+    {                                                                \
+        const vec zero = {0};                                        \
+        vec s[8], w[64];                                             \
+        size_t i, lane;                                              \
+        for (i = 0; i < 8; i++)                                      \
+            s[i] = zero + sha256_h[i];                               \
+        for (i = 0; i < 16; i++)                                     \
+            for (lane = 0; lane < lanes; lane++)                     \
+                w[i][lane] = be32dec(inputs + lane * 64 + i * 4);    \
+        LANES_TRANSFORM(vec, s, w);                                  \
+        w[0] = zero + 0x80000000;                                    \
+        for (i = 1; i < 15; i++)                                     \
+            w[i] = zero;                                             \
+        w[15] = zero + 512;                                          \
+        LANES_TRANSFORM(vec, s, w);                                  \
+        for (i = 0; i < 8; i++)                                      \
+        {                                                            \
+            w[i] = s[i];                                             \
+            s[i] = zero + sha256_h[i];                               \
+        }                                                            \
+        w[8] = zero + 0x80000000;                                    \
+        for (i = 9; i < 15; i++)                                     \
+            w[i] = zero;                                             \
+        w[15] = zero + 256;                                          \
+        LANES_TRANSFORM(vec, s, w);                                  \
+        for (lane = 0; lane < lanes; lane++)                         \
+            for (i = 0; i < 8; i++)                                  \
+                be32enc(digests + lane * 32 + i * 4, s[i][lane]);    \
+    } while (0)
+
+__attribute__((target("sse4.1")))
+void SHA256Double64SSE41(uint8_t *digests, const uint8_t *inputs)
+{
+    LANES_DOUBLE64(sha256_v4, 4, digests, inputs);
+}
+
+__attribute__((target("avx2")))
+void SHA256Double64AVX2(uint8_t *digests, const uint8_t *inputs)
+{
+    LANES_DOUBLE64(sha256_v8, 8, digests, inputs);
+}
+
+#else
+
+int SHA256Features(void)
+{
+    return 0;
+}
+
+#endif
@@ -0,0 +1,53 @@
+/**
+ * Copyright (c) 2018-2020 UChain core developers (check UC-AUTHORS)
+ *
+ * This file is part of UChain.
+ *
+ * UChain is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef UC_SHA256_SIMD_H
+#define UC_SHA256_SIMD_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/* The x86 backends are compiled with function target attributes, so they
+ * need no global compiler flags and are only called once the cpu has been
+ * found to support them. */
+#if (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__GNUC__) || defined(__clang__))
+#define UC_SHA256_X86
+#endif
+
+#define SHA256_FEATURE_SHANI 1
+#define SHA256_FEATURE_SSE41 2
+#define SHA256_FEATURE_AVX2 4
+
+/* The SHA256 features of the cpu, a mask of SHA256_FEATURE_*. */
+int SHA256Features(void);
+
+#ifdef UC_SHA256_X86
+
+/* Transform count consecutive 64 byte blocks into the state. */
+void SHA256TransformSHANI(uint32_t state[8], const uint8_t *blocks,
+                          size_t count);
+
+/* Double SHA256 of 4 (SSE4.1) or 8 (AVX2) consecutive 64 byte inputs. */
+void SHA256Double64SSE41(uint8_t *digests, const uint8_t *inputs);
+void SHA256Double64AVX2(uint8_t *digests, const uint8_t *inputs);
+
+#endif
+
+#endif
@@ -26,6 +26,7 @@
 #include <errno.h>
 #include <new>
 #include <stdexcept>
+#include <UChain/coin/utility/assert.hpp>
 #include "external/crypto_scrypt.h"
 #include "external/hmac_sha256.h"
 #include "external/hmac_sha512.h"
@@ -111,6 +112,20 @@ hash_digest bitcoin_hash(data_slice data)
     return sha256_hash(sha256_hash(data));
 }
 
+// The pairs are hashed in place as consecutive 64 byte inputs.
+hash_list bitcoin_hash_pairs(const hash_list &hashes)
+{
+    static_assert(sizeof(hash_digest) == hash_size, "unpadded hash_digest");
+    BITCOIN_ASSERT(hashes.size() % 2 == 0);
+
+    hash_list result(hashes.size() / 2);
+    if (!result.empty())
+        SHA256Double64(result.front().data(), hashes.front().data(),
+                       result.size());
+
+    return result;
+}
+
 short_hash bitcoin_short_hash(data_slice data)
 {
     return ripemd160_hash(sha256_hash(data));
@@ -290,7 +290,8 @@ void aes256_common_encrypt(data_chunk &mnemonic, data_chunk &passphrase, data_ch
     while (left--)
         data.push_back(uint8_t(0)); // data must to be multiple blocksize
 
-    auto mnem_encrypt = [&encry_output](aes_secret &sec, data_chunk &data) {
+    auto mnem_encrypt = [&encry_output](const aes_secret &sec, data_chunk &data) {
+        aes256_key key(sec);
         uint64_t start = 0, i = 0;
         aes_block block;
         while (start < data.size())
@@ -298,7 +299,7 @@ void aes256_common_encrypt(data_chunk &mnemonic, data_chunk &passphrase, data_ch
             for (i = 0; i < aes256_block_size; i++)
                 block[i] = static_cast<uint8_t>(*(data.begin() + start + i));
 
-            aes256_encrypt(sec, block);
+            key.encrypt(block);
 
             for (auto x : block)
                 encry_output.push_back(static_cast<char>(x));
@@ -318,7 +319,8 @@ void aes256_common_decrypt(const data_chunk &mnemonic, data_chunk &passphrase, d
 
     uint8_t left = static_cast<uint8_t>(*mnemonic.begin());
 
-    auto mnem_decrypt = [&decry_output](aes_secret &sec, const data_chunk &data) {
+    auto mnem_decrypt = [&decry_output](const aes_secret &sec, const data_chunk &data) {
+        aes256_key key(sec);
         uint32_t start = 1, i = 0; // escape first byte
         aes_block block;
         while (start < data.size())
@@ -326,7 +328,7 @@ void aes256_common_decrypt(const data_chunk &mnemonic, data_chunk &passphrase, d
             for (i = 0; i < aes256_block_size; i++)
                 block[i] = static_cast<uint8_t>(*(data.begin() + start + i));
 
-            aes256_decrypt(sec, block);
+            key.decrypt(block);
 
             for (auto x : block)
                 decry_output.push_back(static_cast<char>(x));
@@ -339,12 +341,21 @@ void aes256_common_decrypt(const data_chunk &mnemonic, data_chunk &passphrase, d
         decry_output.pop_back(); // remove left bytes
 }
 
+aes_secret passphrase_secret(const std::string &passphrase)
+{
+    data_chunk pass_chunk(passphrase.begin(), passphrase.end());
+    return sha256_hash(ripemd160_hash(pass_chunk));
+}
+
 /* encrypt string with extra 0 value */
 void encrypt_string(const std::string &mnemonic, std::string &passphrase, std::string &encry_output)
 {
-    data_chunk pass_chunk(passphrase.begin(), passphrase.end());
-    aes_secret sec = sha256_hash(ripemd160_hash(pass_chunk));
+    aes256_key key(passphrase_secret(passphrase));
+    encrypt_string(mnemonic, key, encry_output);
+}
 
+void encrypt_string(const std::string &mnemonic, aes256_key &key, std::string &encry_output)
+{
     encry_output.clear();
 
     std::string data = mnemonic;
@@ -355,52 +366,54 @@ void encrypt_string(const std::string &mnemonic, std::string &passphrase, std::s
     while (left--)
         data.push_back(uint8_t(0)); // data must to be multiple blocksize
 
-    auto mnem_encrypt = [&encry_output](aes_secret &sec, std::string &data) {
-        uint32_t start = 0, i = 0;
-        aes_block block;
-        while (start < data.size())
-        {
-            for (i = 0; i < aes256_block_size; i++)
-                block[i] = static_cast<uint8_t>(*(data.begin() + start + i));
+    encry_output.reserve(1 + data.size());
 
-            aes256_encrypt(sec, block);
+    uint32_t i = 0;
+    aes_block block;
+    while (start < data.size())
+    {
+        for (i = 0; i < aes256_block_size; i++)
+            block[i] = static_cast<uint8_t>(*(data.begin() + start + i));
 
-            for (auto x : block)
-                encry_output.push_back(static_cast<char>(x));
+        key.encrypt(block);
 
-            start += aes256_block_size;
-        }
-    };
-    mnem_encrypt(sec, data);
+        for (auto x : block)
+            encry_output.push_back(static_cast<char>(x));
+
+        start += aes256_block_size;
+    }
 }
 
 /* decrypt string */
 void decrypt_string(const std::string &mnemonic, std::string &passphrase, std::string &decry_output)
 {
-    data_chunk pass_chunk(passphrase.begin(), passphrase.end());
-    aes_secret sec = sha256_hash(ripemd160_hash(pass_chunk));
+    aes256_key key(passphrase_secret(passphrase));
+    decrypt_string(mnemonic, key, decry_output);
+}
 
+void decrypt_string(const std::string &mnemonic, aes256_key &key, std::string &decry_output)
+{
     decry_output.clear();
 
     uint8_t left = static_cast<uint8_t>(*mnemonic.begin());
 
-    auto mnem_decrypt = [&decry_output](aes_secret &sec, const std::string &data) {
-        uint32_t start = 1, i = 0; // escape first byte
-        aes_block block;
-        while (start < data.size())
-        {
-            for (i = 0; i < aes256_block_size; i++)
-                block[i] = static_cast<uint8_t>(*(data.begin() + start + i));
+    decry_output.reserve(mnemonic.size());
 
-            aes256_decrypt(sec, block);
+    uint32_t start = 1, i = 0; // escape first byte
+    aes_block block;
+    while (start < mnemonic.size())
+    {
+        for (i = 0; i < aes256_block_size; i++)
+            block[i] = static_cast<uint8_t>(*(mnemonic.begin() + start + i));
 
-            for (auto x : block)
-                decry_output.push_back(static_cast<char>(x));
+        key.decrypt(block);
+
+        for (auto x : block)
+            decry_output.push_back(static_cast<char>(x));
+
+        start += aes256_block_size;
+    }
 
-            start += aes256_block_size;
-        }
-    };
-    mnem_decrypt(sec, mnemonic);
     decry_output = decry_output.substr(0, decry_output.size() - left); // remove left bytes
 }
 
@@ -21,14 +21,17 @@
 #include <UChain/database/data_base.hpp>
 
 #include <cstdint>
+#include <condition_variable>
 #include <cstddef>
 #include <memory>
+#include <mutex>
+#include <set>
 #include <stdexcept>
 #include <algorithm>
 #include <boost/filesystem.hpp>
 #include <UChain/coin.hpp>
 #include <UChainService/txs/utility/path.hpp>
-#include <UChain/coin/config/base16.hpp> // used by db_metadata and push_asset
+#include <UChain/coin/config/base16.hpp> // used by db_metadata
 #include <UChain/database/memory/memory_map.hpp>
 #include <UChain/database/settings.hpp>
 #include <UChain/database/version.hpp>
@@ -50,6 +53,13 @@ static const config::checkpoint exception1 =
 static const config::checkpoint exception2 =
     {"00000000000743f190a18c5577a3c2d2a1f610ae9601ac046a38084ccb7cd721", 91880};
 
+// The key of a wallet name or an encoded address.
+static short_hash get_short_hash(const std::string &text)
+{
+    data_chunk data(text.begin(), text.end());
+    return ripemd160_hash(data);
+}
+
 bool data_base::touch_file(const path &file_path)
 {
     bc::ofstream file(file_path.string());
@@ -79,7 +89,17 @@ bool data_base::initialize(const path &prefix, const chain::block &genesis)
     auto metadata = db_metadata(db_metadata::current_version);
     data_base::write_metadata(metadata_path, metadata);
     instance.push(genesis);
-    return instance.stop();
+
+    if (!instance.stop())
+        return false;
+
+    // A new store builds every index as it goes.
+    return paths.complete_utxos() &&
+           paths.complete_balances() &&
+           paths.complete_uid_addresses() &&
+           paths.complete_wallet_history() &&
+           paths.complete_candidate_votes() &&
+           paths.complete_chain_work();
 }
 
 bool data_base::initialize_uids(const path &prefix)
@@ -96,10 +116,14 @@ bool data_base::initialize_uids(const path &prefix)
 
     instance.set_blackhole_uid();
 
+    if (!instance.stop())
+        return false;
+
     log::info(LOG_DATABASE)
         << "Upgrading uid table is complete.";
 
-    return instance.stop();
+    // The new uid table indexes its addresses as it goes.
+    return paths.complete_uid_addresses();
 }
 
 bool data_base::initialize_tokens(const path &prefix)
@@ -159,6 +183,59 @@ bool data_base::initialize_candidates(const path &prefix)
     return instance.stop();
 }
 
+bool data_base::initialize_utxos(const path &prefix)
+{
+    const store paths(prefix);
+    if (paths.utxos_complete())
+        return true;
+
+    // Truncates the table of an interrupted build.
+    if (!paths.touch_utxos())
+        return false;
+
+    data_base instance(prefix, 0, 0);
+    if (!instance.create_utxos() ||
+        !instance.blocks.start() ||
+        !instance.transactions.start())
+        return false;
+
+    // Replay the confirmed chain into the new table.
+    size_t top;
+    if (instance.blocks.top(top))
+    {
+        for (size_t height = 0; height <= top; ++height)
+        {
+            const auto block_result = instance.blocks.get(height);
+            const auto count = block_result.transaction_count();
+
+            for (size_t index = 0; index < count; ++index)
+            {
+                const auto tx_hash = block_result.transaction_hash(index);
+                const auto tx_result = instance.transactions.get(tx_hash);
+                if (!tx_result || tx_result.height() != height)
+                    continue;
+
+                instance.push_utxos(tx_result.transaction(), tx_hash, height);
+            }
+
+            if (height % 10000 == 0)
+                log::info(LOG_DATABASE)
+                    << "Upgrading utxo table at height " << height;
+        }
+    }
+
+    instance.utxos.sync();
+
+    if (!instance.stop())
+        return false;
+
+    log::info(LOG_DATABASE)
+        << "Upgrading utxo table is complete.";
+
+    // Flag the table only once the replay is flushed.
+    return paths.complete_utxos();
+}
+
 bool data_base::upgrade_version_63(const path &prefix)
 {
     auto metadata_path = prefix / db_metadata::file_name;
@@ -203,6 +280,287 @@ bool data_base::upgrade_version_63(const path &prefix)
     return true;
 }
 
+bool data_base::initialize_uid_addresses(const path &prefix)
+{
+    const store paths(prefix);
+    if (paths.uid_addresses_complete() || !paths.uids_exist())
+        return true;
+
+    // Truncates the index of an interrupted build.
+    if (!paths.touch_uid_addresses())
+        return false;
+
+    data_base instance(prefix, 0, 0);
+    if (!instance.uids.create_address_index())
+        return false;
+
+    if (!instance.stop())
+        return false;
+
+    log::info(LOG_DATABASE)
+        << "Upgrading uid address index is complete.";
+
+    return paths.complete_uid_addresses();
+}
+
+bool data_base::initialize_balances(const path &prefix)
+{
+    const store paths(prefix);
+    if (paths.balances_complete())
+        return true;
+
+    // Truncates the tables of an interrupted build.
+    if (!paths.touch_balances())
+        return false;
+
+    data_base instance(prefix, 0, 0);
+    if (!instance.create_balances() ||
+        !instance.blocks.start() ||
+        !instance.transactions.start() ||
+        !instance.utxos.start())
+        return false;
+
+    // Replay the confirmed chain into the new table.
+    size_t top;
+    if (instance.blocks.top(top))
+    {
+        for (size_t height = 0; height <= top; ++height)
+        {
+            const auto block_result = instance.blocks.get(height);
+            const auto count = block_result.transaction_count();
+
+            for (size_t index = 0; index < count; ++index)
+            {
+                const auto tx_hash = block_result.transaction_hash(index);
+                const auto tx_result = instance.transactions.get(tx_hash);
+                if (!tx_result || tx_result.height() != height)
+                    continue;
+
+                instance.push_balances(tx_result.transaction(), tx_hash, height);
+            }
+
+            if (height % 10000 == 0)
+                log::info(LOG_DATABASE)
+                    << "Upgrading address balance table at height " << height;
+        }
+    }
+
+    instance.balances.sync();
+
+    if (!instance.stop())
+        return false;
+
+    log::info(LOG_DATABASE)
+        << "Upgrading address balance table is complete.";
+
+    return paths.complete_balances();
+}
+
+bool data_base::initialize_wallet_history(const path &prefix)
+{
+    const store paths(prefix);
+    if (paths.wallet_history_complete())
+        return true;
+
+    // Truncates the tables of an interrupted build.
+    if (!paths.touch_wallet_history())
+        return false;
+
+    data_base instance(prefix, 0, 0);
+    if (!instance.create_wallet_history() ||
+        !instance.wallets.start() ||
+        !instance.wallet_addresses.start() ||
+        !instance.address_tokens.start())
+        return false;
+
+    // Index the owner of every wallet address, then build each timeline.
+    const auto wallets = instance.wallets.get_wallets();
+    for (const auto &wallet : *wallets)
+    {
+        const auto wallet_key = get_short_hash(wallet.get_name());
+        for (const auto &address : instance.wallet_addresses.get(wallet_key))
+            instance.wallet_history.add_owner(
+                get_short_hash(address.get_address()), wallet_key);
+
+        instance.rebuild_wallet_history(wallet_key);
+    }
+
+    instance.wallet_history.sync();
+
+    if (!instance.stop())
+        return false;
+
+    log::info(LOG_DATABASE)
+        << "Upgrading wallet history timeline is complete.";
+
+    return paths.complete_wallet_history();
+}
+
+bool data_base::initialize_chain_work(const path &prefix)
+{
+    const store paths(prefix);
+    if (paths.chain_work_complete())
+        return true;
+
+    // Truncates the index of an interrupted build.
+    if (!paths.touch_chain_work())
+        return false;
+
+    data_base instance(prefix, 0, 0);
+    if (!instance.create_chain_work() ||
+        !instance.blocks.start())
+        return false;
+
+    // Accumulate the headers up to the first gap, if any.
+    size_t top;
+    if (instance.blocks.top(top))
+    {
+        for (size_t height = 0; height <= top; ++height)
+        {
+            const auto block_result = instance.blocks.get(height);
+            if (!block_result)
+                break;
+
+            instance.chain_work.store(block_result.header(), height);
+        }
+    }
+
+    instance.chain_work.sync();
+
+    if (!instance.stop())
+        return false;
+
+    log::info(LOG_DATABASE)
+        << "Upgrading chain work index is complete.";
+
+    return paths.complete_chain_work();
+}
+
+bool data_base::initialize_candidate_votes(const path &prefix)
+{
+    const store paths(prefix);
+    if (paths.candidate_votes_complete())
+        return true;
+
+    // Truncates the tables of an interrupted build.
+    if (!paths.touch_candidate_votes())
+        return false;
+
+    data_base instance(prefix, 0, 0);
+    if (!instance.create_candidate_votes() ||
+        !instance.blocks.start() ||
+        !instance.transactions.start() ||
+        !instance.utxos.start())
+        return false;
+
+    // Replay the vote outputs of the confirmed chain into the new tally.
+    size_t top;
+    if (instance.blocks.top(top))
+    {
+        for (size_t height = 0; height <= top; ++height)
+        {
+            const auto block_result = instance.blocks.get(height);
+            const auto count = block_result.transaction_count();
+
+            for (size_t index = 0; index < count; ++index)
+            {
+                const auto tx_hash = block_result.transaction_hash(index);
+                const auto tx_result = instance.transactions.get(tx_hash);
+                if (!tx_result || tx_result.height() != height)
+                    continue;
+
+                instance.push_votes(tx_result.transaction(), height);
+            }
+
+            if (height % 10000 == 0)
+                log::info(LOG_DATABASE)
+                    << "Upgrading candidate vote tally at height " << height;
+        }
+    }
+
+    instance.candidate_votes.sync();
+
+    if (!instance.stop())
+        return false;
+
+    log::info(LOG_DATABASE)
+        << "Upgrading candidate vote tally is complete.";
+
+    return paths.complete_candidate_votes();
+}
+
+bool data_base::upgrade_utxos(const path &prefix)
+{
+    if (!initialize_utxos(prefix))
+    {
+        log::error(LOG_DATABASE)
+            << "Failed to upgrade utxo database.";
+        return false;
+    }
+
+    return true;
+}
+
+bool data_base::upgrade_uid_addresses(const path &prefix)
+{
+    if (!initialize_uid_addresses(prefix))
+    {
+        log::error(LOG_DATABASE)
+            << "Failed to upgrade uid address index.";
+        return false;
+    }
+
+    return true;
+}
+
+bool data_base::upgrade_balances(const path &prefix)
+{
+    if (!initialize_balances(prefix))
+    {
+        log::error(LOG_DATABASE)
+            << "Failed to upgrade address balance database.";
+        return false;
+    }
+
+    return true;
+}
+
+bool data_base::upgrade_wallet_history(const path &prefix)
+{
+    if (!initialize_wallet_history(prefix))
+    {
+        log::error(LOG_DATABASE)
+            << "Failed to upgrade wallet history timeline.";
+        return false;
+    }
+
+    return true;
+}
+
+bool data_base::upgrade_chain_work(const path &prefix)
+{
+    if (!initialize_chain_work(prefix))
+    {
+        log::error(LOG_DATABASE)
+            << "Failed to upgrade chain work index.";
+        return false;
+    }
+
+    return true;
+}
+
+bool data_base::upgrade_candidate_votes(const path &prefix)
+{
+    if (!initialize_candidate_votes(prefix))
+    {
+        log::error(LOG_DATABASE)
+            << "Failed to upgrade candidate vote tally.";
+        return false;
+    }
+
+    return true;
+}
+
 void data_base::set_admin(const std::string &name, const std::string &passwd)
 {
     wallets.set_admin(name, passwd);
@@ -281,6 +639,8 @@ data_base::store::store(const path &prefix)
     history_lookup = prefix / "history_table";
     spends_lookup = prefix / "spend_table";
     transactions_lookup = prefix / "transaction_table";
+    utxos_lookup = prefix / "utxo_table";
+    balances_lookup = prefix / "address_balance_table";
     /* begin database for wallet, token, address_token relationship */
     wallets_lookup = prefix / "wallet_table";
     tokens_lookup = prefix / "token_table";                 // for blockchain tokens
@@ -290,23 +650,42 @@ data_base::store::store(const path &prefix)
     wallet_tokens_lookup = prefix / "wallet_token_table";
     wallet_tokens_rows = prefix / "wallet_token_row";
     uids_lookup = prefix / "uid_table";
+    uid_addresses_lookup = prefix / "uid_address_index_table";
+    uid_addresses_rows = prefix / "uid_address_index_rows";
     address_uids_lookup = prefix / "address_uid_table"; // for blockchain
     address_uids_rows = prefix / "address_uid_row";     // for blockchain
     wallet_addresses_lookup = prefix / "wallet_address_table";
     wallet_addresses_rows = prefix / "wallet_address_rows";
+    wallet_history_lookup = prefix / "wallet_history_table";
+    wallet_history_rows = prefix / "wallet_history_rows";
+    wallet_owners_lookup = prefix / "wallet_owner_table";
+    wallet_owners_rows = prefix / "wallet_owner_rows";
     /* end database for wallet, token, address_token relationship */
     candidates_lookup = prefix / "candidate_table";
     address_candidates_lookup = prefix / "address_candidate_table"; // for blockchain
     address_candidates_rows = prefix / "address_candidate_row";     // for blockchain
     candidate_history_lookup = prefix / "candidate_history_table";  // for blockchain
     candidate_history_rows = prefix / "candidate_history_row";      // for blockchain
+    candidate_votes_lookup = prefix / "candidate_vote_table";
+    candidate_votes_rows = prefix / "candidate_vote_rows";
+
+    // Completion flags of the indexes built by upgrades.
+    utxos_flag = prefix / "utxo_table_complete";
+    balances_flag = prefix / "address_balance_table_complete";
+    uid_addresses_flag = prefix / "uid_address_index_complete";
+    wallet_history_flag = prefix / "wallet_history_table_complete";
+    candidate_votes_flag = prefix / "candidate_vote_table_complete";
+    chain_work_flag = prefix / "chain_work_index_complete";
 
     // Height-based (reverse) lookup.
     blocks_index = prefix / "block_index";
+    chain_work_index = prefix / "chain_work_index";
 
     // One (address) to many (rows).
     history_rows = prefix / "history_rows";
     stealth_rows = prefix / "stealth_rows";
+    frozen_lookup = prefix / "address_frozen_table";
+    frozen_rows = prefix / "address_frozen_rows";
 
     // Exclusive database access reserved by this process.
     database_lock = prefix / "process_lock";
@@ -317,11 +696,16 @@ bool data_base::store::touch_all() const
     // Return the result of the database file create.
     return touch_file(blocks_lookup) &&
            touch_file(blocks_index) &&
+           touch_file(chain_work_index) &&
            touch_file(history_lookup) &&
            touch_file(history_rows) &&
            touch_file(stealth_rows) &&
            touch_file(spends_lookup) &&
            touch_file(transactions_lookup) &&
+           touch_file(utxos_lookup) &&
+           touch_file(balances_lookup) &&
+           touch_file(frozen_lookup) &&
+           touch_file(frozen_rows) &&
            /* begin database for wallet, token, address_token relationship */
            touch_file(wallets_lookup) &&
            touch_file(tokens_lookup) &&
@@ -331,16 +715,24 @@ bool data_base::store::touch_all() const
            touch_file(wallet_tokens_lookup) &&
            touch_file(wallet_tokens_rows) &&
            touch_file(uids_lookup) &&
+           touch_file(uid_addresses_lookup) &&
+           touch_file(uid_addresses_rows) &&
            touch_file(address_uids_lookup) &&
            touch_file(address_uids_rows) &&
            touch_file(wallet_addresses_lookup) &&
            touch_file(wallet_addresses_rows) &&
+           touch_file(wallet_history_lookup) &&
+           touch_file(wallet_history_rows) &&
+           touch_file(wallet_owners_lookup) &&
+           touch_file(wallet_owners_rows) &&
            /* end database for wallet, token, address_token relationship */
            touch_file(candidates_lookup) &&
            touch_file(address_candidates_lookup) &&
            touch_file(address_candidates_rows) &&
            touch_file(candidate_history_lookup) &&
-           touch_file(candidate_history_rows);
+           touch_file(candidate_history_rows) &&
+           touch_file(candidate_votes_lookup) &&
+           touch_file(candidate_votes_rows);
 }
 
 bool data_base::store::uids_exist() const
@@ -353,10 +745,28 @@ bool data_base::store::uids_exist() const
 bool data_base::store::touch_uids() const
 {
     return touch_file(uids_lookup) &&
+           touch_file(uid_addresses_lookup) &&
+           touch_file(uid_addresses_rows) &&
            touch_file(address_uids_lookup) &&
            touch_file(address_uids_rows);
 }
 
+bool data_base::store::uid_addresses_complete() const
+{
+    return boost::filesystem::exists(uid_addresses_flag);
+}
+
+bool data_base::store::complete_uid_addresses() const
+{
+    return touch_file(uid_addresses_flag);
+}
+
+bool data_base::store::touch_uid_addresses() const
+{
+    return touch_file(uid_addresses_lookup) &&
+           touch_file(uid_addresses_rows);
+}
+
 bool data_base::store::tokens_exist() const
 {
     return boost::filesystem::exists(tokens_lookup) ||
@@ -399,6 +809,88 @@ bool data_base::store::touch_candidates() const
            touch_file(candidate_history_rows);
 }
 
+// The flag is written after the table, so a table without it is partial.
+bool data_base::store::utxos_complete() const
+{
+    return boost::filesystem::exists(utxos_flag);
+}
+
+bool data_base::store::complete_utxos() const
+{
+    return touch_file(utxos_flag);
+}
+
+bool data_base::store::touch_utxos() const
+{
+    return touch_file(utxos_lookup);
+}
+
+bool data_base::store::balances_complete() const
+{
+    return boost::filesystem::exists(balances_flag);
+}
+
+bool data_base::store::complete_balances() const
+{
+    return touch_file(balances_flag);
+}
+
+bool data_base::store::touch_balances() const
+{
+    return touch_file(balances_lookup) &&
+           touch_file(frozen_lookup) &&
+           touch_file(frozen_rows);
+}
+
+bool data_base::store::wallet_history_complete() const
+{
+    return boost::filesystem::exists(wallet_history_flag);
+}
+
+bool data_base::store::complete_wallet_history() const
+{
+    return touch_file(wallet_history_flag);
+}
+
+bool data_base::store::touch_wallet_history() const
+{
+    return touch_file(wallet_history_lookup) &&
+           touch_file(wallet_history_rows) &&
+           touch_file(wallet_owners_lookup) &&
+           touch_file(wallet_owners_rows);
+}
+
+bool data_base::store::chain_work_complete() const
+{
+    return boost::filesystem::exists(chain_work_flag);
+}
+
+bool data_base::store::complete_chain_work() const
+{
+    return touch_file(chain_work_flag);
+}
+
+bool data_base::store::touch_chain_work() const
+{
+    return touch_file(chain_work_index);
+}
+
+bool data_base::store::candidate_votes_complete() const
+{
+    return boost::filesystem::exists(candidate_votes_flag);
+}
+
+bool data_base::store::complete_candidate_votes() const
+{
+    return touch_file(candidate_votes_flag);
+}
+
+bool data_base::store::touch_candidate_votes() const
+{
+    return touch_file(candidate_votes_lookup) &&
+           touch_file(candidate_votes_rows);
+}
+
 data_base::db_metadata::db_metadata() : version_("")
 {
 }
@@ -541,22 +1033,28 @@ data_base::data_base(const store &paths, size_t history_height,
       sequential_lock_(0),
       mutex_(std::make_shared<shared_mutex>()),
       blocks(paths.blocks_lookup, paths.blocks_index, mutex_),
+      chain_work(paths.chain_work_index, mutex_),
       history(paths.history_lookup, paths.history_rows, mutex_),
       stealth(paths.stealth_rows, mutex_),
       spends(paths.spends_lookup, mutex_),
       transactions(paths.transactions_lookup, mutex_),
+      utxos(paths.utxos_lookup, mutex_),
+      balances(paths.balances_lookup, paths.frozen_lookup, paths.frozen_rows, mutex_),
       /* begin database for wallet, token, address_token, uid relationship */
       wallets(paths.wallets_lookup, mutex_),
       tokens(paths.tokens_lookup, mutex_),
       address_tokens(paths.address_tokens_lookup, paths.address_tokens_rows, mutex_),
       wallet_tokens(paths.wallet_tokens_lookup, paths.wallet_tokens_rows, mutex_),
       certs(paths.certs_lookup, mutex_),
-      uids(paths.uids_lookup, mutex_),
+      uids(paths.uids_lookup, paths.uid_addresses_lookup, paths.uid_addresses_rows, mutex_),
       address_uids(paths.address_uids_lookup, paths.address_uids_rows, mutex_),
       wallet_addresses(paths.wallet_addresses_lookup, paths.wallet_addresses_rows, mutex_),
+      wallet_history(paths.wallet_history_lookup, paths.wallet_history_rows,
+                     paths.wallet_owners_lookup, paths.wallet_owners_rows, mutex_),
       /* end database for wallet, token, address_token, uid relationship */
       candidates(paths.candidates_lookup, mutex_),
-      candidate_history(paths.candidate_history_lookup, paths.candidate_history_rows, mutex_)
+      candidate_history(paths.candidate_history_lookup, paths.candidate_history_rows, mutex_),
+      candidate_votes(paths.candidate_votes_lookup, paths.candidate_votes_rows, mutex_)
 {
 }
 
@@ -601,10 +1099,13 @@ bool data_base::create()
 {
     // Return the result of the database create.
     return blocks.create() &&
+           chain_work.create() &&
            history.create() &&
            spends.create() &&
            stealth.create() &&
            transactions.create() &&
+           utxos.create() &&
+           balances.create() &&
            /* begin database for wallet, token, address_token relationship */
            wallets.create() &&
            tokens.create() &&
@@ -614,9 +1115,11 @@ bool data_base::create()
            uids.create() &&
            address_uids.create() &&
            wallet_addresses.create() &&
+           wallet_history.create() &&
            /* end database for wallet, token, address_token relationship */
            candidates.create() &&
-           candidate_history.create();
+           candidate_history.create() &&
+           candidate_votes.create();
 }
 
 bool data_base::create_uids()
@@ -642,6 +1145,31 @@ bool data_base::create_candidates()
            candidate_history.create();
 }
 
+bool data_base::create_utxos()
+{
+    return utxos.create();
+}
+
+bool data_base::create_balances()
+{
+    return balances.create();
+}
+
+bool data_base::create_wallet_history()
+{
+    return wallet_history.create();
+}
+
+bool data_base::create_candidate_votes()
+{
+    return candidate_votes.create();
+}
+
+bool data_base::create_chain_work()
+{
+    return chain_work.create();
+}
+
 // Start must be called before performing queries.
 // Start may be called after stop and/or after close in order to restart.
 bool data_base::start()
@@ -663,10 +1191,13 @@ bool data_base::start()
     const auto start_exclusive = begin_write();
     const auto start_result =
         blocks.start() &&
+        chain_work.start() &&
         history.start() &&
         spends.start() &&
         stealth.start() &&
         transactions.start() &&
+        utxos.start() &&
+        balances.start() &&
         /* begin database for wallet, token, address_token relationship */
         wallets.start() &&
         tokens.start() &&
@@ -676,9 +1207,11 @@ bool data_base::start()
         uids.start() &&
         address_uids.start() &&
         wallet_addresses.start() &&
+        wallet_history.start() &&
         /* end database for wallet, token, address_token relationship */
         candidates.start() &&
-        candidate_history.start();
+        candidate_history.start() &&
+        candidate_votes.start();
     const auto end_exclusive = end_write();
 
     // Return the result of the database start.
@@ -690,10 +1223,13 @@ bool data_base::stop()
 {
     const auto start_exclusive = begin_write();
     const auto blocks_stop = blocks.stop();
+    const auto chain_work_stop = chain_work.stop();
     const auto history_stop = history.stop();
     const auto spends_stop = spends.stop();
     const auto stealth_stop = stealth.stop();
     const auto transactions_stop = transactions.stop();
+    const auto utxos_stop = utxos.stop();
+    const auto balances_stop = balances.stop();
     /* begin database for wallet, token, address_token relationship */
     const auto wallets_stop = wallets.stop();
     const auto tokens_stop = tokens.stop();
@@ -703,9 +1239,11 @@ bool data_base::stop()
     const auto uids_stop = uids.stop();
     const auto address_uids_stop = address_uids.stop();
     const auto wallet_addresses_stop = wallet_addresses.stop();
+    const auto wallet_history_stop = wallet_history.stop();
     /* end database for wallet, token, address_token relationship */
     const auto candidates_stop = candidates.stop();
     const auto candidate_history_stop = candidate_history.stop();
+    const auto candidate_votes_stop = candidate_votes.stop();
     const auto end_exclusive = end_write();
 
     // This should remove the lock file. This is not important for locking
@@ -716,10 +1254,13 @@ bool data_base::stop()
     // Return the cumulative result of the database shutdowns.
     return start_exclusive &&
            blocks_stop &&
+           chain_work_stop &&
            history_stop &&
            spends_stop &&
            stealth_stop &&
            transactions_stop &&
+           utxos_stop &&
+           balances_stop &&
            /* begin database for wallet, token, address_token relationship */
            wallets_stop &&
            tokens_stop &&
@@ -729,9 +1270,11 @@ bool data_base::stop()
            uids_stop &&
            address_uids_stop &&
            wallet_addresses_stop &&
+           wallet_history_stop &&
            /* end database for wallet, token, address_token relationship */
            candidates_stop &&
            candidate_history_stop &&
+           candidate_votes_stop &&
            end_exclusive;
 }
 
@@ -739,10 +1282,13 @@ bool data_base::stop()
 bool data_base::close()
 {
     const auto blocks_close = blocks.close();
+    const auto chain_work_close = chain_work.close();
     const auto history_close = history.close();
     const auto spends_close = spends.close();
     const auto stealth_close = stealth.close();
     const auto transactions_close = transactions.close();
+    const auto utxos_close = utxos.close();
+    const auto balances_close = balances.close();
     /* begin database for wallet, token, address_token relationship */
     const auto wallets_close = wallets.close();
     const auto tokens_close = tokens.close();
@@ -752,16 +1298,21 @@ bool data_base::close()
     const auto certs_close = certs.close();
     const auto uids_close = uids.close();
     const auto wallet_addresses_close = wallet_addresses.close();
+    const auto wallet_history_close = wallet_history.close();
     /* end database for wallet, token, address_token relationship */
     const auto candidates_close = candidates.close();
     const auto candidate_history_close = candidate_history.close();
+    const auto candidate_votes_close = candidate_votes.close();
 
     // Return the cumulative result of the database closes.
     return blocks_close &&
+           chain_work_close &&
            history_close &&
            spends_close &&
            stealth_close &&
            transactions_close &&
+           utxos_close &&
+           balances_close &&
            /* begin database for wallet, token, address_token relationship */
            wallets_close &&
            tokens_close &&
@@ -771,9 +1322,11 @@ bool data_base::close()
            certs_close &&
            uids_close &&
            wallet_addresses_close &&
+           wallet_history_close &&
            /* end database for wallet, token, address_token relationship */
            candidates_close &&
-           candidate_history_close;
+           candidate_history_close &&
+           candidate_votes_close;
 }
 
 // Locking.
@@ -784,6 +1337,21 @@ handle data_base::begin_read()
     return sequential_lock_.load();
 }
 
+handle data_base::begin_read_wait()
+{
+    auto value = sequential_lock_.load();
+    if (!is_write_locked(value))
+        return value;
+
+    std::unique_lock<std::mutex> lock(write_mutex_);
+    write_completed_.wait(lock, [this, &value]() {
+        value = sequential_lock_.load();
+        return !is_write_locked(value);
+    });
+
+    return value;
+}
+
 bool data_base::is_read_valid(handle value)
 {
     return value == sequential_lock_.load();
@@ -806,8 +1374,17 @@ bool data_base::begin_write()
 // TODO: clear the write sentinel.
 bool data_base::end_write()
 {
-    // slock_ is now even again.
-    return !is_write_locked(++sequential_lock_);
+    bool unlocked;
+    {
+        // Increment under the mutex so a waiting reader cannot miss the wake.
+        std::lock_guard<std::mutex> lock(write_mutex_);
+
+        // slock_ is now even again.
+        unlocked = !is_write_locked(++sequential_lock_);
+    }
+
+    write_completed_.notify_all();
+    return unlocked;
 }
 
 // Query engines.
@@ -832,6 +1409,8 @@ void data_base::synchronize()
     history.sync();
     stealth.sync();
     transactions.sync();
+    utxos.sync();
+    balances.sync();
     /* begin database for wallet, token, address_token relationship */
     wallets.sync();
     tokens.sync();
@@ -841,9 +1420,12 @@ void data_base::synchronize()
     uids.sync();
     address_uids.sync();
     wallet_addresses.sync();
+    wallet_history.sync();
     /* end database for wallet, token, address_token relationship */
     candidates.sync();
     candidate_history.sync();
+    candidate_votes.sync();
+    chain_work.sync();
     blocks.sync();
 }
 
@@ -879,6 +1461,13 @@ void data_base::push(const block &block)
 
 void data_base::push(const block &block, uint64_t height)
 {
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    std::lock_guard<std::mutex> lock(wallet_history_mutex_);
+
+    // Transactions of the block by the wallets they touch.
+    wallet_history_map wallets;
+
     for (size_t index = 0; index < block.transactions.size(); ++index)
     {
         // Skip BIP30 allowed duplicates (coinbase txs of excepted blocks).
@@ -889,10 +1478,13 @@ void data_base::push(const block &block, uint64_t height)
         const auto &tx = block.transactions[index];
         const auto tx_hash = tx.hash();
 
+        // Scripts are decoded once and shared with the notifiers of the block.
+        const auto decoded = tx.decoded();
+
         timestamp_ = block.header.timestamp; // for address_token_database store_input/store_output used only
         // Add inputs
         if (!tx.is_strict_coinbase())
-            push_inputs(tx_hash, height, tx.inputs);
+            push_inputs(tx_hash, height, tx.inputs, decoded->inputs);
 
         // std::string uidaddress = tx.get_uid_transfer_old_address();
         // if (!uidaddress.empty()) {
@@ -902,24 +1494,41 @@ void data_base::push(const block &block, uint64_t height)
         // }
 
         // Add outputs
-        push_outputs(tx_hash, height, tx.outputs);
+        push_outputs(tx_hash, height, tx.outputs, decoded->outputs);
 
         // Add stealth outputs
-        push_stealth(tx_hash, height, tx.outputs);
+        push_stealth(tx_hash, height, decoded->outputs);
+
+        // Update address balances, before the spent outputs are removed
+        push_balances(tx, tx_hash, height);
+
+        // Update the candidate vote tally, likewise
+        push_votes(tx, height);
+
+        // Spend previous outputs and add new unspent outputs
+        push_utxos(tx, tx_hash, height);
+
+        push_wallet_history(tx, tx_hash, height, wallets);
 
         // Add transaction
         transactions.store(height, index, tx);
     }
 
+    // Add the block to each wallet timeline at once, ordered within it.
+    for (auto &wallet : wallets)
+        wallet_history.store(wallet.first, std::move(wallet.second));
+
     // Add block itself.
     blocks.store(block, height);
+    chain_work.store(block.header, height);
 
     // Synchronise everything that was added.
     synchronize();
+    ///////////////////////////////////////////////////////////////////////////
 }
 
 void data_base::push_inputs(const hash_digest &tx_hash, size_t height,
-                            const input::list &inputs)
+                            const input::list &inputs, const decoded_inputs &decoded)
 {
     for (uint32_t index = 0; index < inputs.size(); ++index)
     {
@@ -931,8 +1540,7 @@ void data_base::push_inputs(const hash_digest &tx_hash, size_t height,
         if (height < history_height_)
             continue;
 
-        // Try to extract an address.
-        const auto address = payment_address::extract(input.script);
+        const auto &address = decoded[index].address;
         if (!address)
             continue;
 
@@ -940,7 +1548,7 @@ void data_base::push_inputs(const hash_digest &tx_hash, size_t height,
         history.add_input(address.hash(), point, height, previous);
 
         /* begin added for token issue/transfer */
-        auto address_str = address.encoded();
+        const auto &address_str = decoded[index].encoded;
         data_chunk data(address_str.begin(), address_str.end());
         short_hash key = ripemd160_hash(data);
         address_tokens.store_input(key, point, height, previous, timestamp_);
@@ -950,7 +1558,7 @@ void data_base::push_inputs(const hash_digest &tx_hash, size_t height,
 }
 
 void data_base::push_outputs(const hash_digest &tx_hash, size_t height,
-                             const output::list &outputs)
+                             const output::list &outputs, const decoded_outputs &decoded)
 {
     if (height < history_height_)
         return;
@@ -960,57 +1568,143 @@ void data_base::push_outputs(const hash_digest &tx_hash, size_t height,
         const auto &output = outputs[index];
         const chain::output_point point{tx_hash, index};
 
-        // Try to extract an address.
-        const auto address = payment_address::extract(output.script);
+        const auto &address = decoded[index].address;
         if (!address)
             continue;
 
         const auto value = output.value;
         history.add_output(address.hash(), point, height, value);
 
-        push_asset(output.attach_data, address, point, height, value);
+        push_asset(output.attach_data, decoded[index].encoded, point, height, value);
     }
 }
 
 void data_base::push_stealth(const hash_digest &tx_hash, size_t height,
-                             const output::list &outputs)
+                             const decoded_outputs &decoded)
 {
-    if (height < stealth_height_ || outputs.empty())
+    if (height < stealth_height_)
         return;
 
-    // Stealth outputs are paired by convention.
-    for (size_t index = 0; index < (outputs.size() - 1); ++index)
+    // Stealth outputs are paired by convention, the first output carries the
+    // unsigned ephemeral key and prefix, the second the payment address.
+    for (size_t index = 0; index + 1 < decoded.size(); ++index)
     {
-        const auto &ephemeral_script = outputs[index].script;
-        const auto &payment_script = outputs[index + 1].script;
-
-        // Try to extract an unsigned ephemeral key from the first output.
-        hash_digest unsigned_ephemeral_key;
-        if (!extract_ephemeral_key(unsigned_ephemeral_key, ephemeral_script))
-            continue;
-
-        // Try to extract a stealth prefix from the first output.
-        uint32_t prefix;
-        if (!to_stealth_prefix(prefix, ephemeral_script))
-            continue;
-
-        // Try to extract the payment address from the second output.
-        const auto address = payment_address::extract(payment_script);
-        if (!address)
+        const auto &ephemeral = decoded[index];
+        const auto &address = decoded[index + 1].address;
+        if (!ephemeral.ephemeral || !ephemeral.stealth || !address)
             continue;
 
         // The payment address versions are arbitrary and unused here.
         const chain::stealth_compact row{
-            unsigned_ephemeral_key,
+            ephemeral.ephemeral_key,
             address.hash(),
             tx_hash};
 
-        stealth.store(prefix, height, row);
+        stealth.store(ephemeral.stealth_prefix, height, row);
+    }
+}
+
+void data_base::push_utxos(const transaction &tx, const hash_digest &tx_hash,
+                           size_t height)
+{
+    if (!tx.is_strict_coinbase())
+        for (const auto &input : tx.inputs)
+            utxos.remove(input.previous_output);
+
+    const auto coinbase = tx.is_coinbase();
+    for (uint32_t index = 0; index < tx.outputs.size(); ++index)
+    {
+        const chain::output_point point{tx_hash, index};
+        utxos.store(point, height, coinbase, tx.outputs[index]);
+    }
+}
+
+// Find a previous output in the utxo table, or in the transaction table for
+// outputs already spent, as when an index is replayed after the utxo table.
+bool data_base::get_previous_output(const output_point &previous,
+                                    chain::output &output) const
+{
+    const auto utxo = utxos.get(previous);
+    if (utxo)
+    {
+        output = utxo.output();
+        return true;
+    }
+
+    const auto result = transactions.get(previous.hash);
+    if (!result)
+        return false;
+
+    const auto previous_tx = result.transaction();
+    if (previous.index >= previous_tx.outputs.size())
+        return false;
+
+    output = previous_tx.outputs[previous.index];
+    return true;
+}
+
+// The encoded address paying to the output script, empty if none.
+static std::string get_balance_address(const chain::output &output)
+{
+    const auto address = payment_address::extract(output.script);
+    return address ? address.encoded() : std::string();
+}
+
+void data_base::push_balances(const transaction &tx, const hash_digest &tx_hash,
+                              size_t height)
+{
+    chain::output previous_output;
+    if (!tx.is_strict_coinbase())
+    {
+        for (const auto &input : tx.inputs)
+        {
+            if (!get_previous_output(input.previous_output, previous_output))
+                continue;
+
+            const auto address = get_balance_address(previous_output);
+            if (address.empty())
+                continue;
+
+            balances.store_input(address, "", previous_output.value);
+            if (previous_output.is_token())
+                balances.store_input(address, previous_output.get_token_symbol(),
+                                     previous_output.get_token_amount());
+        }
+    }
+
+    const auto decoded = tx.decoded();
+    const auto coinbase = tx.is_coinbase();
+    for (uint32_t index = 0; index < tx.outputs.size(); ++index)
+    {
+        const auto &output = tx.outputs[index];
+        const auto &address = decoded->outputs[index].encoded;
+        if (address.empty())
+            continue;
+
+        balances.store_output(address, "", output.value);
+        if (output.is_token())
+            balances.store_output(address, output.get_token_symbol(),
+                                  output.get_token_amount());
+
+        const auto &ops = output.script.operations;
+        const auto deposit = operation::is_pay_key_hash_with_lock_height_pattern(ops);
+        if (!deposit && !coinbase)
+            continue;
+
+        const auto lock_height = deposit ? operation::
+            get_lock_height_from_pay_key_hash_with_lock_height(ops) : 0;
+        balances.store_frozen(address, {{tx_hash, index},
+            static_cast<uint32_t>(height), static_cast<uint32_t>(lock_height),
+            !deposit, output.value});
     }
 }
 
 chain::block data_base::pop()
 {
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    std::lock_guard<std::mutex> lock(wallet_history_mutex_);
+
     size_t height;
     DEBUG_ONLY(const auto result =)
     blocks.top(height);
@@ -1044,20 +1738,37 @@ chain::block data_base::pop()
         txs.emplace_back(tx_result.transaction());
     }
 
+    // The wallets with a row in the timeline at this height.
+    std::set<short_hash> wallets;
+
     // Loop txs backwards, the reverse of how they are added.
     // Remove txs, then outputs, then inputs (also reverse order).
     for (auto tx = txs.rbegin(); tx != txs.rend(); ++tx)
     {
-        transactions.remove(tx->hash());
-        pop_outputs(tx->outputs, height);
+        const auto tx_hash = tx->hash();
+        const auto decoded = tx->decoded();
+        transactions.remove(tx_hash);
+        pop_outputs(tx->outputs, decoded->outputs, height);
 
         if (!tx->is_strict_coinbase())
-            pop_inputs(tx->inputs, height);
+            pop_inputs(tx->inputs, decoded->inputs, height);
+
+        pop_utxos(*tx, tx_hash);
+        pop_balances(*tx, height);
+        pop_votes(*tx, height);
+
+        if (height >= history_height_)
+            for (const auto &wallet : wallet_history_owners(*tx))
+                wallets.insert(wallet);
     }
 
+    for (const auto &wallet : wallets)
+        wallet_history.unlink(wallet, height);
+
     // Stealth unlink is not implemented.
     stealth.unlink(height);
     blocks.unlink(height);
+    chain_work.unlink(height);
     blocks.remove(block.header.hash()); // wdy remove block from block hash table
 
     // Synchronise everything that was changed.
@@ -1067,24 +1778,70 @@ chain::block data_base::pop()
     return block;
 }
 
-void data_base::pop_inputs(const input::list &inputs, size_t height)
+void data_base::push_wallet_address(const std::string &name, const std::string &address)
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    std::lock_guard<std::mutex> lock(wallet_history_mutex_);
+
+    const auto wallet_key = get_short_hash(name);
+    const auto address_key = get_short_hash(address);
+    const auto owners = wallet_history.owners(address_key);
+    if (std::find(owners.begin(), owners.end(), wallet_key) != owners.end())
+        return;
+
+    wallet_history.add_owner(address_key, wallet_key);
+
+    // A new address has no history, only an imported one changes the timeline.
+    const auto records = address_tokens.get(address, 0, 0);
+    if (!records->empty())
+    {
+        auto txs = wallet_history.get(wallet_key);
+        for (const auto &record : *records)
+            txs.push_back({static_cast<uint32_t>(record.height),
+                           record.data.get_timestamp(), record.point.hash});
+
+        wallet_history.rebuild(wallet_key, std::move(txs));
+    }
+
+    wallet_history.sync();
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+void data_base::pop_wallet_addresses(const std::string &name,
+                                     const std::vector<std::string> &addresses)
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    std::lock_guard<std::mutex> lock(wallet_history_mutex_);
+
+    const auto wallet_key = get_short_hash(name);
+    for (const auto &address : addresses)
+        wallet_history.remove_owner(get_short_hash(address), wallet_key);
+
+    rebuild_wallet_history(wallet_key);
+    wallet_history.sync();
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+void data_base::pop_inputs(const input::list &inputs, const decoded_inputs &decoded,
+                           size_t height)
 {
     // Loop in reverse.
-    for (auto input = inputs.rbegin(); input != inputs.rend(); ++input)
+    for (auto index = inputs.size(); index-- > 0;)
     {
-        spends.remove(input->previous_output);
+        spends.remove(inputs[index].previous_output);
 
         if (height < history_height_)
             continue;
 
-        // Try to extract an address.
-        const auto address = payment_address::extract(input->script);
+        const auto &address = decoded[index].address;
 
         if (address)
         {
             history.delete_last_row(address.hash());
             // delete address token record
-            auto address_str = address.encoded();
+            const auto &address_str = decoded[index].encoded;
             data_chunk data(address_str.begin(), address_str.end());
             short_hash hash = ripemd160_hash(data);
             address_tokens.delete_last_row(hash);
@@ -1092,22 +1849,23 @@ void data_base::pop_inputs(const input::list &inputs, size_t height)
     }
 }
 
-void data_base::pop_outputs(const output::list &outputs, size_t height)
+void data_base::pop_outputs(const output::list &outputs, const decoded_outputs &decoded,
+                            size_t height)
 {
     if (height < history_height_)
         return;
 
     // Loop in reverse.
-    for (auto output = outputs.rbegin(); output != outputs.rend(); ++output)
+    for (auto index = outputs.size(); index-- > 0;)
     {
-        // Try to extract an address.
-        const auto address = payment_address::extract(output->script);
+        const auto output = outputs.begin() + index;
+        const auto &address = decoded[index].address;
 
         if (address)
         {
             history.delete_last_row(address.hash());
             // delete address token record
-            auto address_str = address.encoded();
+            const auto &address_str = decoded[index].encoded;
             data_chunk data(address_str.begin(), address_str.end());
             short_hash hash = ripemd160_hash(data);
             bc::chain::output op = *output;
@@ -1191,16 +1949,187 @@ void data_base::pop_outputs(const output::list &outputs, size_t height)
     }
 }
 
+void data_base::pop_utxos(const transaction &tx, const hash_digest &tx_hash)
+{
+    // Remove the outputs created by this transaction.
+    for (uint32_t index = 0; index < tx.outputs.size(); ++index)
+        utxos.remove({tx_hash, index});
+
+    if (tx.is_strict_coinbase())
+        return;
+
+    // Restore the outputs spent by this transaction, their transactions are
+    // still stored since txs are popped in reverse order.
+    for (auto input = tx.inputs.rbegin(); input != tx.inputs.rend(); ++input)
+    {
+        const auto &previous = input->previous_output;
+        const auto result = transactions.get(previous.hash);
+        if (!result)
+            continue;
+
+        const auto previous_tx = result.transaction();
+        if (previous.index >= previous_tx.outputs.size())
+            continue;
+
+        utxos.store(previous, result.height(), previous_tx.is_coinbase(),
+                    previous_tx.outputs[previous.index]);
+    }
+}
+
+// Outputs are reversed before inputs, the mirror of push_balances.
+void data_base::pop_balances(const transaction &tx, size_t height)
+{
+    const auto decoded = tx.decoded();
+    const auto coinbase = tx.is_coinbase();
+    for (auto index = tx.outputs.size(); index-- > 0;)
+    {
+        const auto output = tx.outputs.begin() + index;
+        const auto &address = decoded->outputs[index].encoded;
+        if (address.empty())
+            continue;
+
+        if (coinbase || operation::is_pay_key_hash_with_lock_height_pattern(
+                            output->script.operations))
+            balances.delete_last_frozen(address);
+
+        if (output->is_token())
+            balances.remove_output(address, output->get_token_symbol(),
+                                   output->get_token_amount());
+        balances.remove_output(address, "", output->value);
+    }
+
+    if (tx.is_strict_coinbase())
+        return;
+
+    chain::output previous_output;
+    for (auto input = tx.inputs.rbegin(); input != tx.inputs.rend(); ++input)
+    {
+        if (!get_previous_output(input->previous_output, previous_output))
+            continue;
+
+        const auto address = get_balance_address(previous_output);
+        if (address.empty())
+            continue;
+
+        if (previous_output.is_token())
+            balances.remove_input(address, previous_output.get_token_symbol(),
+                                  previous_output.get_token_amount());
+        balances.remove_input(address, "", previous_output.value);
+    }
+}
+
+void data_base::push_votes(const transaction &tx, size_t height)
+{
+    chain::output previous_output;
+    if (!tx.is_strict_coinbase())
+        for (const auto &input : tx.inputs)
+            if (get_previous_output(input.previous_output, previous_output))
+                push_vote(previous_output, height, true);
+
+    for (const auto &output : tx.outputs)
+        push_vote(output, height, false);
+}
+
+// The vote tally drops its rows of the block instead of reversing them.
+void data_base::pop_votes(const transaction &tx, size_t height)
+{
+    for (auto output = tx.outputs.rbegin(); output != tx.outputs.rend(); ++output)
+        if (output->is_vote())
+            candidate_votes.unlink(get_short_hash(output->get_to_uid()),
+                                   static_cast<uint32_t>(height));
+
+    if (tx.is_strict_coinbase())
+        return;
+
+    chain::output previous_output;
+    for (auto input = tx.inputs.rbegin(); input != tx.inputs.rend(); ++input)
+        if (get_previous_output(input->previous_output, previous_output) &&
+            previous_output.is_vote())
+            candidate_votes.unlink(get_short_hash(previous_output.get_to_uid()),
+                                   static_cast<uint32_t>(height));
+}
+
+// Votes count for the candidate uid they are paid to until spent.
+void data_base::push_vote(const chain::output &output, size_t height, bool spend)
+{
+    if (!output.is_vote())
+        return;
+
+    const auto to_uid = output.get_to_uid();
+    if (to_uid.empty())
+        return;
+
+    const auto uid_key = get_short_hash(to_uid);
+    const auto amount = output.get_token_amount();
+    if (spend)
+        candidate_votes.debit(uid_key, static_cast<uint32_t>(height), amount);
+    else
+        candidate_votes.credit(uid_key, static_cast<uint32_t>(height), amount);
+}
+
 /* begin store token related info into database */
 #include <UChain/coin/config/base16.hpp>
 using namespace libbitcoin::config;
 
-void data_base::push_asset(const asset &attach, const payment_address &address,
+// The wallets holding an address that address_tokens indexes for the tx.
+std::vector<short_hash> data_base::wallet_history_owners(const transaction &tx)
+{
+    std::set<short_hash> addresses;
+    const auto decoded = tx.decoded();
+
+    if (!tx.is_strict_coinbase())
+    {
+        for (const auto &input : decoded->inputs)
+            if (input.address)
+                addresses.insert(get_short_hash(input.encoded));
+    }
+
+    // Uid and candidate outputs are not in address_tokens, see pop_outputs.
+    for (size_t index = 0; index < tx.outputs.size(); ++index)
+    {
+        const auto &output = tx.outputs[index];
+        const auto &address = decoded->outputs[index];
+        if (address.address && !output.is_uid() && !output.is_candidate())
+            addresses.insert(get_short_hash(address.encoded));
+    }
+
+    std::set<short_hash> wallets;
+    for (const auto &address : addresses)
+        for (const auto &wallet : wallet_history.owners(address))
+            wallets.insert(wallet);
+
+    return {wallets.begin(), wallets.end()};
+}
+
+void data_base::push_wallet_history(const transaction &tx, const hash_digest &tx_hash,
+                                    size_t height, wallet_history_map &wallets)
+{
+    if (height < history_height_)
+        return;
+
+    for (const auto &wallet : wallet_history_owners(tx))
+        wallets[wallet].push_back({static_cast<uint32_t>(height), timestamp_, tx_hash});
+}
+
+// Rebuild the timeline of a wallet from the history of its addresses.
+void data_base::rebuild_wallet_history(const short_hash &wallet_key)
+{
+    wallet_tx::list txs;
+    for (const auto &address : wallet_addresses.get(wallet_key))
+    {
+        const auto records = address_tokens.get(address.get_address(), 0, 0);
+        for (const auto &record : *records)
+            txs.push_back({static_cast<uint32_t>(record.height),
+                           record.data.get_timestamp(), record.point.hash});
+    }
+
+    wallet_history.rebuild(wallet_key, std::move(txs));
+}
+
+void data_base::push_asset(const asset &attach, const std::string &address_str,
                            const output_point &outpoint, uint32_t output_height, uint64_t value)
 {
-    auto address_str = address.encoded();
     log::trace(LOG_DATABASE) << "push_asset address_str=" << address_str;
-    log::trace(LOG_DATABASE) << "push_asset address hash=" << base16(address.hash());
     data_chunk data(address_str.begin(), address_str.end());
     short_hash hash = ripemd160_hash(data);
     auto visitor = asset_visitor(this, hash, outpoint, output_height, value,
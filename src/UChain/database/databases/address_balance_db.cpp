@@ -0,0 +1,315 @@
+/**
+ * Copyright (c) 2018-2020 UChain core developers (check UC-AUTHORS)
+ *
+ * This file is part of UChain.
+ *
+ * UChain is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <UChain/database/databases/address_balance_db.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <boost/filesystem.hpp>
+#include <UChain/coin.hpp>
+#include <UChain/database/memory/memory.hpp>
+#include <UChain/database/primitives/record_multimap_iterable.hpp>
+#include <UChain/database/primitives/record_multimap_iterator.hpp>
+
+namespace libbitcoin
+{
+namespace database
+{
+
+using namespace boost::filesystem;
+using namespace bc::chain;
+
+BC_CONSTEXPR size_t totals_buckets = 9999991;
+BC_CONSTEXPR size_t totals_header_size = record_hash_table_header_size(totals_buckets);
+BC_CONSTEXPR size_t initial_totals_file_size = totals_header_size + minimum_records_size;
+
+BC_CONSTEXPR size_t lookup_buckets = 1000003;
+BC_CONSTEXPR size_t lookup_header_size = record_hash_table_header_size(lookup_buckets);
+BC_CONSTEXPR size_t initial_lookup_file_size = lookup_header_size + minimum_records_size;
+
+// [ total_received:8 ][ unspent_balance:8 ][ max_lock_height:4 ]
+BC_CONSTEXPR size_t totals_value_size = 8 + 8 + 4;
+BC_CONSTEXPR size_t totals_record_size = hash_table_record_size<hash_digest>(totals_value_size);
+
+BC_CONSTEXPR size_t lookup_record_size = hash_table_multimap_record_size<short_hash>();
+
+// [ point:36 ][ output_height:4 ][ lock_height:4 ][ coinbase:1 ][ value:8 ]
+BC_CONSTEXPR size_t frozen_value_size = 36 + 4 + 4 + 1 + 8;
+BC_CONSTEXPR size_t frozen_record_size = record_list_offset + frozen_value_size;
+
+static hash_digest totals_key(const std::string &address,
+                              const std::string &symbol)
+{
+    const auto key = address + ':' + symbol;
+    return sha256_hash(data_chunk(key.begin(), key.end()));
+}
+
+static short_hash frozen_key(const std::string &address)
+{
+    return ripemd160_hash(data_chunk(address.begin(), address.end()));
+}
+
+address_balance_database::address_balance_database(const path &totals_filename,
+                                                   const path &frozen_lookup_filename,
+                                                   const path &frozen_rows_filename,
+                                                   std::shared_ptr<shared_mutex> mutex)
+    : totals_file_(totals_filename, mutex),
+      totals_header_(totals_file_, totals_buckets),
+      totals_manager_(totals_file_, totals_header_size, totals_record_size),
+      totals_map_(totals_header_, totals_manager_),
+      lookup_file_(frozen_lookup_filename, mutex),
+      lookup_header_(lookup_file_, lookup_buckets),
+      lookup_manager_(lookup_file_, lookup_header_size, lookup_record_size),
+      lookup_map_(lookup_header_, lookup_manager_),
+      rows_file_(frozen_rows_filename, mutex),
+      rows_manager_(rows_file_, 0, frozen_record_size),
+      rows_list_(rows_manager_),
+      rows_multimap_(lookup_map_, rows_list_)
+{
+}
+
+// Close does not call stop because there is no way to detect thread join.
+address_balance_database::~address_balance_database()
+{
+    close();
+}
+
+// Create.
+// ----------------------------------------------------------------------------
+
+// Initialize files and start.
+bool address_balance_database::create()
+{
+    // Resize and create require a started file.
+    if (!totals_file_.start() ||
+        !lookup_file_.start() ||
+        !rows_file_.start())
+        return false;
+
+    // These will throw if insufficient disk space.
+    totals_file_.resize(initial_totals_file_size);
+    lookup_file_.resize(initial_lookup_file_size);
+    rows_file_.resize(minimum_records_size);
+
+    if (!totals_header_.create() ||
+        !totals_manager_.create() ||
+        !lookup_header_.create() ||
+        !lookup_manager_.create() ||
+        !rows_manager_.create())
+        return false;
+
+    // Should not call start after create, already started.
+    return totals_header_.start() &&
+           totals_manager_.start() &&
+           lookup_header_.start() &&
+           lookup_manager_.start() &&
+           rows_manager_.start();
+}
+
+// Startup and shutdown.
+// ----------------------------------------------------------------------------
+
+bool address_balance_database::start()
+{
+    return totals_file_.start() &&
+           lookup_file_.start() &&
+           rows_file_.start() &&
+           totals_header_.start() &&
+           totals_manager_.start() &&
+           lookup_header_.start() &&
+           lookup_manager_.start() &&
+           rows_manager_.start();
+}
+
+bool address_balance_database::stop()
+{
+    return totals_file_.stop() &&
+           lookup_file_.stop() &&
+           rows_file_.stop();
+}
+
+bool address_balance_database::close()
+{
+    return totals_file_.close() &&
+           lookup_file_.close() &&
+           rows_file_.close();
+}
+
+// ----------------------------------------------------------------------------
+
+address_balance address_balance_database::get(const std::string &address,
+                                              const std::string &symbol) const
+{
+    const auto memory = totals_map_.find(totals_key(address, symbol));
+    if (!memory)
+        return {0, 0, 0};
+
+    auto deserial = make_deserializer_unsafe(REMAP_ADDRESS(memory));
+
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    shared_lock lock(mutex_);
+    const auto received = deserial.read_8_bytes_little_endian();
+    const auto unspent = deserial.read_8_bytes_little_endian();
+    const auto max_lock = deserial.read_4_bytes_little_endian();
+    return {received, unspent, max_lock};
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+frozen_output::list address_balance_database::get_frozen(
+    const std::string &address, uint64_t top_height,
+    uint32_t coinbase_maturity) const
+{
+    // Rows are newest first, none older than the longest lock can be frozen.
+    const auto max_lock = std::max(get(address).max_lock_height,
+                                   coinbase_maturity);
+
+    const auto read_row = [](uint8_t *data) {
+        auto deserial = make_deserializer_unsafe(data);
+        frozen_output row;
+        row.point = point::factory_from_data(deserial);
+        row.output_height = deserial.read_4_bytes_little_endian();
+        row.lock_height = deserial.read_4_bytes_little_endian();
+        row.coinbase = deserial.read_byte() != 0;
+        row.value = deserial.read_8_bytes_little_endian();
+        return row;
+    };
+
+    frozen_output::list result;
+    const auto start = rows_multimap_.lookup(frozen_key(address));
+    const auto records = record_multimap_iterable(rows_list_, start);
+
+    for (const auto index : records)
+    {
+        // This obtains a remap safe address pointer against the rows file.
+        const auto record = rows_list_.get(index);
+        const auto row = read_row(REMAP_ADDRESS(record));
+
+        if (row.output_height + uint64_t(max_lock) <= top_height)
+            break;
+
+        const auto lock = row.coinbase ? coinbase_maturity : row.lock_height;
+        if (row.output_height + uint64_t(lock) > top_height)
+            result.push_back(row);
+    }
+
+    return result;
+}
+
+void address_balance_database::store_output(const std::string &address,
+                                            const std::string &symbol, uint64_t value)
+{
+    update(address, symbol, value, value, 0);
+}
+
+void address_balance_database::store_input(const std::string &address,
+                                           const std::string &symbol, uint64_t value)
+{
+    update(address, symbol, 0, -static_cast<int64_t>(value), 0);
+}
+
+void address_balance_database::remove_output(const std::string &address,
+                                             const std::string &symbol, uint64_t value)
+{
+    update(address, symbol, -static_cast<int64_t>(value),
+           -static_cast<int64_t>(value), 0);
+}
+
+void address_balance_database::remove_input(const std::string &address,
+                                            const std::string &symbol, uint64_t value)
+{
+    update(address, symbol, 0, value, 0);
+}
+
+void address_balance_database::store_frozen(const std::string &address,
+                                            const frozen_output &row)
+{
+    // Keep the scan bound of get_frozen, it is not lowered on pop.
+    if (!row.coinbase)
+        update(address, "", 0, 0, row.lock_height);
+
+    auto write = [&](memory_ptr data) {
+        auto serial = make_serializer(REMAP_ADDRESS(data));
+        serial.write_data(row.point.to_data());                // 36
+        serial.write_4_bytes_little_endian(row.output_height); // 4
+        serial.write_4_bytes_little_endian(row.lock_height);   // 4
+        serial.write_byte(row.coinbase ? 1 : 0);               // 1
+        serial.write_8_bytes_little_endian(row.value);         // 8
+    };
+    rows_multimap_.add_row(frozen_key(address), write);
+}
+
+void address_balance_database::delete_last_frozen(const std::string &address)
+{
+    rows_multimap_.delete_last_row(frozen_key(address));
+}
+
+void address_balance_database::update(const std::string &address,
+                                      const std::string &symbol, int64_t received, int64_t unspent,
+                                      uint32_t lock_height)
+{
+    const auto apply = [](uint64_t total, int64_t delta) {
+        if (delta < 0 && total < static_cast<uint64_t>(-delta))
+            return uint64_t(0);
+        return total + delta;
+    };
+
+    const auto key = totals_key(address, symbol);
+    const auto memory = totals_map_.find(key);
+
+    if (!memory)
+    {
+        auto write = [&](memory_ptr data) {
+            auto serial = make_serializer(REMAP_ADDRESS(data));
+            serial.write_8_bytes_little_endian(apply(0, received));
+            serial.write_8_bytes_little_endian(apply(0, unspent));
+            serial.write_4_bytes_little_endian(lock_height);
+        };
+        totals_map_.store(key, write);
+        return;
+    }
+
+    const auto data = REMAP_ADDRESS(memory);
+    auto deserial = make_deserializer_unsafe(data);
+    auto serial = make_serializer(data);
+
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    unique_lock lock(mutex_);
+    const auto old_received = deserial.read_8_bytes_little_endian();
+    const auto old_unspent = deserial.read_8_bytes_little_endian();
+    const auto old_lock = deserial.read_4_bytes_little_endian();
+    serial.write_8_bytes_little_endian(apply(old_received, received));
+    serial.write_8_bytes_little_endian(apply(old_unspent, unspent));
+    serial.write_4_bytes_little_endian(std::max(old_lock, lock_height));
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+void address_balance_database::sync()
+{
+    totals_manager_.sync();
+    lookup_manager_.sync();
+    rows_manager_.sync();
+}
+
+} // namespace database
+} // namespace libbitcoin
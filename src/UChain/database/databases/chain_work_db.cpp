@@ -0,0 +1,146 @@
+/**
+ * Copyright (c) 2018-2020 UChain core developers (check UC-AUTHORS)
+ *
+ * This file is part of UChain.
+ *
+ * UChain is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <UChain/database/databases/chain_work_db.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <boost/filesystem.hpp>
+#include <UChain/coin.hpp>
+#include <UChain/database/memory/memory.hpp>
+
+namespace libbitcoin
+{
+namespace database
+{
+
+using namespace boost::filesystem;
+
+BC_CONSTEXPR size_t work_size = sizeof(uint64_t);
+
+chain_work_database::chain_work_database(const path &index_filename,
+                                         std::shared_ptr<shared_mutex> mutex)
+    : index_file_(index_filename, mutex),
+      index_manager_(index_file_, 0, work_size)
+{
+}
+
+// Close does not call stop because there is no way to detect thread join.
+chain_work_database::~chain_work_database()
+{
+    close();
+}
+
+// Create.
+// ----------------------------------------------------------------------------
+
+// Initialize files and start.
+bool chain_work_database::create()
+{
+    // Resize and create require a started file.
+    if (!index_file_.start())
+        return false;
+
+    // This will throw if insufficient disk space.
+    index_file_.resize(minimum_records_size);
+
+    if (!index_manager_.create())
+        return false;
+
+    // Should not call start after create, already started.
+    return index_manager_.start();
+}
+
+// Startup and shutdown.
+// ----------------------------------------------------------------------------
+
+bool chain_work_database::start()
+{
+    return index_file_.start() &&
+           index_manager_.start();
+}
+
+bool chain_work_database::stop()
+{
+    return index_file_.stop();
+}
+
+bool chain_work_database::close()
+{
+    return index_file_.close();
+}
+
+// Queries.
+// ----------------------------------------------------------------------------
+
+bool chain_work_database::get(uint64_t &out_work, size_t height) const
+{
+    if (height >= index_manager_.count())
+        return false;
+
+    const auto record = index_manager_.get(static_cast<array_index>(height));
+    out_work = from_little_endian_unsafe<uint64_t>(REMAP_ADDRESS(record));
+    return true;
+}
+
+// Store.
+// ----------------------------------------------------------------------------
+
+void chain_work_database::store(const chain::header &header, size_t height)
+{
+    const size_t count = index_manager_.count();
+
+    // A stale tail is dropped before the height is written again.
+    if (height < count)
+        index_manager_.set_count(static_cast<array_index>(height));
+    else if (height > count)
+        return;
+
+    uint64_t work = 0;
+    if (height > 0 && !get(work, height - 1))
+        return;
+
+    work += header_work(header);
+    const auto index = index_manager_.new_records(1);
+    const auto record = index_manager_.get(index);
+    auto serial = make_serializer(REMAP_ADDRESS(record));
+    serial.write_8_bytes_little_endian(work);
+}
+
+void chain_work_database::unlink(size_t from_height)
+{
+    if (from_height < index_manager_.count())
+        index_manager_.set_count(static_cast<array_index>(from_height));
+}
+
+void chain_work_database::sync()
+{
+    index_manager_.sync();
+}
+
+// The header carries no bits, blockchain::block_work counts the timestamp
+// and the two must be changed together.
+uint64_t chain_work_database::header_work(const chain::header &header)
+{
+    return header.timestamp;
+}
+
+} // namespace database
+} // namespace libbitcoin
@@ -0,0 +1,145 @@
+/**
+ * Copyright (c) 2018-2020 UChain core developers (check UC-AUTHORS)
+ *
+ * This file is part of UChain.
+ *
+ * UChain is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <UChain/database/databases/utxo_db.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <boost/filesystem.hpp>
+#include <UChain/coin.hpp>
+#include <UChain/database/memory/memory.hpp>
+
+namespace libbitcoin
+{
+namespace database
+{
+
+using namespace boost::filesystem;
+
+// The initial bucket count, the table grows with its keys.
+BC_CONSTEXPR size_t number_buckets = 1024;
+BC_CONSTEXPR size_t header_size = resizable_slab_hash_table_header_size(number_buckets);
+BC_CONSTEXPR size_t initial_map_file_size = header_size + minimum_slabs_size;
+
+BC_CONSTEXPR size_t height_size = sizeof(uint32_t);
+BC_CONSTEXPR size_t coinbase_size = sizeof(uint8_t);
+
+utxo_database::utxo_database(const path &map_filename,
+                             std::shared_ptr<shared_mutex> mutex)
+    : lookup_file_(map_filename, mutex),
+      lookup_header_(lookup_file_, number_buckets, true),
+      lookup_manager_(lookup_file_, header_size),
+      lookup_map_(lookup_header_, lookup_manager_)
+{
+}
+
+// Close does not call stop because there is no way to detect thread join.
+utxo_database::~utxo_database()
+{
+    close();
+}
+
+// Create.
+// ----------------------------------------------------------------------------
+
+// Initialize files and start.
+bool utxo_database::create()
+{
+    // Resize and create require a started file.
+    if (!lookup_file_.start())
+        return false;
+
+    // This will throw if insufficient disk space.
+    lookup_file_.resize(initial_map_file_size);
+
+    if (!lookup_header_.create() ||
+        !lookup_manager_.create())
+        return false;
+
+    // Should not call start after create, already started.
+    return lookup_header_.start() &&
+           lookup_manager_.start();
+}
+
+// Startup and shutdown.
+// ----------------------------------------------------------------------------
+
+// Start files and primitives.
+bool utxo_database::start()
+{
+    return lookup_file_.start() &&
+           lookup_header_.start() &&
+           lookup_manager_.start() &&
+           lookup_map_.start();
+}
+
+// Stop files.
+bool utxo_database::stop()
+{
+    return lookup_file_.stop();
+}
+
+// Close files.
+bool utxo_database::close()
+{
+    return lookup_file_.close();
+}
+
+// ----------------------------------------------------------------------------
+
+utxo_result utxo_database::get(const chain::output_point &outpoint) const
+{
+    const auto memory = lookup_map_.find(outpoint);
+    return utxo_result(memory);
+}
+
+void utxo_database::store(const chain::output_point &outpoint, size_t height,
+                          bool coinbase, const chain::output &output)
+{
+    BITCOIN_ASSERT(height <= max_uint32);
+    const auto hint = static_cast<uint32_t>(height);
+    const auto output_size = output.serialized_size();
+    BITCOIN_ASSERT(output_size <= max_size_t - height_size - coinbase_size);
+    const auto value_size = height_size + coinbase_size +
+                            static_cast<size_t>(output_size);
+
+    auto write = [&](memory_ptr data) {
+        auto serial = make_serializer(REMAP_ADDRESS(data));
+        serial.write_4_bytes_little_endian(hint);
+        serial.write_byte(coinbase ? 1 : 0);
+        serial.write_data(output.to_data());
+    };
+    lookup_map_.store(outpoint, write, value_size);
+}
+
+// Duplicate transaction hashes (BIP30) share one record, so a missing
+// record is not an error here. The slab is unlinked, not reclaimed.
+bool utxo_database::remove(const chain::output_point &outpoint)
+{
+    return lookup_map_.unlink(outpoint);
+}
+
+void utxo_database::sync()
+{
+    lookup_manager_.sync();
+}
+
+} // namespace database
+} // namespace libbitcoin
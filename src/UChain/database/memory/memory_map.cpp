@@ -66,6 +66,12 @@ using boost::filesystem::path;
 #define EXPANSION_NUMERATOR 150
 #define EXPANSION_DENOMINATOR 100
 
+#ifdef MEMORY_MAP_RESERVE
+// The address space reserved for each file, the file cannot grow beyond it.
+// This costs no memory, the reservation is neither readable nor committed.
+static constexpr size_t reserved_address_space = size_t(1) << 40;
+#endif
+
 size_t memory_map::file_size(int file_handle)
 {
     if (file_handle == -1)
@@ -255,7 +261,7 @@ bool memory_map::close()
 
     if (msync(data_, logical_size_, MS_SYNC) == -1)
         error_name = "msync";
-    else if (munmap(data_, file_size_) == -1)
+    else if (!unmap_all())
         error_name = "munmap";
     else if (ftruncate(file_handle_, logical_size_) == -1)
         error_name = "ftruncate";
@@ -301,7 +307,11 @@ size_t memory_map::size() const
 // throws runtime_error
 memory_ptr memory_map::access()
 {
+#ifdef REMAP_SAFETY
     return REMAP_ACCESSOR(data_, mutex_);
+#else
+    return data_;
+#endif
 }
 
 // throws runtime_error
@@ -326,7 +336,12 @@ memory_ptr memory_map::reserve(size_t size, size_t expansion)
 {
     // Critical Section (internal)
     ///////////////////////////////////////////////////////////////////////////
+#ifdef REMAP_SAFETY
     const auto memory = REMAP_ALLOCATOR(mutex_);
+#else
+    // Only writers lock, the mapping does not move under readers.
+    unique_lock lock(mutex_);
+#endif
 
     if (size > file_size_)
     {
@@ -340,9 +355,13 @@ memory_ptr memory_map::reserve(size_t size, size_t expansion)
     }
 
     logical_size_ = size;
-    REMAP_DOWNGRADE(memory, data_);
 
+#ifdef REMAP_SAFETY
+    REMAP_DOWNGRADE(memory, data_);
     return memory;
+#else
+    return data_;
+#endif
     ///////////////////////////////////////////////////////////////////////////
 }
 
@@ -376,20 +395,68 @@ bool memory_map::unmap()
     return success;
 }
 
+// Release the mapping along with any reservation beyond it.
+bool memory_map::unmap_all()
+{
+#ifdef MEMORY_MAP_RESERVE
+    return munmap(data_, reserved_address_space) != -1;
+#else
+    return munmap(data_, file_size_) != -1;
+#endif
+}
+
 bool memory_map::map(size_t size)
 {
     if (size == 0)
         return false;
 
+#ifdef MEMORY_MAP_RESERVE
+    if (size > reserved_address_space)
+        return false;
+
+    // Reserve the full range inaccessible, then map the file over its start.
+    const auto reserved = mmap(0, reserved_address_space, PROT_NONE,
+                               MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+
+    if (reserved == MAP_FAILED)
+    {
+        data_ = reinterpret_cast<uint8_t *>(MAP_FAILED);
+        return validate(size);
+    }
+
+    data_ = reinterpret_cast<uint8_t *>(mmap(reserved, size,
+                                             PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, file_handle_, 0));
+
+    if (data_ == MAP_FAILED)
+        munmap(reserved, reserved_address_space);
+#else
     data_ = reinterpret_cast<uint8_t *>(mmap(0, size, PROT_READ | PROT_WRITE,
                                              MAP_SHARED, file_handle_, 0));
+#endif
 
     return validate(size);
 }
 
 bool memory_map::remap(size_t size)
 {
-#ifdef MREMAP_MAYMOVE
+#ifdef MEMORY_MAP_RESERVE
+    if (size > reserved_address_space)
+        return false;
+
+    // Map the grown file tail in place over the reservation. The last
+    // partial page is mapped again at its own offset, so its content and
+    // address are unchanged for concurrent readers.
+    const auto page_size = page();
+    const auto start = (file_size_ / page_size) * page_size;
+    const auto tail = mmap(data_ + start, size - start, PROT_READ | PROT_WRITE,
+                           MAP_SHARED | MAP_FIXED, file_handle_, start);
+
+    if (tail == MAP_FAILED)
+        return false;
+
+    file_size_ = size;
+    return true;
+#elif defined(MREMAP_MAYMOVE)
     data_ = reinterpret_cast<uint8_t *>(mremap(data_, file_size_, size,
                                                MREMAP_MAYMOVE));
 
@@ -412,7 +479,7 @@ bool memory_map::truncate_mapped(size_t size)
     ///////////////////////////////////////////////////////////////////////////
     conditional_lock lock(remap_mutex_);
 
-#ifndef MREMAP_MAYMOVE
+#if !defined(MREMAP_MAYMOVE) && !defined(MEMORY_MAP_RESERVE)
     if (!unmap())
         return false;
 #endif
@@ -420,7 +487,7 @@ bool memory_map::truncate_mapped(size_t size)
     if (!truncate(size))
         return false;
 
-#ifndef MREMAP_MAYMOVE
+#if !defined(MREMAP_MAYMOVE) && !defined(MEMORY_MAP_RESERVE)
     return map(size);
 #else
     return remap(size);
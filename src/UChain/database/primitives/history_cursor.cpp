@@ -0,0 +1,103 @@
+/**
+ * Copyright (c) 2018-2020 UChain core developers (check UC-AUTHORS)
+ *
+ * This file is part of UChain.
+ *
+ * UChain is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <UChain/database/primitives/history_cursor.hpp>
+
+#include <cstdint>
+#include <string>
+#include <UChain/coin.hpp>
+#include <UChain/database/primitives/record_list.hpp>
+
+namespace libbitcoin
+{
+namespace database
+{
+
+// No row is stored at the maximum height, so it sorts before every row.
+static constexpr uint32_t head_height = max_uint32;
+static constexpr size_t cursor_size = sizeof(uint32_t) + hash_size +
+                                      sizeof(array_index) + short_hash_size;
+
+history_cursor::history_cursor()
+    : history_cursor(head_height, null_hash, record_list::empty,
+                     null_short_hash)
+{
+}
+
+history_cursor::history_cursor(uint32_t height, const hash_digest &hash,
+                               array_index row, const short_hash &key)
+    : height_(height), hash_(hash), row_(row), key_(key)
+{
+}
+
+bool history_cursor::is_head() const
+{
+    return height_ == head_height;
+}
+
+bool history_cursor::follows(uint32_t height, const hash_digest &hash) const
+{
+    if (is_head())
+        return true;
+
+    return height < height_ || (height == height_ && hash < hash_);
+}
+
+uint32_t history_cursor::height() const
+{
+    return height_;
+}
+
+const hash_digest &history_cursor::hash() const
+{
+    return hash_;
+}
+
+array_index history_cursor::row(const short_hash &key) const
+{
+    return key == key_ ? row_ : record_list::empty;
+}
+
+std::string history_cursor::encoded() const
+{
+    data_chunk data(cursor_size);
+    auto serial = make_serializer(data.begin());
+    serial.write_4_bytes_little_endian(height_);
+    serial.write_hash(hash_);
+    serial.write_4_bytes_little_endian(row_);
+    serial.write_short_hash(key_);
+    return encode_base16(data);
+}
+
+bool history_cursor::from_string(const std::string &text)
+{
+    data_chunk data;
+    if (!decode_base16(data, text) || data.size() != cursor_size)
+        return false;
+
+    auto deserial = make_deserializer(data.begin(), data.end());
+    height_ = deserial.read_4_bytes_little_endian();
+    hash_ = deserial.read_hash();
+    row_ = deserial.read_4_bytes_little_endian();
+    key_ = deserial.read_short_hash();
+    return true;
+}
+
+} // namespace database
+} // namespace libbitcoin
@@ -20,6 +20,7 @@
  */
 #include <UChain/database/primitives/record_list.hpp>
 
+#include <algorithm>
 #include <cstdint>
 #include <UChain/coin.hpp>
 #include <UChain/database/memory/memory.hpp>
@@ -31,6 +32,10 @@ namespace database
 
 // std::numeric_limits<array_index>::max()
 const array_index record_list::empty = bc::max_uint32;
+const array_index record_list::unused = bc::max_uint32 - 1;
+
+// The limit of the block doubling, in records.
+static constexpr size_t maximum_block_size = 16;
 
 record_list::record_list(record_manager &manager)
     : manager_(manager)
@@ -45,19 +50,47 @@ array_index record_list::create()
     return insert(empty);
 }
 
+// A block is filled in order, so a free record after the head is in its block.
 array_index record_list::insert(array_index index)
 {
-    // Create new record and return its index.
-    auto new_index = manager_.new_records(1);
-    const auto memory = manager_.get(new_index);
-    auto serial = make_serializer(REMAP_ADDRESS(memory));
-    //*************************************************************************
-    serial.template write_little_endian<array_index>(index);
-    //*************************************************************************
+    if (index != empty && index + 1 < manager_.count() &&
+        read_next(index + 1) == unused)
+    {
+        write_next(index + 1, index);
+        return index + 1;
+    }
+
+    // Create new block and return the index of its first record.
+    const auto size = block_size(index);
+    const auto new_index = manager_.new_records(size);
+
+    for (size_t offset = 1; offset < size; ++offset)
+        write_next(new_index + offset, unused);
+
+    write_next(new_index, index);
     return new_index;
 }
 
+bool record_list::in_use(array_index index) const
+{
+    return index < manager_.count() && read_next(index) != unused;
+}
+
 array_index record_list::next(array_index index) const
+{
+    return read_next(index);
+}
+
+const memory_ptr record_list::get(array_index index) const
+{
+    auto memory = manager_.get(index);
+    REMAP_INCREMENT(memory, sizeof(array_index));
+    return memory;
+}
+
+// privates
+
+array_index record_list::read_next(array_index index) const
 {
     const auto memory = manager_.get(index);
     const auto next_address = REMAP_ADDRESS(memory);
@@ -66,11 +99,28 @@ array_index record_list::next(array_index index) const
     //*************************************************************************
 }
 
-const memory_ptr record_list::get(array_index index) const
+void record_list::write_next(array_index index, array_index next)
 {
-    auto memory = manager_.get(index);
-    REMAP_INCREMENT(memory, sizeof(array_index));
-    return memory;
+    const auto memory = manager_.get(index);
+    auto serial = make_serializer(REMAP_ADDRESS(memory));
+    //*************************************************************************
+    serial.template write_little_endian<array_index>(next);
+    //*************************************************************************
+}
+
+// The filled block is the run of records each linked to the one before it.
+size_t record_list::block_size(array_index index) const
+{
+    if (index == empty)
+        return 1;
+
+    size_t filled = 1;
+    for (auto record = index; filled < maximum_block_size && record > 0 &&
+                              read_next(record) == record - 1;
+         --record)
+        ++filled;
+
+    return std::min(2 * filled, maximum_block_size);
 }
 
 } // namespace database
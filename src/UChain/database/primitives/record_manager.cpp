@@ -141,6 +141,14 @@ array_index record_manager::new_records(size_t count)
     ///////////////////////////////////////////////////////////////////////////
 }
 
+// Hash table segments are not records, they are spread across whole records.
+file_offset record_manager::new_segment(size_t size)
+{
+    const auto count = (size + record_size_ - 1) / record_size_;
+    const auto first = new_records(count);
+    return header_size_ + record_to_position(first);
+}
+
 const memory_ptr record_manager::get(array_index record) const
 {
     // If record >= count() then we should still be within the file. The
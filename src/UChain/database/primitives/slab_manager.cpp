@@ -127,6 +127,12 @@ file_offset slab_manager::new_slab(size_t size)
     ///////////////////////////////////////////////////////////////////////////
 }
 
+// The slab position is relative to the header, this returns the absolute.
+file_offset slab_manager::new_segment(size_t size)
+{
+    return header_size_ + new_slab(size);
+}
+
 // Position is offset by header but not size storage (embedded in data files).
 const memory_ptr slab_manager::get(file_offset position) const
 {
@@ -0,0 +1,70 @@
+/**
+ * Copyright (c) 2018-2020 UChain core developers (check UC-AUTHORS)
+ *
+ * This file is part of UChain.
+ *
+ * UChain is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <UChain/database/result/utxo_result.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <UChain/coin.hpp>
+#include <UChain/database/memory/memory.hpp>
+
+namespace libbitcoin
+{
+namespace database
+{
+
+static constexpr size_t height_size = sizeof(uint32_t);
+static constexpr size_t coinbase_size = sizeof(uint8_t);
+
+utxo_result::utxo_result(const memory_ptr slab)
+    : slab_(slab)
+{
+}
+
+utxo_result::operator bool() const
+{
+    return slab_ != nullptr;
+}
+
+size_t utxo_result::height() const
+{
+    BITCOIN_ASSERT(slab_);
+    const auto memory = REMAP_ADDRESS(slab_);
+    return from_little_endian_unsafe<uint32_t>(memory);
+}
+
+bool utxo_result::is_coinbase() const
+{
+    BITCOIN_ASSERT(slab_);
+    const auto memory = REMAP_ADDRESS(slab_);
+    return *(memory + height_size) != 0;
+}
+
+chain::output utxo_result::output() const
+{
+    BITCOIN_ASSERT(slab_);
+    const auto memory = REMAP_ADDRESS(slab_);
+    chain::output out;
+    auto deserial = make_deserializer_unsafe(memory + height_size + coinbase_size);
+    out.from_data(deserial);
+    return out;
+}
+
+} // namespace database
+} // namespace libbitcoin
@@ -135,6 +135,16 @@ console_result dispatch_command(int argc, const char *argv[],
 console_result dispatch_command(int argc, const char *argv[],
                                 Json::Value &jv_output,
                                 libbitcoin::server::server_node &node, uint8_t api_version)
+{
+    const auto command = parse_command(argc, argv, jv_output, node);
+    if (!command)
+        return console_result::okay;
+
+    return invoke_command(*command, jv_output, node, api_version);
+}
+
+std::shared_ptr<command> parse_command(int argc, const char *argv[],
+                                       Json::Value &jv_output, libbitcoin::server::server_node &node)
 {
     std::istringstream input;
     std::ostringstream output;
@@ -165,16 +175,24 @@ console_result dispatch_command(int argc, const char *argv[],
     {
         command->write_help(output);
         jv_output = output.str();
-        return console_result::okay;
+        return nullptr;
     }
 
-    command->set_api_version(api_version);
+    return command;
+}
+
+console_result invoke_command(command &command, Json::Value &jv_output,
+                              libbitcoin::server::server_node &node, uint8_t api_version)
+{
+    std::ostringstream output;
+
+    command.set_api_version(api_version);
 
-    if (command->category(ctgy_extension))
+    if (command.category(ctgy_extension))
     {
         // fixme. is_blockchain_sync has some problem.
         // if (command->category(ctgy_online) && node.is_blockchain_sync()) {
-        if (command->category(ctgy_online) &&
+        if (command.category(ctgy_online) &&
             !node.chain_impl().chain_settings().use_testnet_rules)
         {
             uint64_t height{0};
@@ -184,12 +202,12 @@ console_result dispatch_command(int argc, const char *argv[],
             }*/
         }
 
-        return static_cast<commands::command_extension *>(command.get())->invoke(jv_output, node);
+        return static_cast<commands::command_extension &>(command).invoke(jv_output, node);
     }
     else
     {
-        command->set_api_version(1); // only compatible for v1
-        auto retcode = command->invoke(output, output);
+        command.set_api_version(1); // only compatible for v1
+        auto retcode = command.invoke(output, output);
         jv_output = output.str();
         return retcode;
     }
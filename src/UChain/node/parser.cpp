@@ -216,6 +216,9 @@ options_metadata parser::load_settings()
             "blockchain.tx_pool_capacity",
             value<uint32_t>(&configured.chain.tx_pool_capacity),
             "The maximum number of transactions in the pool, defaults to 2000.")(
+            "blockchain.script_cache_capacity",
+            value<uint32_t>(&configured.chain.script_cache_capacity),
+            "The maximum number of verified input scripts to remember, defaults to 200000.")(
             "blockchain.tx_pool_consistency",
             value<bool>(&configured.chain.tx_pool_consistency),
             "Enforce consistency between the pool and the blockchain, defaults to false.")(
@@ -157,6 +157,36 @@ bool executor::do_initchain()
 
     if (ec.value() == directory_exists)
     {
+        if (!data_base::upgrade_utxos(data_path))
+        {
+            throw std::runtime_error{" upgrade utxo database failed!"};
+        }
+
+        if (!data_base::upgrade_balances(data_path))
+        {
+            throw std::runtime_error{" upgrade address balance database failed!"};
+        }
+
+        if (!data_base::upgrade_uid_addresses(data_path))
+        {
+            throw std::runtime_error{" upgrade uid address index failed!"};
+        }
+
+        if (!data_base::upgrade_wallet_history(data_path))
+        {
+            throw std::runtime_error{" upgrade wallet history timeline failed!"};
+        }
+
+        if (!data_base::upgrade_candidate_votes(data_path))
+        {
+            throw std::runtime_error{" upgrade candidate vote tally failed!"};
+        }
+
+        if (!data_base::upgrade_chain_work(data_path))
+        {
+            throw std::runtime_error{" upgrade chain work index failed!"};
+        }
+
         return false;
     }
 
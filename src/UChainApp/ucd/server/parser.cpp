@@ -222,6 +222,9 @@ options_metadata parser::load_settings()
             "blockchain.tx_pool_capacity",
             value<uint32_t>(&configured.chain.tx_pool_capacity),
             "The maximum number of transactions in the pool, defaults to 2000.")(
+            "blockchain.script_cache_capacity",
+            value<uint32_t>(&configured.chain.script_cache_capacity),
+            "The maximum number of verified input scripts to remember, defaults to 200000.")(
             "blockchain.tx_pool_consistency",
             value<bool>(&configured.chain.tx_pool_consistency),
             "Enforce consistency between the pool and the blockchain, defaults to false.")(
@@ -261,6 +264,9 @@ options_metadata parser::load_settings()
             "server.query_workers",
             value<uint16_t>(&configured.server.query_workers),
             "The number of query worker threads per endpoint, defaults to 1.")(
+            "server.rpc_workers",
+            value<uint16_t>(&configured.server.rpc_workers),
+            "The number of Json-RPC worker threads, defaults to 0 (one per core).")(
             "server.heartbeat_interval_seconds",
             value<uint32_t>(&configured.server.heartbeat_interval_seconds),
             "The heartbeat interval, defaults to 5.")(
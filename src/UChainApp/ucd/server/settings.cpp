@@ -30,6 +30,7 @@ using namespace asio;
 
 settings::settings()
     : query_workers(1),
+      rpc_workers(0),
       heartbeat_interval_seconds(5),
       subscription_expiration_minutes(10),
       subscription_limit(100000000),
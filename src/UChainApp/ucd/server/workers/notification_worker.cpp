@@ -308,7 +308,7 @@ void notification_worker::send_address(const route &reply_to, uint32_t id,
 bool notification_worker::handle_payment(const code &ec,
                                          const payment_address &address, uint32_t height,
                                          const hash_digest &block_hash, const chain::transaction &tx,
-                                         const route &reply_to, uint32_t id, const binary &prefix_filter)
+                                         const route &reply_to, uint32_t id)
 {
     if (ec)
     {
@@ -316,16 +316,14 @@ bool notification_worker::handle_payment(const code &ec,
         return false;
     }
 
-    if (prefix_filter.is_prefix_of(address.hash()))
-        send_payment(reply_to, id, address, height, block_hash, tx);
-
+    // The subscriber only relays addresses that match the prefix filter.
+    send_payment(reply_to, id, address, height, block_hash, tx);
     return true;
 }
 
 bool notification_worker::handle_stealth(const code &ec,
                                          uint32_t prefix, uint32_t height, const hash_digest &block_hash,
-                                         const chain::transaction &tx, const route &reply_to, uint32_t id,
-                                         const binary &prefix_filter)
+                                         const chain::transaction &tx, const route &reply_to, uint32_t id)
 {
     if (ec)
     {
@@ -333,16 +331,15 @@ bool notification_worker::handle_stealth(const code &ec,
         return false;
     }
 
-    if (prefix_filter.is_prefix_of(prefix))
-        send_stealth(reply_to, id, prefix, height, block_hash, tx);
-
+    // The subscriber only relays prefixes that match the prefix filter.
+    send_stealth(reply_to, id, prefix, height, block_hash, tx);
     return true;
 }
 
 bool notification_worker::handle_address(const code &ec,
                                          const binary &field, uint32_t height, const hash_digest &block_hash,
                                          const chain::transaction &tx, const route &reply_to, uint32_t id,
-                                         const binary &prefix_filter, sequence_ptr sequence)
+                                         sequence_ptr sequence)
 {
     if (ec)
     {
@@ -350,12 +347,9 @@ bool notification_worker::handle_address(const code &ec,
         return false;
     }
 
-    if (prefix_filter.is_prefix_of(field))
-    {
-        send_address(reply_to, id, *sequence, height, block_hash, tx);
-        ++(*sequence);
-    }
-
+    // The subscriber only relays fields that match the prefix filter.
+    send_address(reply_to, id, *sequence, height, block_hash, tx);
+    ++(*sequence);
     return true;
 }
 
@@ -369,7 +363,6 @@ void notification_worker::subscribe_address(const route &reply_to, uint32_t id,
 {
     static const auto error_code = error::channel_stopped;
     const auto &duration = settings_.subscription_expiration();
-    const address_key key(reply_to, prefix_filter);
 
     switch (type)
     {
@@ -379,10 +372,10 @@ void notification_worker::subscribe_address(const route &reply_to, uint32_t id,
         // This class must be kept in scope until work is terminated.
         const auto handler =
             std::bind(&notification_worker::handle_payment,
-                      this, _1, _2, _3, _4, _5, reply_to, id, prefix_filter);
+                      this, _1, _2, _3, _4, _5, reply_to, id);
 
-        payment_subscriber_->subscribe(handler, key, duration, error_code,
-                                       {}, 0, {}, {});
+        payment_subscriber_->subscribe(handler, reply_to, prefix_filter,
+                                       duration, error_code, {}, 0, {}, {});
         break;
     }
 
@@ -392,10 +385,10 @@ void notification_worker::subscribe_address(const route &reply_to, uint32_t id,
         // This class must be kept in scope until work is terminated.
         const auto handler =
             std::bind(&notification_worker::handle_stealth,
-                      this, _1, _2, _3, _4, _5, reply_to, id, prefix_filter);
+                      this, _1, _2, _3, _4, _5, reply_to, id);
 
-        stealth_subscriber_->subscribe(handler, key, duration, error_code,
-                                       0, 0, {}, {});
+        stealth_subscriber_->subscribe(handler, reply_to, prefix_filter,
+                                       duration, error_code, 0, 0, {}, {});
         break;
     }
 
@@ -408,12 +401,11 @@ void notification_worker::subscribe_address(const route &reply_to, uint32_t id,
         // This class must be kept in scope until work is terminated.
         const auto handler =
             std::bind(&notification_worker::handle_address,
-                      this, _1, _2, _3, _4, _5, reply_to, id, prefix_filter,
-                      sequence);
+                      this, _1, _2, _3, _4, _5, reply_to, id, sequence);
 
         // v3
-        address_subscriber_->subscribe(handler, key, duration, error_code,
-                                       {}, 0, {}, {});
+        address_subscriber_->subscribe(handler, reply_to, prefix_filter,
+                                       duration, error_code, {}, 0, {}, {});
         break;
     }
 
@@ -427,7 +419,8 @@ void notification_worker::subscribe_address(const route &reply_to, uint32_t id,
         // opposed to error::channel_timeout.
 
         // v3
-        address_subscriber_->unsubscribe(key, error_code, {}, 0, {}, {});
+        address_subscriber_->unsubscribe(reply_to, prefix_filter, error_code,
+                                         {}, 0, {}, {});
         break;
     }
     }
@@ -582,80 +575,73 @@ bool notification_worker::handle_tx_pool(const code &ec,
     return true;
 }
 
-// This parsing is duplicated by bc::database::data_base.
+// The decoded scripts are shared with bc::database::data_base.
 void notification_worker::notify_transaction(uint32_t height,
                                              const hash_digest &block_hash, const transaction &tx)
 {
-    uint32_t prefix;
-
     // TODO: move full integer and array constructors into binary.
-    static constexpr size_t prefix_bits = sizeof(prefix) * byte_bits;
+    static constexpr size_t prefix_bits = sizeof(uint32_t) * byte_bits;
     static constexpr size_t address_bits = short_hash_size * byte_bits;
 
     if (stopped() || tx.outputs.empty())
         return;
 
+    const auto decoded = tx.decoded();
+
     // see data_base::push_inputs
-    // Loop inputs and extract payment addresses.
-    for (const auto &input : tx.inputs)
+    // Loop inputs and notify payment addresses.
+    for (const auto &input : decoded->inputs)
     {
-        const auto address = payment_address::extract(input.script);
-
-        if (address)
+        if (input.address)
         {
-            const binary field(address_bits, address.hash());
+            const binary field(address_bits, input.address.hash());
             notify_address(field, height, block_hash, tx);
-            notify_payment(address, height, block_hash, tx);
+            notify_payment(field, input.address, height, block_hash, tx);
         }
     }
 
     // see data_base::push_outputs
-    // Loop outputs and extract payment addresses.
-    for (const auto &output : tx.outputs)
+    // Loop outputs and notify payment addresses.
+    for (const auto &output : decoded->outputs)
     {
-        const auto address = payment_address::extract(output.script);
-
-        if (address)
+        if (output.address)
         {
-            const binary field(address_bits, address.hash());
+            const binary field(address_bits, output.address.hash());
             notify_address(field, height, block_hash, tx);
-            notify_payment(address, height, block_hash, tx);
+            notify_payment(field, output.address, height, block_hash, tx);
         }
     }
 
     // see data_base::push_stealth
-    // Loop output pairs and extract stealth payments.
-    for (size_t index = 0; index < (tx.outputs.size() - 1); ++index)
+    // Loop output pairs and notify stealth payments.
+    for (size_t index = 0; index < decoded->outputs.size(); ++index)
     {
-        const auto &ephemeral_script = tx.outputs[index].script;
-        const auto &payment_script = tx.outputs[index + 1].script;
-
-        // Try to extract a stealth prefix from the first output.
-        // Try to extract the payment address from the second output.
-        if (to_stealth_prefix(prefix, ephemeral_script) &&
-            payment_address::extract(payment_script))
+        if (decoded->is_stealth_payment(index))
         {
+            const auto prefix = decoded->outputs[index].stealth_prefix;
             const binary field(prefix_bits, to_little_endian(prefix));
             notify_address(field, height, block_hash, tx);
-            notify_stealth(prefix, height, block_hash, tx);
+            notify_stealth(field, prefix, height, block_hash, tx);
         }
     }
 }
 
 // v2/v3 (deprecated)
-void notification_worker::notify_payment(const payment_address &address,
-                                         uint32_t height, const hash_digest &block_hash, const transaction &tx)
+void notification_worker::notify_payment(const binary &field,
+                                         const payment_address &address, uint32_t height,
+                                         const hash_digest &block_hash, const transaction &tx)
 {
     static const auto code = error::success;
-    payment_subscriber_->relay(code, address, height, block_hash, tx);
+    payment_subscriber_->relay(field, code, address, height, block_hash, tx);
 }
 
 // v2/v3 (deprecated)
-void notification_worker::notify_stealth(uint32_t prefix, uint32_t height,
+void notification_worker::notify_stealth(const binary &field,
+                                         uint32_t prefix, uint32_t height,
                                          const hash_digest &block_hash, const transaction &tx)
 {
     static const auto code = error::success;
-    stealth_subscriber_->relay(code, prefix, height, block_hash, tx);
+    stealth_subscriber_->relay(field, code, prefix, height, block_hash, tx);
 }
 
 // v3
@@ -663,7 +649,7 @@ void notification_worker::notify_address(const binary &field, uint32_t height,
                                          const hash_digest &block_hash, const transaction &tx)
 {
     static const auto code = error::success;
-    address_subscriber_->relay(code, field, height, block_hash, tx);
+    address_subscriber_->relay(field, code, field, height, block_hash, tx);
 }
 
 // v3.x
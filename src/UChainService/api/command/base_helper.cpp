@@ -294,17 +294,16 @@ void sync_fetch_token_cert_balance(const std::string &address, const string &sym
                                    std::shared_ptr<token_cert::list> sh_vec,
                                    token_cert_type cert_type)
 {
-    chain::transaction tx_temp;
-    uint64_t tx_height;
+    chain::output output;
+    uint64_t output_height;
+    bool coinbase;
 
     auto &&rows = blockchain.get_address_history(bc::wallet::payment_address(address));
     for (auto &row : rows)
     {
         // spend unconfirmed (or no spend attempted)
-        if ((row.spend.hash == null_hash) && blockchain.get_transaction(row.output.hash, tx_temp, tx_height))
+        if ((row.spend.hash == null_hash) && blockchain.get_utxo(row.output, output, output_height, coinbase))
         {
-            BITCOIN_ASSERT(row.output.index < tx_temp.outputs.size());
-            const auto &output = tx_temp.outputs.at(row.output.index);
             if (output.get_script_address() != address)
             {
                 continue;
@@ -333,8 +332,9 @@ void sync_fetch_token_balance(const std::string &address, bool sum_all,
 {
     auto &&rows = blockchain.get_address_history(bc::wallet::payment_address(address), start_height);
 
-    chain::transaction tx_temp;
-    uint64_t tx_height;
+    chain::output output;
+    uint64_t output_height;
+    bool coinbase;
     uint64_t height = 0;
     blockchain.get_last_height(height);
     if (end_height == 0)
@@ -344,16 +344,14 @@ void sync_fetch_token_balance(const std::string &address, bool sum_all,
 
     for (auto &row : rows)
     {
-        // spend unconfirmed (or no spend attempted)
-        if ((row.spend.hash == null_hash) && blockchain.get_transaction(row.output.hash, tx_temp, tx_height))
+        if (row.output_height > end_height)
         {
-            if (row.output_height > end_height)
-            {
-                continue;
-            }
+            continue;
+        }
 
-            BITCOIN_ASSERT(row.output.index < tx_temp.outputs.size());
-            const auto &output = tx_temp.outputs.at(row.output.index);
+        // spend unconfirmed (or no spend attempted)
+        if ((row.spend.hash == null_hash) && blockchain.get_utxo(row.output, output, output_height, coinbase))
+        {
             if (output.get_script_address() != address)
             {
                 continue;
@@ -402,18 +400,17 @@ void sync_fetch_token_deposited_balance(const std::string &address,
 {
     auto &&rows = blockchain.get_address_history(bc::wallet::payment_address(address));
 
-    chain::transaction tx_temp;
-    uint64_t tx_height;
+    chain::output output;
+    uint64_t output_height;
+    bool coinbase;
     uint64_t height = 0;
     blockchain.get_last_height(height);
 
     for (auto &row : rows)
     {
         // spend unconfirmed (or no spend attempted)
-        if ((row.spend.hash == null_hash) && blockchain.get_transaction(row.output.hash, tx_temp, tx_height))
+        if ((row.spend.hash == null_hash) && blockchain.get_utxo(row.output, output, output_height, coinbase))
         {
-            BITCOIN_ASSERT(row.output.index < tx_temp.outputs.size());
-            const auto &output = tx_temp.outputs.at(row.output.index);
             if (output.is_token())
             {
                 if (!operation::is_pay_key_hash_with_attenuation_model_pattern(output.script.operations))
@@ -731,66 +728,22 @@ void sync_fetch_deposited_balance(bc::wallet::payment_address &address,
 void sync_fetchbalance(bc::wallet::payment_address &address,
                        bc::blockchain::block_chain_impl &blockchain, balances &addr_balance)
 {
-    auto &&rows = blockchain.get_address_history(address, false);
-
-    uint64_t total_received = 0;
-    uint64_t confirmed_balance = 0;
-    uint64_t unspent_balance = 0;
-    uint64_t frozen_balance = 0;
+    const auto address_str = address.encoded();
+    const auto totals = blockchain.get_address_balance(address_str);
 
-    chain::transaction tx_temp;
-    uint64_t tx_height;
     uint64_t height = 0;
     blockchain.get_last_height(height);
 
-    for (auto &row : rows)
+    // frozen outputs can not be spent, so they are all unspent
+    uint64_t frozen_balance = 0;
+    for (const auto &row : blockchain.get_address_frozen(address_str, height))
     {
-        /*if (row.output_height == 0) {
-            continue;
-        }*/
-
-        // spend unconfirmed (or no spend attempted)
-        if ((row.spend.hash == null_hash) && blockchain.get_transaction(row.output.hash, tx_temp, tx_height))
-        {
-            BITCOIN_ASSERT(row.output.index < tx_temp.outputs.size());
-            auto output = tx_temp.outputs.at(row.output.index);
-            if (output.get_script_address() != address.encoded())
-            {
-                continue;
-            }
-
-            if (chain::operation::is_pay_key_hash_with_lock_height_pattern(output.script.operations))
-            {
-                // deposit utxo in block
-                uint64_t lock_height = chain::operation::
-                    get_lock_height_from_pay_key_hash_with_lock_height(output.script.operations);
-                if ((row.output_height + lock_height) > height)
-                {
-                    // utxo already in block but deposit not expire
-                    frozen_balance += row.value;
-                }
-            }
-            else if (tx_temp.is_coinbase())
-            { // coin base ucn maturity ucn check
-                // add not coinbase_maturity ucn into frozen
-                if ((row.output_height + coinbase_maturity) > height)
-                {
-                    frozen_balance += row.value;
-                }
-            }
-
-            unspent_balance += row.value;
-        }
-
-        total_received += row.value;
-
-        if ((row.spend.hash == null_hash || row.spend_height == 0))
-            confirmed_balance += row.value;
+        frozen_balance += row.value;
     }
 
-    addr_balance.confirmed_balance = confirmed_balance;
-    addr_balance.total_received = total_received;
-    addr_balance.unspent_balance = unspent_balance;
+    addr_balance.confirmed_balance = totals.unspent_balance;
+    addr_balance.total_received = totals.total_received;
+    addr_balance.unspent_balance = totals.unspent_balance;
     addr_balance.frozen_balance = frozen_balance;
 }
 
@@ -803,16 +756,13 @@ bool base_transfer_common::get_spendable_output(
         return false;
     }
 
-    chain::transaction tx_temp;
-    uint64_t tx_height;
-    if (!blockchain_.get_transaction(row.output.hash, tx_temp, tx_height))
+    uint64_t output_height;
+    bool coinbase;
+    if (!blockchain_.get_utxo(row.output, output, output_height, coinbase))
     {
         return false;
     }
 
-    BITCOIN_ASSERT(row.output.index < tx_temp.outputs.size());
-    output = tx_temp.outputs.at(row.output.index);
-
     if (chain::operation::is_pay_key_hash_with_lock_height_pattern(output.script.operations))
     {
         if (row.output_height == 0)
@@ -1555,6 +1505,11 @@ void base_transfer_helper::populate_unspent_list()
         throw tx_source_exception{"from address cannot be multi-signed. "};
     }
 
+    // Keys of an unlocked wallet come from its session, the others are
+    // decrypted with a key schedule expanded once for all addresses.
+    const auto keyring = blockchain_.get_wallet_keyring(name_, passwd_);
+    aes256_key key(passphrase_secret(passwd_));
+
     // get from address balances
     for (auto &each : *pvaddr)
     {
@@ -1565,7 +1520,15 @@ void base_transfer_helper::populate_unspent_list()
             continue;
         }
 
-        const auto priv_key = each.get_prv_key(passwd_);
+        std::string priv_key;
+        const auto copy = [&priv_key](const char *data, size_t size) {
+            priv_key.assign(data, size);
+        };
+
+        if (!keyring || !keyring->find(address, copy))
+        {
+            priv_key = each.get_prv_key(key);
+        }
 
         if (from_.empty())
         {
@@ -2341,14 +2304,14 @@ void sending_multisig_uid::populate_unspent_list()
         if (fromfee == each.get_address())
         {
             // pay fee
-            sync_fetchutxo(each.get_prv_key(passwd_), each.get_address(), FILTER_UCN);
+            sync_fetchutxo(blockchain_.get_wallet_prv_key(each, passwd_), each.get_address(), FILTER_UCN);
             check_payment_satisfied(FILTER_UCN);
         }
 
         if (from_ == each.get_address())
         {
             // pay uid
-            sync_fetchutxo(each.get_prv_key(passwd_), each.get_address(), FILTER_UID);
+            sync_fetchutxo(blockchain_.get_wallet_prv_key(each, passwd_), each.get_address(), FILTER_UID);
             check_payment_satisfied(FILTER_UID);
         }
 
@@ -2403,14 +2366,14 @@ void sending_uid::populate_unspent_list()
         if (fromfee == each.get_address())
         {
             // pay fee
-            sync_fetchutxo(each.get_prv_key(passwd_), each.get_address(), FILTER_UCN);
+            sync_fetchutxo(blockchain_.get_wallet_prv_key(each, passwd_), each.get_address(), FILTER_UCN);
             check_payment_satisfied(FILTER_UCN);
         }
 
         if (from_ == each.get_address())
         {
             // pay uid
-            sync_fetchutxo(each.get_prv_key(passwd_), each.get_address(), FILTER_UID);
+            sync_fetchutxo(blockchain_.get_wallet_prv_key(each, passwd_), each.get_address(), FILTER_UID);
             check_payment_satisfied(FILTER_UID);
         }
 
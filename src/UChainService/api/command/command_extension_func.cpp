@@ -84,6 +84,8 @@
 #include <UChainService/api/command/commands/submitwork.hpp>
 #include <UChainService/api/command/commands/setminingwallet.hpp>
 #include <UChainService/api/command/commands/changepass.hpp>
+#include <UChainService/api/command/commands/unlockwallet.hpp>
+#include <UChainService/api/command/commands/lockwallet.hpp>
 #include <UChainService/api/command/commands/showtxpool.hpp>
 #include <UChainService/api/command/commands/createmultisigtx.hpp>
 #include <UChainService/api/command/commands/createrawtx.hpp>
@@ -128,6 +130,8 @@ void broadcast_extension(const function<void(shared_ptr<command>)> func, std::os
     func(make_shared<deletewallet>());
     func(make_shared<importwallet>());
     func(make_shared<changepass>());
+    func(make_shared<unlockwallet>());
+    func(make_shared<lockwallet>());
     func(make_shared<addaddress>());
     func(make_shared<validateaddress>());
     func(make_shared<showaddresses>());
@@ -230,6 +234,10 @@ shared_ptr<command> find_extension(const string &symbol)
         return make_shared<deletewallet>();
     if (symbol == changepass::symbol())
         return make_shared<changepass>();
+    if (symbol == unlockwallet::symbol())
+        return make_shared<unlockwallet>();
+    if (symbol == lockwallet::symbol())
+        return make_shared<lockwallet>();
     if (symbol == validateaddress::symbol())
         return make_shared<validateaddress>();
     if (symbol == addaddress::symbol())
@@ -411,7 +419,7 @@ bool check_read_only(const string &symbol)
                                                sendtokento::symbol(), "uidsendtokento", sendtokenfrom::symbol(), "uidsendtokenfrom", destroy::symbol(), vote::symbol(),
                                                registercandidate::symbol(), transfercandidate::symbol(), registeruid::symbol(), transferuid::symbol(), checkwalletinfo::symbol(),
                                                showaddresses::symbol(), showbalances::symbol(), showbalance::symbol(), showwallettoken::symbol(), decoderawtx::symbol(),
-                                               checkpublickey::symbol()};
+                                               checkpublickey::symbol(), unlockwallet::symbol(), lockwallet::symbol()};
     auto it = std::find(limit_command.begin(), limit_command.end(), symbol);
     if (it != limit_command.end())
     {
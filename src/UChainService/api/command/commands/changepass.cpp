@@ -50,11 +50,13 @@ console_result changepass::invoke(Json::Value &jv_output,
     if (!pvaddr)
         throw address_list_nullptr_exception{"empty address list"};
 
+    aes256_key old_key(passphrase_secret(auth_.auth));
+    aes256_key new_key(passphrase_secret(option_.passwd));
     std::string prv_key;
     for (auto &each : *pvaddr)
     {
-        prv_key = each.get_prv_key(auth_.auth);
-        each.set_prv_key(prv_key, option_.passwd);
+        prv_key = each.get_prv_key(old_key);
+        each.set_prv_key(prv_key, new_key);
     }
     // delete all old address
     blockchain.delete_wallet_address(auth_.name);
@@ -97,11 +97,12 @@ console_result createmultisigaddress::invoke(
         throw address_list_nullptr_exception{"nullptr for address list"};
     }
 
+    aes256_key key(passphrase_secret(auth_.auth));
     std::string self_prvkey;
     auto found = false;
     for (auto &each : *pvaddr)
     {
-        self_prvkey = each.get_prv_key(auth_.auth);
+        self_prvkey = each.get_prv_key(key);
         auto &&target_pub_key = ec_to_xxx_impl("ec-to-public", self_prvkey);
         if (target_pub_key == self_pubkey)
         {
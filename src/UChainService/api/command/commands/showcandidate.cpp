@@ -89,6 +89,28 @@ console_result showcandidate::invoke(Json::Value &jv_output,
             jv_output = json_value;
         }
     }
+    else if (!option_.cursor.empty())
+    {
+        database::history_cursor cursor;
+        if (option_.cursor != "head" && !cursor.from_string(option_.cursor))
+        {
+            throw argument_legality_exception{"invalid cursor parameter"};
+        }
+
+        auto sh_vec = blockchain.get_candidate_history(argument_.symbol, cursor, option_.limit);
+        for (auto &elem : *sh_vec)
+        {
+            Json::Value token_data = json_helper.prop_list(elem);
+            json_value.append(token_data);
+        }
+
+        if (json_value.isNull())
+            json_value.resize(0);
+
+        // a full page continues after its last record
+        jv_output["candidates"] = json_value;
+        jv_output["next_cursor"] = sh_vec->size() == option_.limit ? cursor.encoded() : "";
+    }
     else
     {
 
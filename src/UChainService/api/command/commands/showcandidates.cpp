@@ -49,9 +49,18 @@ console_result showcandidates::invoke(Json::Value &jv_output,
         auto sh_vec = blockchain.get_registered_candidates();
         if (nullptr != sh_vec)
         {
+            for (auto &elem : *sh_vec)
+            {
+                if (elem.to_uid.empty())
+                    continue;
+
+                const auto votes = blockchain.get_candidate_votes(elem.to_uid);
+                elem.vote = static_cast<uint32_t>(std::min<uint64_t>(votes, max_uint32));
+            }
+
             //vote first and height next.
             std::sort(sh_vec->begin(), sh_vec->end(), [](const candidate_info &a, const candidate_info &b) {
-                return a.vote > b.vote ? true : a.output_height > b.output_height;
+                return a.vote != b.vote ? a.vote > b.vote : a.output_height > b.output_height;
             });
             for (auto &elem : *sh_vec)
             {
@@ -95,8 +95,13 @@ console_result showtxs::invoke(Json::Value &jv_output,
     auto &aroot = jv_output;
     Json::Value balances;
 
+    // newest first, the order of history_cursor
     auto sort_by_height = [](const tx_block_info &lhs, const tx_block_info &rhs) -> bool {
-        return const_cast<tx_block_info &>(lhs).get_height() > const_cast<tx_block_info &>(rhs).get_height();
+        auto &left = const_cast<tx_block_info &>(lhs);
+        auto &right = const_cast<tx_block_info &>(rhs);
+        if (left.get_height() != right.get_height())
+            return left.get_height() > right.get_height();
+        return left.get_hash() > right.get_hash();
     };
 
     auto sh_txs = std::make_shared<std::vector<tx_block_info>>();
@@ -127,13 +132,43 @@ console_result showtxs::invoke(Json::Value &jv_output,
     if (argument_.limit > 100)
         throw argument_legality_exception{"page record limit cannot be bigger than 100."};
 
-    if (sh_addr_vec->size())
+    const auto use_cursor = !argument_.cursor.empty();
+    database::history_cursor cursor;
+    if (use_cursor && !cursor.from_string(argument_.cursor))
+        throw argument_legality_exception{"invalid cursor parameter"};
+
+    // the row to resume a single address at
+    array_index resume = database::record_list::empty;
+
+    // the wallet timeline serves the whole wallet when no token is filtered
+    const auto use_timeline = argument_.address.empty() && argument_.symbol.empty();
+    auto timeline_cursor = cursor;
+    uint64_t timeline_count = 0;
+
+    if (use_timeline && sh_addr_vec->size())
+    {
+        // a page is one walk of the timeline, from the cursor or the head
+        const auto rows = use_cursor ? argument_.limit : argument_.index * argument_.limit;
+        auto sh_vec = blockchain.get_wallet_history(auth_.name, timeline_cursor,
+                                                    option_.height.first(), option_.height.second(), rows);
+        for (auto &elem : *sh_vec)
+            sh_txs->push_back(tx_block_info(elem.height, elem.timestamp, elem.hash));
+
+        if (!use_cursor)
+            timeline_count = blockchain.get_wallet_history_count(auth_.name,
+                                                                 option_.height.first(), option_.height.second());
+    }
+    else if (sh_addr_vec->size())
     {
         // scan all addresses business record
         for (auto &each : *sh_addr_vec)
         {
-            auto sh_vec = blockchain.get_address_business_record(each, argument_.symbol,
-                                                                 option_.height.first(), option_.height.second(), 0, 0);
+            // each address walks on from the cursor, only as far as this page
+            auto sh_vec = use_cursor
+                              ? blockchain.get_address_business_record(each, argument_.symbol,
+                                                                       option_.height.first(), option_.height.second(), argument_.limit, cursor, resume)
+                              : blockchain.get_address_business_record(each, argument_.symbol,
+                                                                       option_.height.first(), option_.height.second(), 0, 0);
             for (auto &elem : *sh_vec)
                 sh_txs->push_back(tx_block_info(elem.height, elem.data.get_timestamp(), elem.point.hash));
         }
@@ -166,15 +201,24 @@ console_result showtxs::invoke(Json::Value &jv_output,
         }
     }
 
+    // the timeline reads only as far as this page
+    const uint64_t total = use_timeline ? timeline_count : sh_txs->size();
+
     uint64_t start, end, total_page, tx_count;
-    if (argument_.index && argument_.limit)
+    if (use_cursor)
+    {
+        start = 0;
+        tx_count = std::min<uint64_t>(sh_txs->size(), argument_.limit);
+        total_page = 0;
+    }
+    else if (argument_.index && argument_.limit)
     {
         start = (argument_.index - 1) * argument_.limit;
         end = (argument_.index) * argument_.limit;
         if ((start >= sh_txs->size() || !sh_txs->size()) && !balances.size())
             throw argument_legality_exception{"no record in this page"};
 
-        total_page = sh_txs->size() % argument_.limit ? (sh_txs->size() / argument_.limit + 1) : (sh_txs->size() / argument_.limit);
+        total_page = total % argument_.limit ? (total / argument_.limit + 1) : (total / argument_.limit);
         tx_count = end >= sh_txs->size() ? (sh_txs->size() - start) : argument_.limit;
     }
     else if (!argument_.index && !argument_.limit)
@@ -188,6 +232,22 @@ console_result showtxs::invoke(Json::Value &jv_output,
     {
         throw argument_legality_exception{"invalid limit or index parameter"};
     }
+
+    // a full page continues after its last transaction
+    std::string next_cursor;
+    if (!balances.size() && tx_count && tx_count == argument_.limit &&
+        (use_cursor || start + tx_count < total))
+    {
+        auto &last = (*sh_txs)[start + tx_count - 1];
+        // a row is a position in the history of one address only
+        const auto single = sh_addr_vec->size() == 1;
+        const auto row = single ? resume : database::record_list::empty;
+        const auto key = single ? database::address_token_database::get_key(sh_addr_vec->front())
+                                : null_short_hash;
+        next_cursor = use_timeline
+                          ? timeline_cursor.encoded()
+                          : database::history_cursor(last.get_height(), last.get_hash(), row, key).encoded();
+    }
     if (!balances.size())
     {
         auto json_helper = config::json_helper(get_api_version());
@@ -356,9 +416,14 @@ console_result showtxs::invoke(Json::Value &jv_output,
         }
     }
 
-    aroot["total_page"] = balances.size() ? 10000 / argument_.limit : total_page;
-    aroot["current_page"] = argument_.index;
+    if (!use_cursor)
+    {
+        aroot["total_page"] = balances.size() ? 10000 / argument_.limit : total_page;
+        aroot["current_page"] = argument_.index;
+    }
     aroot["transaction_count"] = balances.size() ? balances.size() : tx_count;
+    if (!balances.size())
+        aroot["next_cursor"] = next_cursor;
 
     if (get_api_version() == 1 && balances.isNull())
     { // compatible for v1
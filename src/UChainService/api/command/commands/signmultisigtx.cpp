@@ -48,13 +48,29 @@ console_result signmultisigtx::invoke(
         throw address_list_empty_exception{"empty address list for this wallet."};
     }
 
+    // The key schedule is expanded once for all address lookups, unless
+    // the wallet is unlocked and its keys are already at hand.
+    const auto keyring = blockchain.get_wallet_keyring(auth_.name, auth_.auth);
+    aes256_key key(passphrase_secret(auth_.auth));
+    const auto get_prv_key = [&keyring, &key](const wallet_address &each) {
+        std::string prv_key;
+        const auto copy = [&prv_key](const char *data, size_t size) {
+            prv_key.assign(data, size);
+        };
+
+        if (!keyring || !keyring->find(each.get_address(), copy))
+            prv_key = each.get_prv_key(key);
+
+        return prv_key;
+    };
+
     std::string addr_prikey("");
     if (!option_.self_publickey.empty())
     {
         auto owned = false;
         for (auto &each : *pvaddr)
         {
-            auto prv_key = each.get_prv_key(auth_.auth);
+            auto prv_key = get_prv_key(each);
             auto pub_key = ec_to_xxx_impl("ec-to-public", prv_key);
             if (option_.self_publickey == pub_key)
             {
@@ -132,7 +148,7 @@ console_result signmultisigtx::invoke(
                 addr_prikey = "";
                 for (auto &each : *pvaddr)
                 {
-                    auto prv_key = each.get_prv_key(auth_.auth);
+                    auto prv_key = get_prv_key(each);
                     auto &&pub_key = ec_to_xxx_impl("ec-to-public", prv_key);
                     if (pub_key == acc_multisig.get_pub_key())
                     {
@@ -67,7 +67,7 @@ console_result signrawtx::invoke(Json::Value &jv_output,
             explorer::config::hashtype sign_type;
             uint8_t hash_type = (signature_hash_algorithm)sign_type;
 
-            bc::explorer::config::ec_private config_private_key(acc_addr->get_prv_key(auth_.auth)); // address private key
+            bc::explorer::config::ec_private config_private_key(blockchain.get_wallet_prv_key(*acc_addr, auth_.auth)); // address private key
             const ec_secret &private_key = config_private_key;
             bc::wallet::ec_private ec_private_key(private_key, 0u, true);
 
@@ -0,0 +1,53 @@
+/**
+ * Copyright (c) 2018-2020 UChain core developers (check UC-AUTHORS)
+ *
+ * This file is part of UChain-explorer.
+ *
+ * UChain-explorer is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <UChain/explorer/dispatch.hpp>
+#include <UChainService/api/command/commands/unlockwallet.hpp>
+#include <UChainService/api/command/command_extension_func.hpp>
+#include <UChainService/api/command/command_assistant.hpp>
+#include <UChainService/api/command/exception.hpp>
+
+namespace libbitcoin
+{
+namespace explorer
+{
+namespace commands
+{
+
+console_result unlockwallet::invoke(Json::Value &jv_output,
+                                    libbitcoin::server::server_node &node)
+{
+    if (!option_.timeout || option_.timeout > 86400)
+        throw argument_legality_exception{"timeout should be between 1 and 86400 seconds."};
+
+    auto &blockchain = node.chain_impl();
+    blockchain.unlock_wallet(auth_.name, auth_.auth, option_.timeout);
+
+    auto &jv = jv_output;
+    jv["name"] = auth_.name;
+    jv["timeout"] = option_.timeout;
+    jv["status"] = "unlocked";
+
+    return console_result::okay;
+}
+
+} // namespace commands
+} // namespace explorer
+} // namespace libbitcoin
@@ -18,6 +18,8 @@
 #include <thread>
 #include <functional>
 #include <UChainService/api/restful/MgServer.hpp>
+#include <UChainService/api/restful/utility/Json_writer.hpp>
+#include <UChainService/api/restful/utility/Stream_buf.hpp>
 #include <UChain/coin/utility/log.hpp>
 #include <UChain/coin/version.hpp>
 
@@ -105,6 +107,53 @@ bool MgServer::send_frame(struct mg_connection &nc, const char *msg, size_t len,
     return true;
 }
 
+bool MgServer::send_frame(struct mg_connection &nc, const Json::Value &msg)
+{
+    if (!nc_ || !running_)
+        return false;
+
+    // Client connections mask their frames, leave those to mongoose.
+    if (nc.listener == nullptr)
+        return send_frame(nc, toJson(msg));
+
+    // The payload is written in place and the frame header is inserted in
+    // front of it once the length is known.
+    auto &mbuf = nc.send_mbuf;
+    const auto start = mbuf.len;
+    {
+        StreamBuf buf{mbuf};
+        std::ostream os{&buf};
+        writeJson(os, msg);
+    }
+
+    const uint64_t len = mbuf.len - start;
+    unsigned char header[10];
+    size_t header_len;
+    header[0] = 0x80 | WEBSOCKET_OP_TEXT;
+    if (len < 126)
+    {
+        header[1] = static_cast<unsigned char>(len);
+        header_len = 2;
+    }
+    else if (len <= 0xffff)
+    {
+        header[1] = 126;
+        header[2] = static_cast<unsigned char>(len >> 8);
+        header[3] = static_cast<unsigned char>(len);
+        header_len = 4;
+    }
+    else
+    {
+        header[1] = 127;
+        for (size_t i = 0; i < 8; ++i)
+            header[2 + i] = static_cast<unsigned char>(len >> (56 - 8 * i));
+        header_len = 10;
+    }
+
+    mbuf_insert(&mbuf, start, header, header_len);
+    return true;
+}
+
 void MgServer::run()
 {
     while (running_)
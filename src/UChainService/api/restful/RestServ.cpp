@@ -14,14 +14,23 @@
  * not, write to the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
  * 02110-1301, USA.
  */
+#include <algorithm>
 #include <exception>
+#include <sstream>
+#include <thread>
 #include <functional> //hash
 
 #include <UChainService/api/restful/RestServ.hpp>
 #include <UChainService/api/restful/exception/Instances.hpp>
 #include <UChainService/api/restful/utility/Stream_buf.hpp>
 
+#include <UChainService/api/command/command_extension.hpp>
 #include <UChainService/api/command/command_extension_func.hpp>
+#include <UChainService/api/command/commands/addpeer.hpp>
+#include <UChainService/api/command/commands/setminingwallet.hpp>
+#include <UChainService/api/command/commands/shutdown.hpp>
+#include <UChainService/api/command/commands/startmining.hpp>
+#include <UChainService/api/command/commands/stopmining.hpp>
 #include <UChainService/api/command/exception.hpp>
 #include <UChainApp/ucd/server_node.hpp>
 
@@ -63,25 +72,43 @@ void RestServ::reset(HttpMessage &data) noexcept
     uri_.reset(uri);
 }
 
-void RestServ::rpc_request(mg_connection &nc, HttpMessage data, uint8_t rpc_version)
+// The body of an rpc response. v1 clients get the styled text they always
+// had, v2 and v3 clients a document that is written compactly straight into
+// the send buffer of the connection.
+struct RpcBody
 {
-    reset(data);
-    StreamBuf buf{nc.send_mbuf};
-    out_.rdbuf(&buf);
-    out_.reset(200, "OK");
+    bool json{false};
+    std::string text;
+    Json::Value document;
+};
+
+// Renders the outcome of run as the response body for the rpc version.
+// jsonrpc_id is read after run, which may be what sets it.
+static std::shared_ptr<RpcBody> render_rpc(uint8_t rpc_version, const int64_t &jsonrpc_id,
+                                           const std::function<console_result(Json::Value &)> &run)
+{
+    auto body = std::make_shared<RpcBody>();
+    std::ostringstream out;
 
     const vector<uint8_t> api20_ver_list = {2, 3};
     auto checkAPIVer = [](const vector<uint8_t> &api_ver_list, const uint8_t &rpc_version) {
         return find(api_ver_list.begin(), api_ver_list.end(), rpc_version) != api_ver_list.end();
     };
+    auto set_error = [&body, &jsonrpc_id](int32_t code, const char *message) {
+        Json::Value root;
+        root["jsonrpc"] = "3.0";
+        root["id"] = jsonrpc_id;
+        root["error"]["code"] = code;
+        root["error"]["message"] = message;
+
+        body->json = true;
+        body->document.swap(root);
+    };
     try
     {
-        data.data_to_arg(rpc_version);
-
         Json::Value jv_output;
 
-        auto retcode = explorer::dispatch_command(data.argc(), const_cast<const char **>(data.argv()),
-                                                  jv_output, node_, rpc_version);
+        auto retcode = run(jv_output);
 
         if (retcode == console_result::failure)
         { // only orignal command
@@ -97,18 +124,18 @@ void RestServ::rpc_request(mg_connection &nc, HttpMessage data, uint8_t rpc_vers
             if (rpc_version == 1)
             {
                 if (jv_output.isObject() || jv_output.isArray())
-                    out_ << jv_output.toStyledString();
+                    out << jv_output.toStyledString();
                 else
-                    out_ << jv_output.asString();
+                    out << jv_output.asString();
             }
             else if (checkAPIVer(api20_ver_list, rpc_version))
             {
-                Json::Value jv_root;
+                // The result is moved rather than copied into the envelope.
+                auto &jv_root = body->document;
                 jv_root["jsonrpc"] = "3.0";
-                jv_root["id"] = data.jsonrpc_id();
-                jv_root["result"] = jv_output;
-
-                out_ << jv_root.toStyledString();
+                jv_root["id"] = jsonrpc_id;
+                jv_root["result"].swap(jv_output);
+                body->json = true;
             }
         }
     }
@@ -116,17 +143,11 @@ void RestServ::rpc_request(mg_connection &nc, HttpMessage data, uint8_t rpc_vers
     {
         if (rpc_version == 1)
         {
-            out_ << e;
+            out << e;
         }
         else if (checkAPIVer(api20_ver_list, rpc_version))
         {
-            Json::Value root;
-            root["jsonrpc"] = "3.0";
-            root["id"] = data.jsonrpc_id();
-            root["error"]["code"] = (int32_t)e.code();
-            root["error"]["message"] = e.what();
-
-            out_ << root.toStyledString();
+            set_error((int32_t)e.code(), e.what());
         }
     }
     catch (const std::exception &e)
@@ -134,31 +155,26 @@ void RestServ::rpc_request(mg_connection &nc, HttpMessage data, uint8_t rpc_vers
         if (rpc_version == 1)
         {
             libbitcoin::explorer::explorer_exception ex(1000, e.what());
-            out_ << ex;
+            out << ex;
         }
         else if (checkAPIVer(api20_ver_list, rpc_version))
         {
-            Json::Value root;
-            root["jsonrpc"] = "3.0";
-            root["id"] = data.jsonrpc_id();
-            root["error"]["code"] = 1000;
-            root["error"]["message"] = e.what();
-
-            out_ << root.toStyledString();
+            set_error(1000, e.what());
         }
     }
-    out_.setContentLength();
+
+    body->text = out.str();
+    return body;
 }
 
-void RestServ::ws_request(mg_connection &nc, WebsocketMessage ws)
+// Renders the outcome of run as a websocket frame.
+static std::string render_ws(const std::function<console_result(Json::Value &)> &run)
 {
     Json::Value jv_output;
 
     try
     {
-        ws.data_to_arg();
-
-        console_result retcode = explorer::dispatch_command(ws.argc(), const_cast<const char **>(ws.argv()), jv_output, node_);
+        console_result retcode = run(jv_output);
         if (retcode != console_result::okay)
         {
             throw explorer::command_params_exception(jv_output.asString());
@@ -172,18 +188,236 @@ void RestServ::ws_request(mg_connection &nc, WebsocketMessage ws)
     }
 
     if (jv_output.isObject() || jv_output.isArray())
-        send_frame(nc, jv_output.toStyledString());
-    else
-        send_frame(nc, jv_output.asString());
+        return jv_output.toStyledString();
+
+    return jv_output.asString();
+}
+
+void RestServ::rpc_request(mg_connection &nc, HttpMessage data, uint8_t rpc_version)
+{
+    reset(data);
+
+    const auto respond = [this](const std::shared_ptr<RpcBody> &body) -> Reply {
+        return [this, body](mg_connection &nc) {
+            if (body->json)
+                send_http_response(nc, body->document);
+            else
+                send_http_response(nc, body->text);
+        };
+    };
+
+    int64_t jsonrpc_id = -1;
+    std::shared_ptr<explorer::command> command;
+    const auto parsed = render_rpc(rpc_version, jsonrpc_id, [&](Json::Value &jv_output) {
+        data.data_to_arg(rpc_version);
+        jsonrpc_id = data.jsonrpc_id();
+        command = explorer::parse_command(data.argc(),
+                                          const_cast<const char **>(data.argv()), jv_output, node_);
+        return console_result::okay;
+    });
+
+    const auto ticket = track(nc);
+
+    // Malformed requests and help are answered without running a command,
+    // still after the earlier responses of the connection.
+    if (!command)
+    {
+        reply(nc, ticket, respond(parsed));
+        return;
+    }
+
+    auto *connection = &nc;
+    execute(lane(*command), [this, respond, command, connection, ticket, rpc_version, jsonrpc_id]() {
+        const auto body = render_rpc(rpc_version, jsonrpc_id, [&](Json::Value &jv_output) {
+            return explorer::invoke_command(*command, jv_output, node_, rpc_version);
+        });
+
+        // The document is serialized on the mongoose thread, directly into
+        // the send buffer, so the response is never held as a string.
+        spawn_to_mongoose([this, respond, connection, ticket, body](uint64_t) {
+            reply(*connection, ticket, respond(body));
+        });
+    });
+}
+
+void RestServ::ws_request(mg_connection &nc, WebsocketMessage ws)
+{
+    std::shared_ptr<explorer::command> command;
+    const auto parsed = render_ws([&](Json::Value &jv_output) {
+        ws.data_to_arg();
+        command = explorer::parse_command(ws.argc(),
+                                          const_cast<const char **>(ws.argv()), jv_output, node_);
+        return console_result::okay;
+    });
+
+    const auto send = [this](const std::string &frame) -> Reply {
+        return [this, frame](mg_connection &nc) { send_frame(nc, frame); };
+    };
+
+    const auto ticket = track(nc);
+    if (!command)
+    {
+        reply(nc, ticket, send(parsed));
+        return;
+    }
+
+    auto *connection = &nc;
+    execute(lane(*command), [this, send, command, connection, ticket]() {
+        auto frame = render_ws([&](Json::Value &jv_output) {
+            return explorer::invoke_command(*command, jv_output, node_);
+        });
+
+        spawn_to_mongoose([this, send, connection, ticket, frame](uint64_t) {
+            reply(*connection, ticket, send(frame));
+        });
+    });
+}
+
+// Wallet commands are serialized per wallet and node administration overall,
+// so concurrent requests cannot interleave wallet or node state changes.
+// Commands do not declare these categories, so a command is a wallet command
+// when it authenticates a wallet, and administration is listed by name.
+std::string RestServ::lane(explorer::command &command)
+{
+    using namespace libbitcoin::explorer;
+
+    if (!command.category(ctgy_extension))
+        return {};
+
+    const auto &wallet = static_cast<commands::command_extension &>(command).wallet_name();
+    if (!wallet.empty())
+        return "wallet:" + wallet;
+
+    const std::string name = command.name();
+    if (name == commands::addpeer::symbol() ||
+        name == commands::setminingwallet::symbol() ||
+        name == commands::shutdown::symbol() ||
+        name == commands::startmining::symbol() ||
+        name == commands::stopmining::symbol())
+        return "admin";
+
+    return {};
+}
+
+void RestServ::execute(const std::string &lane, Job &&job)
+{
+    if (lane.empty())
+    {
+        pool_.service().post(std::move(job));
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(lanes_mutex_);
+        auto &queue = lanes_[lane];
+        queue.push_back(std::move(job));
+
+        // The running job of the lane posts the next one on completion.
+        if (queue.size() > 1)
+            return;
+    }
+
+    run_lane(lane);
+}
+
+void RestServ::run_lane(const std::string &lane)
+{
+    pool_.service().post([this, lane]() {
+        // The emptied job stays at the front of the queue until it is done,
+        // so execute never starts a second job of the lane meanwhile.
+        Job job;
+        {
+            std::lock_guard<std::mutex> lock(lanes_mutex_);
+            job = std::move(lanes_[lane].front());
+        }
+
+        job();
+
+        auto more = false;
+        {
+            std::lock_guard<std::mutex> lock(lanes_mutex_);
+            const auto it = lanes_.find(lane);
+            it->second.pop_front();
+            more = !it->second.empty();
+            if (!more)
+                lanes_.erase(it);
+        }
+
+        if (more)
+            run_lane(lane);
+    });
+}
+
+RestServ::Ticket RestServ::track(mg_connection &nc)
+{
+    auto it = pending_.find(&nc);
+    if (it == pending_.end())
+        it = pending_.emplace(&nc, Pending{++generation_, 0, 0, {}}).first;
+
+    return {it->second.generation, it->second.issued++};
+}
+
+void RestServ::reply(mg_connection &nc, const Ticket &ticket, Reply &&response)
+{
+    // The connection closed, its address may have been reused since.
+    const auto it = pending_.find(&nc);
+    if (it == pending_.end() || it->second.generation != ticket.generation)
+        return;
+
+    auto &pending = it->second;
+    pending.ready.emplace(ticket.sequence, std::move(response));
+
+    // Write every response that no earlier one is still waiting for.
+    for (auto next = pending.ready.begin();
+         next != pending.ready.end() && next->first == pending.written;
+         next = pending.ready.begin())
+    {
+        next->second(nc);
+        pending.ready.erase(next);
+        ++pending.written;
+    }
+
+    if (pending.written == pending.issued)
+        pending_.erase(it);
+}
+
+void RestServ::send_http_response(mg_connection &nc, const std::string &body)
+{
+    StreamBuf buf{nc.send_mbuf};
+    out_.rdbuf(&buf);
+    out_.reset(200, "OK");
+    out_ << body;
+    out_.setContentLength();
+}
+
+void RestServ::send_http_response(mg_connection &nc, const Json::Value &body)
+{
+    StreamBuf buf{nc.send_mbuf};
+    out_.rdbuf(&buf);
+    out_.reset(200, "OK");
+    writeJson(out_, body);
+    out_.setContentLength();
 }
 
 bool RestServ::start()
 {
     if (!attach_notify())
         return false;
+
+    const auto workers = node_.server_settings().rpc_workers;
+    pool_.spawn(workers != 0 ? workers : std::max(std::thread::hardware_concurrency(), 1u));
     return base::start();
 }
 
+// Commands still running complete before the pool is joined, their responses
+// are dropped because the mongoose thread has stopped.
+void RestServ::stop()
+{
+    base::stop();
+    pool_.shutdown();
+    pool_.join();
+}
+
 void RestServ::spawn_to_mongoose(const std::function<void(uint64_t)> &&handler)
 {
     auto msg = std::make_shared<MgEvent>(std::move(handler));
@@ -244,6 +478,11 @@ void RestServ::on_ws_handshake_done_handler(struct mg_connection &nc)
     send_frame(nc, "connected", 9);
 }
 
+void RestServ::on_close_handler(struct mg_connection &nc)
+{
+    pending_.erase(&nc);
+}
+
 void RestServ::on_ws_frame_handler(struct mg_connection &nc, websocket_message &msg)
 {
     std::istringstream iss;
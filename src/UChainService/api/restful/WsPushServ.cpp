@@ -19,6 +19,7 @@
 #include <sstream>
 #include <UChain/explorer/json_helper.hpp>
 #include <UChainService/api/restful/WsPushServ.hpp>
+#include <UChainService/api/restful/utility/Json_writer.hpp>
 #include <UChainApp/ucd/server_node.hpp>
 
 namespace mgbubble
@@ -220,77 +221,34 @@ void WsPushServ::notify_block_impl(uint32_t height, const bc::chain::block::ptr
 
 void WsPushServ::do_notify(
     const std::vector<std::weak_ptr<mg_connection>> &notify_cons,
-    Json::Value &root,
-    std::shared_ptr<connection_string_map> topic_map)
+    const Json::Value &root)
 {
-    auto orignal_rep = root.toStyledString();
+    // Serialize once for every connection.
+    const auto frame = std::make_shared<const std::string>(toJson(root));
 
-    for (auto &con : notify_cons)
-    {
-        auto shared_con = con.lock();
-        if (!shared_con)
-        {
-            continue;
-        }
+    delivery_list deliveries;
+    deliveries.reserve(notify_cons.size());
+    for (const auto &con : notify_cons)
+        deliveries.emplace_back(con, frame);
 
-        std::string rep;
-        if (topic_map != nullptr)
-        {
-            auto iter = topic_map->find(con);
-            if (iter != topic_map->end())
-            {
-                auto &topics = iter->second;
-                if (topics.end() != std::find(topics.begin(), topics.end(), CH_ALL))
-                {
-                    root["topic"] = CH_ALL;
-                }
-                else if (topics.size() == 1)
-                {
-                    root["topic"] = topics[0];
-                }
-                else
-                {
-                    Json::Value value;
-                    for (auto &topic : topics)
-                    {
-                        value.append(topic);
-                    }
-                    if (value.isNull())
-                        value.resize(0);
-
-                    root["topic"] = value;
-                }
+    do_notify(deliveries);
+}
 
-                rep = root.toStyledString();
-            }
-        }
+void WsPushServ::do_notify(const delivery_list &deliveries)
+{
+    if (deliveries.empty())
+        return;
 
-        if (rep.empty())
+    spawn_to_mongoose([this, deliveries](uint64_t id) {
+        // Connections are closed on this thread, which expires their handle,
+        // so any target that is still live is written to directly.
+        for (const auto &delivery : deliveries)
         {
-            rep = orignal_rep;
+            const auto con = delivery.first.lock();
+            if (con)
+                send_frame(*con, *delivery.second);
         }
-
-        spawn_to_mongoose([this, shared_con, rep](uint64_t id) {
-            size_t active_connections = 0;
-            auto *mgr = &this->mg_mgr();
-            auto *notify_nc = shared_con.get();
-            for (auto *nc = mg_next(mgr, NULL); nc != NULL; nc = mg_next(mgr, nc))
-            {
-                if (!is_websocket(*nc) || is_listen_socket(*nc) || is_notify_socket(*nc))
-                    continue;
-                ++active_connections;
-                if (notify_nc == nc)
-                {
-                    send_frame(*nc, rep);
-                }
-            }
-
-            if (active_connections != map_connections_.size())
-            {
-                refresh_connections();
-            }
-        });
-    }
+    });
 }
 
 void WsPushServ::notify_transaction(uint32_t height, const hash_digest &block_hash, const transaction &tx)
@@ -300,99 +258,151 @@ void WsPushServ::notify_transaction(uint32_t height, const hash_digest &block_ha
         return;
     }
 
-    connection_string_map subscribers;
+    // The addresses are decoded once per transaction and shared.
+    const string_vector tx_addrs = tx.decoded()->addresses();
+
+    // The matched topics of each subscriber, in transaction address order.
+    connection_string_map topic_map;
     {
         std::lock_guard<std::mutex> guard(subscribers_lock_);
-        if (subscribers_.size() == 0)
+        if (subscribers_.empty())
         {
             return;
         }
 
-        for (auto &con : subscribers_)
+        for (const auto &con : all_subscribers_)
         {
-            if (!con.first.expired())
-            {
-                subscribers.insert(con);
-            }
+            topic_map[con].push_back(CH_ALL);
         }
 
-        if (subscribers.size() != subscribers_.size())
+        for (const auto &address : tx_addrs)
         {
-            subscribers_ = subscribers;
+            const auto it = topic_subscribers_.find(address);
+            if (it == topic_subscribers_.end())
+            {
+                continue;
+            }
+
+            for (const auto &con : it->second)
+            {
+                topic_map[con].push_back(address);
+            }
         }
     }
 
-    /* ---------- may has subscribers ---------- */
+    if (topic_map.empty())
+    {
+        return;
+    }
 
-    string_vector tx_addrs;
-    for (const auto &input : tx.inputs)
+    // Subscribers matching the same topics share one serialized frame.
+    std::map<string_vector, std::vector<std::weak_ptr<mg_connection>>> topic_groups;
+    for (const auto &sub : topic_map)
     {
-        const auto address = payment_address::extract(input.script);
-        if (address)
-        {
-            auto addr_hash = address.encoded();
-            if (tx_addrs.end() == std::find(tx_addrs.begin(), tx_addrs.end(), addr_hash))
-            {
-                tx_addrs.push_back(addr_hash);
-            }
-        }
+        topic_groups[sub.second].push_back(sub.first);
     }
 
-    for (const auto &output : tx.outputs)
+    // log::info(NAME) << " ******** notify_transaction: height [" << height << "]  ******** ";
+
+    Json::Value root;
+    root["event"] = EV_PUBLISH;
+    root["channel"] = CH_TRANSACTION;
+    root["result"] = get_json_helper().prop_list(tx, height, true);
+
+    delivery_list deliveries;
+    deliveries.reserve(topic_map.size());
+    for (const auto &group : topic_groups)
     {
-        const auto address = payment_address::extract(output.script);
-        if (address)
+        const auto &topics = group.first;
+        if (topics.size() == 1)
+        {
+            root["topic"] = topics[0];
+        }
+        else
         {
-            auto addr_hash = address.encoded();
-            if (tx_addrs.end() == std::find(tx_addrs.begin(), tx_addrs.end(), addr_hash))
+            Json::Value value(Json::arrayValue);
+            for (const auto &topic : topics)
             {
-                tx_addrs.push_back(addr_hash);
+                value.append(topic);
             }
+
+            root["topic"] = value;
+        }
+
+        const auto frame = std::make_shared<const std::string>(toJson(root));
+        for (const auto &con : group.second)
+        {
+            deliveries.emplace_back(con, frame);
         }
     }
 
-    std::shared_ptr<connection_string_map> topic_map = std::make_shared<connection_string_map>();
+    do_notify(deliveries);
+}
 
-    std::vector<std::weak_ptr<mg_connection>> notify_cons;
-    for (auto &sub : subscribers)
+void WsPushServ::subscribe_transactions(const std::weak_ptr<mg_connection> &con,
+                                        const string_vector &addresses)
+{
+    auto &sub_list = subscribers_[con];
+
+    // Subscribing without addresses is a subscription to all transactions.
+    if (addresses.empty())
     {
-        string_vector topics;
-        auto &sub_addrs = sub.second;
-        if (sub_addrs.empty())
+        for (const auto &address : sub_list)
         {
-            topics.push_back(CH_ALL);
-        }
-        else
-        {
-            for (auto &addr_hash : sub_addrs)
+            const auto it = topic_subscribers_.find(address);
+            if (it == topic_subscribers_.end())
             {
-                if (tx_addrs.end() != std::find(tx_addrs.begin(), tx_addrs.end(), addr_hash))
-                {
-                    topics.push_back(addr_hash);
-                }
+                continue;
+            }
+
+            it->second.erase(con);
+            if (it->second.empty())
+            {
+                topic_subscribers_.erase(it);
             }
         }
 
-        if (!topics.empty())
+        sub_list.clear();
+        all_subscribers_.insert(con);
+        return;
+    }
+
+    all_subscribers_.erase(con);
+    for (const auto &address : addresses)
+    {
+        if (sub_list.end() == std::find(sub_list.begin(), sub_list.end(), address))
         {
-            topic_map->insert({sub.first, topics});
-            notify_cons.push_back(sub.first);
+            sub_list.push_back(address);
+            topic_subscribers_[address].insert(con);
         }
     }
+}
 
-    if (notify_cons.size() == 0)
+void WsPushServ::unsubscribe_transactions(const std::weak_ptr<mg_connection> &con)
+{
+    const auto sub_it = subscribers_.find(con);
+    if (sub_it == subscribers_.end())
     {
         return;
     }
 
-    // log::info(NAME) << " ******** notify_transaction: height [" << height << "]  ******** ";
+    for (const auto &address : sub_it->second)
+    {
+        const auto it = topic_subscribers_.find(address);
+        if (it == topic_subscribers_.end())
+        {
+            continue;
+        }
 
-    Json::Value root;
-    root["event"] = EV_PUBLISH;
-    root["channel"] = CH_TRANSACTION;
-    root["result"] = get_json_helper().prop_list(tx, height, true);
+        it->second.erase(con);
+        if (it->second.empty())
+        {
+            topic_subscribers_.erase(it);
+        }
+    }
 
-    do_notify(notify_cons, root, topic_map);
+    all_subscribers_.erase(con);
+    subscribers_.erase(sub_it);
 }
 
 void WsPushServ::send_bad_response(struct mg_connection &nc, const char *message, int code, Json::Value data)
@@ -406,8 +416,7 @@ void WsPushServ::send_bad_response(struct mg_connection &nc, const char *message
     root["event"] = EV_MG_ERROR;
     root["result"] = result;
 
-    auto &&tmp = root.toStyledString();
-    send_frame(nc, tmp.c_str(), tmp.size());
+    send_frame(nc, root);
 }
 
 void WsPushServ::send_response(struct mg_connection &nc, const std::string &event, const std::string &channel, Json::Value data)
@@ -421,25 +430,10 @@ void WsPushServ::send_response(struct mg_connection &nc, const std::string &even
 
     if (!data.isNull())
     {
-        root["result"] = data;
+        root["result"].swap(data);
     }
 
-    auto &&tmp = root.toStyledString();
-    send_frame(nc, tmp.c_str(), tmp.size());
-}
-
-void WsPushServ::refresh_connections()
-{
-    auto *mgr = &mg_mgr();
-    std::unordered_map<void *, std::shared_ptr<mg_connection>> swap;
-    for (auto *nc = mg_next(mgr, NULL); nc != NULL; nc = mg_next(mgr, nc))
-    {
-        if (!is_websocket(*nc) || is_listen_socket(*nc) || is_notify_socket(*nc))
-            continue;
-        std::shared_ptr<struct mg_connection> con(nc, [](struct mg_connection *ptr) { (void)(ptr); });
-        swap.emplace(&nc, con);
-    }
-    map_connections_.swap(swap);
+    send_frame(nc, root);
 }
 
 void WsPushServ::on_ws_handshake_done_handler(struct mg_connection &nc)
@@ -458,8 +452,7 @@ void WsPushServ::on_ws_handshake_done_handler(struct mg_connection &nc)
     root["event"] = EV_INFO;
     root["result"] = connections;
 
-    auto &&tmp = root.toStyledString();
-    send_frame(nc, tmp);
+    send_frame(nc, root);
 }
 
 void WsPushServ::on_ws_frame_handler(struct mg_connection &nc, websocket_message &msg)
@@ -563,42 +556,8 @@ void WsPushServ::on_ws_frame_handler(struct mg_connection &nc, websocket_message
             {
                 std::lock_guard<std::mutex> guard(subscribers_lock_);
                 std::weak_ptr<struct mg_connection> week_con(it->second);
-                auto sub_it = subscribers_.find(week_con);
-                if (sub_it != subscribers_.end())
-                {
-                    auto &sub_list = sub_it->second;
-
-                    if (addresses.empty())
-                    {
-                        sub_list.clear();
-                        send_response(nc, EV_SUBSCRIBED, channel);
-                        return;
-                    }
-
-                    for (const auto &address : addresses)
-                    {
-                        if (sub_list.end() == std::find(sub_list.begin(), sub_list.end(), address))
-                        {
-                            sub_list.push_back(address);
-                        }
-                    }
-
-                    send_response(nc, EV_SUBSCRIBED, channel);
-                }
-                else
-                {
-                    string_vector sub_list;
-                    for (const auto &address : addresses)
-                    {
-                        if (sub_list.end() == std::find(sub_list.begin(), sub_list.end(), address))
-                        {
-                            sub_list.push_back(address);
-                        }
-                    }
-
-                    subscribers_.insert({week_con, sub_list});
-                    send_response(nc, EV_SUBSCRIBED, channel);
-                }
+                subscribe_transactions(week_con, addresses);
+                send_response(nc, EV_SUBSCRIBED, channel);
             }
             else
             {
@@ -612,7 +571,7 @@ void WsPushServ::on_ws_frame_handler(struct mg_connection &nc, websocket_message
             {
                 std::lock_guard<std::mutex> guard(subscribers_lock_);
                 std::weak_ptr<struct mg_connection> week_con(it->second);
-                subscribers_.erase(week_con);
+                unsubscribe_transactions(week_con);
                 send_response(nc, EV_UNSUBSCRIBED, channel);
             }
             else
@@ -676,7 +635,7 @@ void WsPushServ::on_ws_frame_handler(struct mg_connection &nc, websocket_message
 
                         if (params.empty())
                         {
-                            subscribers_.erase(week_con);
+                            block_subscribers_.erase(iter);
                         }
                     }
 
@@ -721,10 +680,29 @@ void WsPushServ::on_ws_frame_handler(struct mg_connection &nc, websocket_message
 
 void WsPushServ::on_close_handler(struct mg_connection &nc)
 {
-    if (is_websocket(nc))
+    if (!is_websocket(nc))
+    {
+        return;
+    }
+
+    auto it = map_connections_.find(&nc);
+    if (it == map_connections_.end())
+    {
+        return;
+    }
+
+    // Drop the subscriptions so closed connections leave the topic index.
+    std::weak_ptr<struct mg_connection> week_con(it->second);
+    {
+        std::lock_guard<std::mutex> guard(subscribers_lock_);
+        unsubscribe_transactions(week_con);
+    }
     {
-        map_connections_.erase(&nc);
+        std::lock_guard<std::mutex> guard(block_subscribers_lock_);
+        block_subscribers_.erase(week_con);
     }
+
+    map_connections_.erase(it);
 }
 
 void WsPushServ::on_broadcast(struct mg_connection &nc, const char *ev_data)
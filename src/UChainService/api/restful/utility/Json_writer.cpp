@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2018-2020 UChain core developers (check UC-AUTHORS).
+ * Copyright (C) 2013-2018 Swirly Cloud Limited.
+ *
+ * This program is free software; you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation; either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program; if
+ * not, write to the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ */
+
+#include <UChainService/api/restful/utility/Json_writer.hpp>
+
+#include <sstream>
+
+#include <json/minijson_writer.hpp>
+
+namespace mgbubble
+{
+
+namespace
+{
+
+void writeString(std::ostream &os, const char *str)
+{
+  minijson::default_value_writer<const char *>()(os, str);
+}
+
+// Emits a jsoncpp tree with minijson's escaping. The brackets are written
+// here rather than through minijson's object and array writers, which reset
+// the stream settings for every element. Integers are written exactly and
+// reals as jsoncpp formats them, so values read back as from toStyledString.
+void writeValue(std::ostream &os, const Json::Value &value)
+{
+  switch (value.type())
+  {
+  case Json::nullValue:
+    os << "null";
+    break;
+  case Json::intValue:
+    os << value.asLargestInt();
+    break;
+  case Json::uintValue:
+    os << value.asLargestUInt();
+    break;
+  case Json::realValue:
+    os << Json::valueToString(value.asDouble());
+    break;
+  case Json::stringValue:
+  {
+    const char *begin = "";
+    const char *end = begin;
+    value.getString(&begin, &end);
+    writeString(os, begin);
+    break;
+  }
+  case Json::booleanValue:
+    os << (value.asBool() ? "true" : "false");
+    break;
+  case Json::arrayValue:
+  {
+    os.put('[');
+    auto first = true;
+    for (const auto &each : value)
+    {
+      if (!first)
+        os.put(',');
+      first = false;
+      writeValue(os, each);
+    }
+    os.put(']');
+    break;
+  }
+  case Json::objectValue:
+  {
+    os.put('{');
+    auto first = true;
+    for (auto it = value.begin(); it != value.end(); ++it)
+    {
+      if (!first)
+        os.put(',');
+      first = false;
+      const char *end = nullptr;
+      writeString(os, it.memberName(&end));
+      os.put(':');
+      writeValue(os, *it);
+    }
+    os.put('}');
+    break;
+  }
+  }
+}
+
+} // namespace
+
+void writeJson(std::ostream &os, const Json::Value &value)
+{
+  minijson::detail::adjust_stream_settings(os);
+  writeValue(os, value);
+}
+
+std::string toJson(const Json::Value &value)
+{
+  std::ostringstream os;
+  writeJson(os, value);
+  return os.str();
+}
+
+} // namespace mgbubble
@@ -23,6 +23,7 @@
 
 #include <cstddef>
 #include <iostream>
+#include <memory>
 #include <stdexcept>
 #include <string.h>
 #include <UChainService/consensus/define.hpp>
@@ -181,37 +182,124 @@ unsigned int verify_flags_to_script_flags(unsigned int flags)
     return script_flags;
 }
 
-// This function is published. The implementation exposes no satoshi internals.
-verify_result_type verify_script(const unsigned char *transaction,
-                                 size_t transaction_size, const unsigned char *prevout_script,
-                                 size_t prevout_script_size, unsigned int tx_input_index,
-                                 unsigned int flags)
+// Legacy sighashes commit to the whole transaction but not to the public key,
+// so CHECKMULTISIG computes the same hash for every pubkey a signature is
+// tried against. Remember the last one to avoid reserializing the transaction.
+class cached_signature_checker
+    : public TransactionSignatureChecker
+{
+  public:
+    cached_signature_checker(const CTransaction &tx, unsigned int input_index)
+        : TransactionSignatureChecker(&tx, input_index), tx_(tx),
+          input_index_(input_index), hash_type_(0), cached_(false)
+    {
+    }
+
+    bool CheckSig(const std::vector<unsigned char> &signature,
+                  const std::vector<unsigned char> &public_key,
+                  const CScript &script_code) const override
+    {
+        CPubKey pubkey(public_key);
+        if (!pubkey.IsValid() || signature.empty())
+            return false;
+
+        // Hash type is one byte tacked on to the end of the signature.
+        const int hash_type = signature.back();
+        const std::vector<unsigned char> der(signature.begin(),
+                                             signature.end() - 1);
+
+        if (!cached_ || hash_type != hash_type_ || script_code != script_code_)
+        {
+            sighash_ = SignatureHash(script_code, tx_, input_index_, hash_type);
+            script_code_ = script_code;
+            hash_type_ = hash_type;
+            cached_ = true;
+        }
+
+        return VerifySignature(der, pubkey, sighash_);
+    }
+
+  private:
+    const CTransaction &tx_;
+    const unsigned int input_index_;
+    mutable CScript script_code_;
+    mutable int hash_type_;
+    mutable uint256 sighash_;
+    mutable bool cached_;
+};
+
+transaction_context::transaction_context(const unsigned char *transaction,
+                                         size_t transaction_size)
+    : status_(verify_result_eval_true)
 {
     if (transaction_size > 0 && transaction == NULL)
         throw std::invalid_argument("transaction");
 
-    if (prevout_script_size > 0 && prevout_script == NULL)
-        throw std::invalid_argument("prevout_script");
-
-    CTransaction tx;
     try
     {
         TxInputStream stream(transaction, transaction_size);
-        Unserialize(stream, tx, SER_NETWORK, PROTOCOL_VERSION);
+        Unserialize(stream, tx_, SER_NETWORK, PROTOCOL_VERSION);
     }
     catch (const std::exception &e)
     {
-        return verify_result_tx_invalid;
+        status_ = verify_result_tx_invalid;
+        return;
     }
 
+    if (tx_.GetSerializeSize(SER_NETWORK, PROTOCOL_VERSION) != transaction_size)
+        status_ = verify_result_tx_size_invalid;
+}
+
+verify_result_type transaction_context::status() const
+{
+    return status_;
+}
+
+const CTransaction &transaction_context::transaction() const
+{
+    return tx_;
+}
+
+// This function is published. The implementation exposes no satoshi internals.
+transaction_context_ptr create_transaction_context(
+    const unsigned char *transaction, size_t transaction_size)
+{
+    return std::make_shared<const transaction_context>(transaction,
+                                                       transaction_size);
+}
+
+// This function is published. The implementation exposes no satoshi internals.
+verify_result_type verify_script(const unsigned char *transaction,
+                                 size_t transaction_size, const unsigned char *prevout_script,
+                                 size_t prevout_script_size, unsigned int tx_input_index,
+                                 unsigned int flags)
+{
+    const transaction_context context(transaction, transaction_size);
+    return verify_script(context, prevout_script, prevout_script_size,
+                         tx_input_index, flags);
+}
+
+// This function is published. The implementation exposes no satoshi internals.
+verify_result_type verify_script(const transaction_context &context,
+                                 const unsigned char *prevout_script, size_t prevout_script_size,
+                                 unsigned int tx_input_index, unsigned int flags)
+{
+    if (prevout_script_size > 0 && prevout_script == NULL)
+        throw std::invalid_argument("prevout_script");
+
+    // Preserve the original precedence of deserialization errors.
+    if (context.status() == verify_result_tx_invalid)
+        return verify_result_tx_invalid;
+
+    const CTransaction &tx = context.transaction();
     if (tx_input_index >= tx.vin.size())
         return verify_result_tx_input_invalid;
 
-    if (tx.GetSerializeSize(SER_NETWORK, PROTOCOL_VERSION) != transaction_size)
-        return verify_result_tx_size_invalid;
+    if (context.status() != verify_result_eval_true)
+        return context.status();
 
     ScriptError_t error;
-    TransactionSignatureChecker checker(&tx, tx_input_index);
+    cached_signature_checker checker(tx, tx_input_index);
     const unsigned int script_flags = verify_flags_to_script_flags(flags);
     CScript output_script(prevout_script, prevout_script + prevout_script_size);
     const CScript &input_script = tx.vin[tx_input_index].scriptSig;
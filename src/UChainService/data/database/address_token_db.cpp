@@ -23,6 +23,7 @@
 #include <cstdint>
 #include <cstddef>
 #include <memory>
+#include <set>
 #include <boost/filesystem.hpp>
 #include <UChain/coin.hpp>
 #include <UChain/database/memory/memory.hpp>
@@ -39,8 +40,9 @@ namespace database
 using namespace boost::filesystem;
 using namespace bc::chain;
 
-BC_CONSTEXPR size_t number_buckets = 97210744;
-BC_CONSTEXPR size_t header_size = record_hash_table_header_size(number_buckets);
+// The initial bucket count, the table grows with its keys.
+BC_CONSTEXPR size_t number_buckets = 1024;
+BC_CONSTEXPR size_t header_size = resizable_record_hash_table_header_size(number_buckets);
 BC_CONSTEXPR size_t initial_lookup_file_size = header_size + minimum_records_size;
 
 BC_CONSTEXPR size_t record_size = hash_table_multimap_record_size<short_hash>();
@@ -52,7 +54,7 @@ BC_CONSTEXPR size_t row_record_size = hash_table_record_size<hash_digest>(token_
 address_token_database::address_token_database(const path &lookup_filename,
                                                const path &rows_filename, std::shared_ptr<shared_mutex> mutex)
     : lookup_file_(lookup_filename, mutex),
-      lookup_header_(lookup_file_, number_buckets),
+      lookup_header_(lookup_file_, number_buckets, true),
       lookup_manager_(lookup_file_, header_size, record_size),
       lookup_map_(lookup_header_, lookup_manager_),
       rows_file_(rows_filename, mutex),
@@ -103,6 +105,7 @@ bool address_token_database::start()
            rows_file_.start() &&
            lookup_header_.start() &&
            lookup_manager_.start() &&
+           lookup_map_.start() &&
            rows_manager_.start();
 }
 
@@ -307,6 +310,126 @@ std::shared_ptr<business_record::list> address_token_database::get(
     return result;
 }
 
+short_hash address_token_database::get_key(const std::string &address)
+{
+    data_chunk addr_data(address.begin(), address.end());
+    return ripemd160_hash(addr_data);
+}
+
+/// get records of key after the cursor, ending at a height boundary
+std::shared_ptr<business_record::list> address_token_database::get(
+    const std::string &address, const std::string &symbol,
+    size_t start_height, size_t end_height, uint64_t limit,
+    const history_cursor &cursor, array_index &resume) const
+{
+    const auto key = get_key(address);
+
+    // Read the height value from the row.
+    const auto read_height = [](uint8_t *data) {
+        static constexpr file_offset height_position = 1 + 36;
+        const auto height_address = data + height_position;
+        return from_little_endian_unsafe<uint32_t>(height_address);
+    };
+
+    // Read the tx hash of the point from the row.
+    const auto read_hash = [](uint8_t *data) {
+        hash_digest hash;
+        std::copy(data + 1, data + 1 + hash_size, hash.begin());
+        return hash;
+    };
+
+    // Read a row from the data for the history list.
+    const auto read_row = [](uint8_t *data) {
+        auto deserial = make_deserializer_unsafe(data);
+        return business_record{
+            // output or spend?
+            static_cast<point_kind>(deserial.read_byte()),
+
+            // point
+            point::factory_from_data(deserial),
+
+            // height
+            deserial.read_4_bytes_little_endian(),
+
+            // value or checksum
+            {deserial.read_8_bytes_little_endian()},
+
+            asset_data::factory_from_data(deserial) // 2 + 4 are in this class
+        };
+    };
+
+    // The symbol of a token row, empty for other rows.
+    const auto read_symbol = [](const asset_data &data) {
+        if (data.get_kind_value() == business_kind::token_issue)
+            return boost::get<token_detail>(data.get_data()).get_symbol();
+
+        if (data.get_kind_value() == business_kind::token_transfer)
+            return boost::get<token_transfer>(data.get_data()).get_symbol();
+
+        if (data.get_kind_value() == business_kind::token_cert)
+            return boost::get<token_cert>(data.get_data()).get_symbol();
+
+        return std::string();
+    };
+
+    auto start = rows_multimap_.lookup(key);
+
+    // Resume at the cursor row if it is a row of the cursor height.
+    const auto cursor_row = cursor.row(key);
+    if (rows_list_.in_use(cursor_row))
+    {
+        const auto record = rows_list_.get(cursor_row);
+        if (read_height(REMAP_ADDRESS(record)) == cursor.height())
+            start = cursor_row;
+    }
+
+    auto result = std::make_shared<business_record::list>();
+    const auto records = record_multimap_iterable(rows_list_, start);
+
+    std::set<hash_digest> txs;
+    uint32_t resume_height = 0;
+    resume = record_list::empty;
+
+    for (const auto index : records)
+    {
+        // This obtains a remap safe address pointer against the rows file.
+        const auto record = rows_list_.get(index);
+        const auto address = REMAP_ADDRESS(record);
+        const auto height = read_height(address);
+
+        // Rows are newest first, so nothing below start_height follows.
+        if (height < start_height)
+            break;
+
+        // Stop once we reach the limit (if specified), but never inside the
+        // rows of a height.
+        if (resume == record_list::empty || height != resume_height)
+        {
+            if ((limit > 0) && (txs.size() >= limit))
+                break;
+
+            resume = index;
+            resume_height = height;
+        }
+
+        if ((end_height > 0) && (height >= end_height))
+            continue;
+
+        // Skip rows up to the cursor without reading them in full.
+        if (!cursor.follows(height, read_hash(address)))
+            continue;
+
+        auto row = read_row(address);
+        if (!symbol.empty() && symbol != read_symbol(row.data))
+            continue;
+
+        txs.insert(row.point.hash);
+        result->emplace_back(std::move(row));
+    }
+
+    return result;
+}
+
 /// get all record of key from database
 std::shared_ptr<business_record::list> address_token_database::get(const std::string &address, size_t start_height,
                                                                    size_t end_height) const
@@ -39,8 +39,9 @@ namespace database
 using namespace boost::filesystem;
 using namespace bc::chain;
 
-BC_CONSTEXPR size_t number_buckets = 97210744;
-BC_CONSTEXPR size_t header_size = record_hash_table_header_size(number_buckets);
+// The initial bucket count, the table grows with its keys.
+BC_CONSTEXPR size_t number_buckets = 1024;
+BC_CONSTEXPR size_t header_size = resizable_record_hash_table_header_size(number_buckets);
 BC_CONSTEXPR size_t initial_lookup_file_size = header_size + minimum_records_size;
 
 BC_CONSTEXPR size_t record_size = hash_table_multimap_record_size<short_hash>();
@@ -52,7 +53,7 @@ BC_CONSTEXPR size_t row_record_size = hash_table_record_size<hash_digest>(uid_tr
 address_uid_database::address_uid_database(const path &lookup_filename,
                                            const path &rows_filename, std::shared_ptr<shared_mutex> mutex)
     : lookup_file_(lookup_filename, mutex),
-      lookup_header_(lookup_file_, number_buckets),
+      lookup_header_(lookup_file_, number_buckets, true),
       lookup_manager_(lookup_file_, header_size, record_size),
       lookup_map_(lookup_header_, lookup_manager_),
       rows_file_(rows_filename, mutex),
@@ -103,6 +104,7 @@ bool address_uid_database::start()
            rows_file_.start() &&
            lookup_header_.start() &&
            lookup_manager_.start() &&
+           lookup_map_.start() &&
            rows_manager_.start();
 }
 
@@ -33,14 +33,15 @@ namespace database
 
 using namespace boost::filesystem;
 
-BC_CONSTEXPR size_t number_buckets = 9997; //999983;
-BC_CONSTEXPR size_t header_size = slab_hash_table_header_size(number_buckets);
+// The initial bucket count, the table grows with its keys.
+BC_CONSTEXPR size_t number_buckets = 1024;
+BC_CONSTEXPR size_t header_size = resizable_slab_hash_table_header_size(number_buckets);
 BC_CONSTEXPR size_t initial_map_file_size = header_size + minimum_slabs_size;
 
 blockchain_candidate_database::blockchain_candidate_database(const path &map_filename,
                                                              std::shared_ptr<shared_mutex> mutex)
     : lookup_file_(map_filename, mutex),
-      lookup_header_(lookup_file_, number_buckets),
+      lookup_header_(lookup_file_, number_buckets, true),
       lookup_manager_(lookup_file_, header_size),
       lookup_map_(lookup_header_, lookup_manager_)
 {
@@ -82,7 +83,8 @@ bool blockchain_candidate_database::start()
 {
     return lookup_file_.start() &&
            lookup_header_.start() &&
-           lookup_manager_.start();
+           lookup_manager_.start() &&
+           lookup_map_.start();
 }
 
 // Stop files.
@@ -130,19 +132,13 @@ std::shared_ptr<candidate_info> blockchain_candidate_database::get(const hash_di
 std::shared_ptr<candidate_info::list> blockchain_candidate_database::get_blockchain_candidates() const
 {
     auto vec_acc = std::make_shared<std::vector<candidate_info>>();
-    for (uint64_t i = 0; i < number_buckets; i++)
-    {
-        auto memo = lookup_map_.find(i);
-        if (memo->size())
-        {
-            const auto action = [&vec_acc](memory_ptr elem) {
-                const auto memory = REMAP_ADDRESS(elem);
-                auto deserial = make_deserializer_unsafe(memory);
-                vec_acc->push_back(candidate_info::factory_from_data(deserial));
-            };
-            std::for_each(memo->begin(), memo->end(), action);
-        }
-    }
+    const auto memo = lookup_map_.find_all();
+    const auto action = [&vec_acc](memory_ptr elem) {
+        const auto memory = REMAP_ADDRESS(elem);
+        auto deserial = make_deserializer_unsafe(memory);
+        vec_acc->push_back(candidate_info::factory_from_data(deserial));
+    };
+    std::for_each(memo->begin(), memo->end(), action);
     return vec_acc;
 }
 
@@ -34,15 +34,15 @@ namespace database
 
 using namespace boost::filesystem;
 
-//BC_CONSTEXPR size_t number_buckets = 999997;
-BC_CONSTEXPR size_t number_buckets = 9997;
-BC_CONSTEXPR size_t header_size = slab_hash_table_header_size(number_buckets);
+// The initial bucket count, the table grows with its keys.
+BC_CONSTEXPR size_t number_buckets = 1024;
+BC_CONSTEXPR size_t header_size = resizable_slab_hash_table_header_size(number_buckets);
 BC_CONSTEXPR size_t initial_map_file_size = header_size + minimum_slabs_size;
 
 blockchain_token_cert_database::blockchain_token_cert_database(const path &map_filename,
                                                                std::shared_ptr<shared_mutex> mutex)
     : lookup_file_(map_filename, mutex),
-      lookup_header_(lookup_file_, number_buckets),
+      lookup_header_(lookup_file_, number_buckets, true),
       lookup_manager_(lookup_file_, header_size),
       lookup_map_(lookup_header_, lookup_manager_)
 {
@@ -84,7 +84,8 @@ bool blockchain_token_cert_database::start()
 {
     return lookup_file_.start() &&
            lookup_header_.start() &&
-           lookup_manager_.start();
+           lookup_manager_.start() &&
+           lookup_map_.start();
 }
 
 // Stop files.
@@ -132,19 +133,13 @@ std::shared_ptr<token_cert> blockchain_token_cert_database::get(const hash_diges
 std::shared_ptr<std::vector<token_cert>> blockchain_token_cert_database::get_blockchain_token_certs() const
 {
     auto vec_acc = std::make_shared<std::vector<token_cert>>();
-    for (uint64_t i = 0; i < number_buckets; i++)
-    {
-        auto memo = lookup_map_.find(i);
-        if (memo->size())
-        {
-            const auto action = [&](memory_ptr elem) {
-                const auto memory = REMAP_ADDRESS(elem);
-                auto deserial = make_deserializer_unsafe(memory);
-                vec_acc->push_back(token_cert::factory_from_data(deserial));
-            };
-            std::for_each(memo->begin(), memo->end(), action);
-        }
-    }
+    const auto memo = lookup_map_.find_all();
+    const auto action = [&](memory_ptr elem) {
+        const auto memory = REMAP_ADDRESS(elem);
+        auto deserial = make_deserializer_unsafe(memory);
+        vec_acc->push_back(token_cert::factory_from_data(deserial));
+    };
+    std::for_each(memo->begin(), memo->end(), action);
     return vec_acc;
 }
 
@@ -19,12 +19,15 @@
  */
 #include <UChainService/data/databases/blockchain_uid_db.hpp>
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <boost/filesystem.hpp>
 #include <UChain/coin.hpp>
 #include <UChain/database/memory/memory.hpp>
+#include <UChain/database/primitives/record_multimap_iterable.hpp>
+#include <UChain/database/primitives/record_multimap_iterator.hpp>
 
 namespace libbitcoin
 {
@@ -33,17 +36,38 @@ namespace database
 
 using namespace boost::filesystem;
 
-//BC_CONSTEXPR size_t number_buckets = 999997;
-BC_CONSTEXPR size_t number_buckets = 9997;
-BC_CONSTEXPR size_t header_size = slab_hash_table_header_size(number_buckets);
+// The initial bucket count, the table grows with its keys.
+BC_CONSTEXPR size_t number_buckets = 1024;
+BC_CONSTEXPR size_t header_size = resizable_slab_hash_table_header_size(number_buckets);
 BC_CONSTEXPR size_t initial_map_file_size = header_size + minimum_slabs_size;
 
+BC_CONSTEXPR size_t index_buckets = 1024;
+BC_CONSTEXPR size_t index_header_size = resizable_record_hash_table_header_size(index_buckets);
+BC_CONSTEXPR size_t initial_index_file_size = index_header_size + minimum_records_size;
+BC_CONSTEXPR size_t index_record_size = hash_table_multimap_record_size<short_hash>();
+BC_CONSTEXPR size_t index_row_record_size = record_list_offset + sizeof(file_offset);
+
+static short_hash get_address_key(const std::string &address)
+{
+    const data_chunk data(address.begin(), address.end());
+    return ripemd160_hash(data);
+}
+
 blockchain_uid_database::blockchain_uid_database(const path &map_filename,
+                                                 const path &index_lookup_filename, const path &index_rows_filename,
                                                  std::shared_ptr<shared_mutex> mutex)
     : lookup_file_(map_filename, mutex),
-      lookup_header_(lookup_file_, number_buckets),
+      lookup_header_(lookup_file_, number_buckets, true),
       lookup_manager_(lookup_file_, header_size),
-      lookup_map_(lookup_header_, lookup_manager_)
+      lookup_map_(lookup_header_, lookup_manager_),
+      index_lookup_file_(index_lookup_filename, mutex),
+      index_lookup_header_(index_lookup_file_, index_buckets, true),
+      index_lookup_manager_(index_lookup_file_, index_header_size, index_record_size),
+      index_lookup_map_(index_lookup_header_, index_lookup_manager_),
+      index_rows_file_(index_rows_filename, mutex),
+      index_rows_manager_(index_rows_file_, 0, index_row_record_size),
+      index_rows_list_(index_rows_manager_),
+      index_rows_multimap_(index_lookup_map_, index_rows_list_)
 {
 }
 
@@ -60,19 +84,68 @@ blockchain_uid_database::~blockchain_uid_database()
 bool blockchain_uid_database::create()
 {
     // Resize and create require a started file.
-    if (!lookup_file_.start())
+    if (!lookup_file_.start() ||
+        !index_lookup_file_.start() ||
+        !index_rows_file_.start())
         return false;
 
-    // This will throw if insufficient disk space.
+    // These will throw if insufficient disk space.
     lookup_file_.resize(initial_map_file_size);
+    index_lookup_file_.resize(initial_index_file_size);
+    index_rows_file_.resize(minimum_records_size);
 
     if (!lookup_header_.create() ||
-        !lookup_manager_.create())
+        !lookup_manager_.create() ||
+        !index_lookup_header_.create() ||
+        !index_lookup_manager_.create() ||
+        !index_rows_manager_.create())
         return false;
 
     // Should not call start after create, already started.
     return lookup_header_.start() &&
-           lookup_manager_.start();
+           lookup_manager_.start() &&
+           index_lookup_header_.start() &&
+           index_lookup_manager_.start() &&
+           index_rows_manager_.start();
+}
+
+bool blockchain_uid_database::create_address_index()
+{
+    if (!lookup_file_.start() ||
+        !lookup_header_.start() ||
+        !lookup_manager_.start() ||
+        !lookup_map_.start() ||
+        !index_lookup_file_.start() ||
+        !index_rows_file_.start())
+        return false;
+
+    // These will throw if insufficient disk space.
+    index_lookup_file_.resize(initial_index_file_size);
+    index_rows_file_.resize(minimum_records_size);
+
+    if (!index_lookup_header_.create() ||
+        !index_lookup_manager_.create() ||
+        !index_rows_manager_.create() ||
+        !index_lookup_header_.start() ||
+        !index_lookup_manager_.start() ||
+        !index_rows_manager_.start())
+        return false;
+
+    // Slabs are only ever appended, so ascending positions are store order,
+    // which keeps delete_last_row in step with the pops to come.
+    auto positions = std::move(*lookup_map_.find_all_positions());
+
+    std::sort(positions.begin(), positions.end());
+    for (const auto position : positions)
+    {
+        const auto memory = REMAP_ADDRESS(lookup_manager_.get(position));
+        auto deserial = make_deserializer_unsafe(memory);
+        const auto blockchain_uid_ = blockchain_uid::factory_from_data(deserial);
+        store_address_index(blockchain_uid_.get_uid().get_address(), position);
+    }
+
+    sync();
+    return true;
 }
 
 // Startup and shutdown.
@@ -82,26 +155,39 @@ bool blockchain_uid_database::create()
 bool blockchain_uid_database::start()
 {
     return lookup_file_.start() &&
+           index_lookup_file_.start() &&
+           index_rows_file_.start() &&
            lookup_header_.start() &&
-           lookup_manager_.start();
+           lookup_manager_.start() &&
+           lookup_map_.start() &&
+           index_lookup_header_.start() &&
+           index_lookup_manager_.start() &&
+           index_lookup_map_.start() &&
+           index_rows_manager_.start();
 }
 
 // Stop files.
 bool blockchain_uid_database::stop()
 {
-    return lookup_file_.stop();
+    return lookup_file_.stop() &&
+           index_lookup_file_.stop() &&
+           index_rows_file_.stop();
 }
 
 // Close files.
 bool blockchain_uid_database::close()
 {
-    return lookup_file_.close();
+    return lookup_file_.close() &&
+           index_lookup_file_.close() &&
+           index_rows_file_.close();
 }
 
 // ----------------------------------------------------------------------------
 
 void blockchain_uid_database::remove(const hash_digest &hash)
 {
+    remove_address_index(hash);
+
     DEBUG_ONLY(bool success =)
     lookup_map_.unlink(hash);
     BITCOIN_ASSERT(success);
@@ -110,6 +196,33 @@ void blockchain_uid_database::remove(const hash_digest &hash)
 void blockchain_uid_database::sync()
 {
     lookup_manager_.sync();
+    index_lookup_manager_.sync();
+    index_rows_manager_.sync();
+}
+
+void blockchain_uid_database::store_address_index(const std::string &address,
+                                                  file_offset position)
+{
+    auto write = [position](memory_ptr data) {
+        auto serial = make_serializer(REMAP_ADDRESS(data));
+        serial.write_8_bytes_little_endian(position);
+    };
+    index_rows_multimap_.add_row(get_address_key(address), write);
+}
+
+// Records are unlinked in the reverse order of store, so the newest record
+// of hash is also the last index row of its address.
+void blockchain_uid_database::remove_address_index(const hash_digest &hash)
+{
+    const auto raw_memory = lookup_map_.find(hash);
+    if (!raw_memory)
+        return;
+
+    const auto memory = REMAP_ADDRESS(raw_memory);
+    auto deserial = make_deserializer_unsafe(memory);
+    const auto blockchain_uid_ = blockchain_uid::factory_from_data(deserial);
+    index_rows_multimap_.delete_last_row(
+        get_address_key(blockchain_uid_.get_uid().get_address()));
 }
 
 std::shared_ptr<blockchain_uid> blockchain_uid_database::get(const hash_digest &hash) const
@@ -150,21 +263,13 @@ std::shared_ptr<std::vector<blockchain_uid>> blockchain_uid_database::get_histor
 std::shared_ptr<std::vector<blockchain_uid>> blockchain_uid_database::get_blockchain_uids() const
 {
     auto vec_acc = std::make_shared<std::vector<blockchain_uid>>();
-    uint64_t i = 0;
-    for (i = 0; i < number_buckets; i++)
-    {
-        auto memo = lookup_map_.find(i);
-        //log::debug("get_wallets size=")<<memo->size();
-        if (memo->size())
-        {
-            const auto action = [&](memory_ptr elem) {
-                const auto memory = REMAP_ADDRESS(elem);
-                auto deserial = make_deserializer_unsafe(memory);
-                vec_acc->push_back(blockchain_uid::factory_from_data(deserial));
-            };
-            std::for_each(memo->begin(), memo->end(), action);
-        }
-    }
+    const auto memo = lookup_map_.find_all();
+    const auto action = [&](memory_ptr elem) {
+        const auto memory = REMAP_ADDRESS(elem);
+        auto deserial = make_deserializer_unsafe(memory);
+        vec_acc->push_back(blockchain_uid::factory_from_data(deserial));
+    };
+    std::for_each(memo->begin(), memo->end(), action);
     return vec_acc;
 }
 
@@ -215,7 +320,8 @@ void blockchain_uid_database::store(const hash_digest &hash, const blockchain_ui
         auto serial = make_serializer(REMAP_ADDRESS(data));
         serial.write_data(sp_detail.to_data());
     };
-    lookup_map_.store(key, write, value_size);
+    const auto position = lookup_map_.store(key, write, value_size);
+    store_address_index(sp_detail.get_uid().get_address(), position);
 }
 
 std::shared_ptr<blockchain_uid> blockchain_uid_database::update_address_status(const hash_digest &hash, uint32_t status)
@@ -248,30 +354,39 @@ std::shared_ptr<std::vector<blockchain_uid>> blockchain_uid_database::getuids_fr
                                                                                                    const uint64_t &fromheight, const uint64_t &toheight) const
 {
     auto vec_acc = std::make_shared<std::vector<blockchain_uid>>();
-    uint64_t i = 0;
-    for (i = 0; i < number_buckets; i++)
+
+    const auto read_position = [](uint8_t *data) {
+        return from_little_endian_unsafe<file_offset>(data);
+    };
+
+    const auto start = index_rows_multimap_.lookup(get_address_key(address));
+    const auto records = record_multimap_iterable(index_rows_list_, start);
+
+    for (const auto index : records)
     {
-        auto sp_memo = lookup_map_.find(i);
-        for (auto &elem : *sp_memo)
-        {
-            const auto memory = REMAP_ADDRESS(elem);
-            auto deserial = make_deserializer_unsafe(memory);
-            blockchain_uid blockchain_uid_ = blockchain_uid::factory_from_data(deserial);
+        // This obtains a remap safe address pointer against the rows file.
+        const auto record = index_rows_list_.get(index);
+        const auto position = read_position(REMAP_ADDRESS(record));
 
-            const auto height = blockchain_uid_.get_height();
-            const auto uid_address = blockchain_uid_.get_uid().get_address();
+        const auto memory = REMAP_ADDRESS(lookup_manager_.get(position));
+        auto deserial = make_deserializer_unsafe(memory);
+        blockchain_uid blockchain_uid_ = blockchain_uid::factory_from_data(deserial);
 
-            if (uid_address == address)
+        const auto height = blockchain_uid_.get_height();
+        const auto uid_address = blockchain_uid_.get_uid().get_address();
+
+        if (uid_address == address)
+        {
+            if ((height >= fromheight && height <= toheight) || (height == max_uint32 && address == bc::wallet::payment_address::blackhole_address))
             {
-                if ((height >= fromheight && height <= toheight) || (height == max_uint32 && address == bc::wallet::payment_address::blackhole_address))
-                {
-                    vec_acc->emplace_back(blockchain_uid_);
-                }
+                vec_acc->emplace_back(blockchain_uid_);
             }
         }
     }
 
-    std::sort(vec_acc->begin(), vec_acc->end(), [](blockchain_uid &first, blockchain_uid &second) {
+    // rows are newest first, keep store order for equal heights.
+    std::reverse(vec_acc->begin(), vec_acc->end());
+    std::stable_sort(vec_acc->begin(), vec_acc->end(), [](const blockchain_uid &first, const blockchain_uid &second) {
         return first.get_height() < second.get_height();
     });
     return vec_acc;
@@ -279,6 +394,7 @@ std::shared_ptr<std::vector<blockchain_uid>> blockchain_uid_database::getuids_fr
 
 std::shared_ptr<blockchain_uid> blockchain_uid_database::pop_uid_transfer(const hash_digest &hash)
 {
+    remove_address_index(hash);
     lookup_map_.unlink(hash);
     return update_address_status(hash, blockchain_uid::address_current);
 }
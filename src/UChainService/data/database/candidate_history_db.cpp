@@ -60,8 +60,9 @@ candidate_info read_row(uint8_t *data)
 };
 } // namespace
 
-BC_CONSTEXPR size_t number_buckets = 99999989;
-BC_CONSTEXPR size_t header_size = record_hash_table_header_size(number_buckets);
+// The initial bucket count, the table grows with its keys.
+BC_CONSTEXPR size_t number_buckets = 1024;
+BC_CONSTEXPR size_t header_size = resizable_record_hash_table_header_size(number_buckets);
 BC_CONSTEXPR size_t initial_lookup_file_size = header_size + minimum_records_size;
 
 BC_CONSTEXPR size_t record_size = hash_table_multimap_record_size<short_hash>();
@@ -72,7 +73,7 @@ BC_CONSTEXPR size_t row_record_size = hash_table_record_size<hash_digest>(candid
 candidate_history_database::candidate_history_database(const path &lookup_filename,
                                                        const path &rows_filename, std::shared_ptr<shared_mutex> mutex)
     : lookup_file_(lookup_filename, mutex),
-      lookup_header_(lookup_file_, number_buckets),
+      lookup_header_(lookup_file_, number_buckets, true),
       lookup_manager_(lookup_file_, header_size, record_size),
       lookup_map_(lookup_header_, lookup_manager_),
       rows_file_(rows_filename, mutex),
@@ -123,6 +124,7 @@ bool candidate_history_database::start()
            rows_file_.start() &&
            lookup_header_.start() &&
            lookup_manager_.start() &&
+           lookup_map_.start() &&
            rows_manager_.start();
 }
 
@@ -243,6 +245,46 @@ std::shared_ptr<candidate_info::list> candidate_history_database::get_history_ca
     return result;
 }
 
+std::shared_ptr<candidate_info::list> candidate_history_database::get_history_candidates_by_height(
+    const short_hash &key, history_cursor &cursor, uint64_t limit) const
+{
+    auto start = rows_multimap_.lookup(key);
+
+    // Resume at the cursor row if it is a row of the cursor height.
+    const auto cursor_row = cursor.row(key);
+    if (rows_list_.in_use(cursor_row))
+    {
+        const auto record = rows_list_.get(cursor_row);
+        if (read_height(REMAP_ADDRESS(record)) == cursor.height())
+            start = cursor_row;
+    }
+
+    auto result = std::make_shared<candidate_info::list>();
+    const auto records = record_multimap_iterable(rows_list_, start);
+
+    for (const auto index : records)
+    {
+        // Stop once we reach the limit (if specified).
+        if ((limit > 0) && (result->size() >= limit))
+            break;
+
+        // This obtains a remap safe address pointer against the rows file.
+        const auto record = rows_list_.get(index);
+        const auto address = REMAP_ADDRESS(record);
+        const auto height = read_height(address);
+
+        // A null hash cursor has passed every row of its height, so only
+        // the newest row of each height is returned.
+        if (!cursor.follows(height, null_hash))
+            continue;
+
+        result->emplace_back(read_row(address));
+        cursor = history_cursor(height, null_hash, index, key);
+    }
+
+    return result;
+}
+
 std::shared_ptr<candidate_info::list> candidate_history_database::get_history_candidates_by_time(
     const short_hash &key, uint32_t time_begin, uint32_t time_end,
     uint64_t limit, uint64_t page_number) const
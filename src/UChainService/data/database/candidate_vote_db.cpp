@@ -0,0 +1,229 @@
+/**
+ * Copyright (c) 2018-2020 UChain core developers (check UC-AUTHORS)
+ *
+ * This file is part of UChain.
+ *
+ * UChain is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <UChainService/data/databases/candidate_vote_db.hpp>
+
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <boost/filesystem.hpp>
+#include <UChain/coin.hpp>
+#include <UChain/database/memory/memory.hpp>
+#include <UChain/database/primitives/record_multimap_iterable.hpp>
+#include <UChain/database/primitives/record_multimap_iterator.hpp>
+
+namespace libbitcoin
+{
+namespace database
+{
+
+using namespace boost::filesystem;
+
+namespace
+{
+// A spend never takes the tally below zero.
+uint64_t tally(uint64_t votes, uint64_t amount, bool spend)
+{
+    if (!spend)
+        return votes + amount;
+
+    return votes > amount ? votes - amount : 0;
+}
+} // namespace
+
+// The initial bucket count, the table grows with its keys.
+BC_CONSTEXPR size_t number_buckets = 128;
+BC_CONSTEXPR size_t header_size = resizable_record_hash_table_header_size(number_buckets);
+BC_CONSTEXPR size_t initial_lookup_file_size = header_size + minimum_records_size;
+
+BC_CONSTEXPR size_t record_size = hash_table_multimap_record_size<short_hash>();
+
+BC_CONSTEXPR size_t tally_size = 4 + 8;
+BC_CONSTEXPR size_t row_record_size = hash_table_record_size<hash_digest>(tally_size);
+
+candidate_vote_database::candidate_vote_database(const path &lookup_filename,
+                                                 const path &rows_filename, std::shared_ptr<shared_mutex> mutex)
+    : lookup_file_(lookup_filename, mutex),
+      lookup_header_(lookup_file_, number_buckets, true),
+      lookup_manager_(lookup_file_, header_size, record_size),
+      lookup_map_(lookup_header_, lookup_manager_),
+      rows_file_(rows_filename, mutex),
+      rows_manager_(rows_file_, 0, row_record_size),
+      rows_list_(rows_manager_),
+      rows_multimap_(lookup_map_, rows_list_)
+{
+}
+
+// Close does not call stop because there is no way to detect thread join.
+candidate_vote_database::~candidate_vote_database()
+{
+    close();
+}
+
+// Create.
+// ----------------------------------------------------------------------------
+
+// Initialize files and start.
+bool candidate_vote_database::create()
+{
+    // Resize and create require a started file.
+    if (!lookup_file_.start() ||
+        !rows_file_.start())
+        return false;
+
+    // These will throw if insufficient disk space.
+    lookup_file_.resize(initial_lookup_file_size);
+    rows_file_.resize(minimum_records_size);
+
+    if (!lookup_header_.create() ||
+        !lookup_manager_.create() ||
+        !rows_manager_.create())
+        return false;
+
+    // Should not call start after create, already started.
+    return lookup_header_.start() &&
+           lookup_manager_.start() &&
+           rows_manager_.start();
+}
+
+// Startup and shutdown.
+// ----------------------------------------------------------------------------
+
+bool candidate_vote_database::start()
+{
+    return lookup_file_.start() &&
+           rows_file_.start() &&
+           lookup_header_.start() &&
+           lookup_manager_.start() &&
+           lookup_map_.start() &&
+           rows_manager_.start();
+}
+
+bool candidate_vote_database::stop()
+{
+    return lookup_file_.stop() &&
+           rows_file_.stop();
+}
+
+bool candidate_vote_database::close()
+{
+    return lookup_file_.close() &&
+           rows_file_.close();
+}
+
+// Tally.
+// ----------------------------------------------------------------------------
+
+void candidate_vote_database::credit(const short_hash &uid_key, uint32_t height,
+                                     uint64_t amount)
+{
+    update(uid_key, height, amount, false);
+}
+
+void candidate_vote_database::debit(const short_hash &uid_key, uint32_t height,
+                                    uint64_t amount)
+{
+    update(uid_key, height, amount, true);
+}
+
+void candidate_vote_database::unlink(const short_hash &uid_key, uint32_t height)
+{
+    while (true)
+    {
+        const auto start = rows_multimap_.lookup(uid_key);
+        if (start == record_list::empty)
+            return;
+
+        const auto record = rows_list_.get(start);
+        if (from_little_endian_unsafe<uint32_t>(REMAP_ADDRESS(record)) < height)
+            return;
+
+        rows_multimap_.delete_last_row(uid_key);
+    }
+}
+
+// Only the rows above height are skipped, at most those of one cycle.
+uint64_t candidate_vote_database::get(const short_hash &uid_key,
+                                      uint32_t height) const
+{
+    const auto start = rows_multimap_.lookup(uid_key);
+    const auto records = record_multimap_iterable(rows_list_, start);
+
+    for (const auto index : records)
+    {
+        // This obtains a remap safe address pointer against the rows file.
+        const auto record = rows_list_.get(index);
+        auto deserial = make_deserializer_unsafe(REMAP_ADDRESS(record));
+        if (deserial.read_4_bytes_little_endian() <= height)
+            return deserial.read_8_bytes_little_endian();
+    }
+
+    return 0;
+}
+
+void candidate_vote_database::sync()
+{
+    lookup_manager_.sync();
+    rows_manager_.sync();
+}
+
+candidate_vote_statinfo candidate_vote_database::statinfo() const
+{
+    return {
+        lookup_header_.size(),
+        lookup_manager_.count(),
+        rows_manager_.count()};
+}
+
+// privates
+
+// Each block adds at most one row per candidate, later changes within the
+// block rewrite the head row in place.
+void candidate_vote_database::update(const short_hash &uid_key, uint32_t height,
+                                     uint64_t amount, bool spend)
+{
+    uint64_t votes = 0;
+    const auto start = rows_multimap_.lookup(uid_key);
+    if (start != record_list::empty)
+    {
+        const auto record = rows_list_.get(start);
+        auto deserial = make_deserializer_unsafe(REMAP_ADDRESS(record));
+        const auto head_height = deserial.read_4_bytes_little_endian();
+        votes = deserial.read_8_bytes_little_endian();
+
+        if (head_height == height)
+        {
+            votes = tally(votes, amount, spend);
+            auto serial = make_serializer(REMAP_ADDRESS(record) + 4);
+            serial.write_8_bytes_little_endian(votes);
+            return;
+        }
+    }
+
+    votes = tally(votes, amount, spend);
+    auto write = [height, votes](memory_ptr data) {
+        auto serial = make_serializer(REMAP_ADDRESS(data));
+        serial.write_4_bytes_little_endian(height);
+        serial.write_8_bytes_little_endian(votes);
+    };
+    rows_multimap_.add_row(uid_key, write);
+}
+
+} // namespace database
+} // namespace libbitcoin
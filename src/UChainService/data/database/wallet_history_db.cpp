@@ -0,0 +1,383 @@
+/**
+ * Copyright (c) 2018-2020 UChain core developers (check UC-AUTHORS)
+ *
+ * This file is part of UChain.
+ *
+ * UChain is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <UChainService/data/databases/wallet_history_db.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <boost/filesystem.hpp>
+#include <UChain/coin.hpp>
+#include <UChain/database/memory/memory.hpp>
+#include <UChain/database/primitives/record_multimap_iterable.hpp>
+#include <UChain/database/primitives/record_multimap_iterator.hpp>
+
+namespace libbitcoin
+{
+namespace database
+{
+
+using namespace boost::filesystem;
+
+namespace
+{
+// Read a row from the data for the timeline.
+wallet_tx read_row(uint8_t *data)
+{
+    auto deserial = make_deserializer_unsafe(data);
+    const auto height = deserial.read_4_bytes_little_endian();
+    const auto timestamp = deserial.read_4_bytes_little_endian();
+    return {height, timestamp, deserial.read_hash()};
+};
+
+// Read a wallet key from the data for the owner list.
+short_hash read_owner(uint8_t *data)
+{
+    short_hash wallet_key;
+    std::copy(data, data + short_hash_size, wallet_key.begin());
+    return wallet_key;
+};
+} // namespace
+
+// The initial bucket count, the table grows with its keys.
+BC_CONSTEXPR size_t number_buckets = 1024;
+BC_CONSTEXPR size_t header_size = resizable_record_hash_table_header_size(number_buckets);
+BC_CONSTEXPR size_t initial_lookup_file_size = header_size + minimum_records_size;
+
+BC_CONSTEXPR size_t record_size = hash_table_multimap_record_size<short_hash>();
+
+BC_CONSTEXPR size_t wallet_tx_size = 4 + 4 + hash_size;
+BC_CONSTEXPR size_t row_record_size = hash_table_record_size<hash_digest>(wallet_tx_size);
+BC_CONSTEXPR size_t owner_record_size = hash_table_record_size<hash_digest>(short_hash_size);
+
+wallet_history_database::wallet_history_database(const path &lookup_filename,
+                                                 const path &rows_filename, const path &owners_lookup_filename,
+                                                 const path &owners_rows_filename, std::shared_ptr<shared_mutex> mutex)
+    : lookup_file_(lookup_filename, mutex),
+      lookup_header_(lookup_file_, number_buckets, true),
+      lookup_manager_(lookup_file_, header_size, record_size),
+      lookup_map_(lookup_header_, lookup_manager_),
+      rows_file_(rows_filename, mutex),
+      rows_manager_(rows_file_, 0, row_record_size),
+      rows_list_(rows_manager_),
+      rows_multimap_(lookup_map_, rows_list_),
+      owners_lookup_file_(owners_lookup_filename, mutex),
+      owners_lookup_header_(owners_lookup_file_, number_buckets, true),
+      owners_lookup_manager_(owners_lookup_file_, header_size, record_size),
+      owners_lookup_map_(owners_lookup_header_, owners_lookup_manager_),
+      owners_rows_file_(owners_rows_filename, mutex),
+      owners_rows_manager_(owners_rows_file_, 0, owner_record_size),
+      owners_rows_list_(owners_rows_manager_),
+      owners_rows_multimap_(owners_lookup_map_, owners_rows_list_)
+{
+}
+
+// Close does not call stop because there is no way to detect thread join.
+wallet_history_database::~wallet_history_database()
+{
+    close();
+}
+
+// Create.
+// ----------------------------------------------------------------------------
+
+// Initialize files and start.
+bool wallet_history_database::create()
+{
+    // Resize and create require a started file.
+    if (!lookup_file_.start() ||
+        !rows_file_.start() ||
+        !owners_lookup_file_.start() ||
+        !owners_rows_file_.start())
+        return false;
+
+    // These will throw if insufficient disk space.
+    lookup_file_.resize(initial_lookup_file_size);
+    rows_file_.resize(minimum_records_size);
+    owners_lookup_file_.resize(initial_lookup_file_size);
+    owners_rows_file_.resize(minimum_records_size);
+
+    if (!lookup_header_.create() ||
+        !lookup_manager_.create() ||
+        !rows_manager_.create() ||
+        !owners_lookup_header_.create() ||
+        !owners_lookup_manager_.create() ||
+        !owners_rows_manager_.create())
+        return false;
+
+    // Should not call start after create, already started.
+    return lookup_header_.start() &&
+           lookup_manager_.start() &&
+           rows_manager_.start() &&
+           owners_lookup_header_.start() &&
+           owners_lookup_manager_.start() &&
+           owners_rows_manager_.start();
+}
+
+// Startup and shutdown.
+// ----------------------------------------------------------------------------
+
+bool wallet_history_database::start()
+{
+    return lookup_file_.start() &&
+           rows_file_.start() &&
+           owners_lookup_file_.start() &&
+           owners_rows_file_.start() &&
+           lookup_header_.start() &&
+           lookup_manager_.start() &&
+           lookup_map_.start() &&
+           rows_manager_.start() &&
+           owners_lookup_header_.start() &&
+           owners_lookup_manager_.start() &&
+           owners_lookup_map_.start() &&
+           owners_rows_manager_.start();
+}
+
+bool wallet_history_database::stop()
+{
+    return lookup_file_.stop() &&
+           rows_file_.stop() &&
+           owners_lookup_file_.stop() &&
+           owners_rows_file_.stop();
+}
+
+bool wallet_history_database::close()
+{
+    return lookup_file_.close() &&
+           rows_file_.close() &&
+           owners_lookup_file_.close() &&
+           owners_rows_file_.close();
+}
+
+// Owners.
+// ----------------------------------------------------------------------------
+
+std::vector<short_hash> wallet_history_database::owners(const short_hash &address_key) const
+{
+    std::vector<short_hash> result;
+    const auto start = owners_rows_multimap_.lookup(address_key);
+    const auto records = record_multimap_iterable(owners_rows_list_, start);
+
+    for (const auto index : records)
+    {
+        // This obtains a remap safe address pointer against the rows file.
+        const auto record = owners_rows_list_.get(index);
+        result.emplace_back(read_owner(REMAP_ADDRESS(record)));
+    }
+
+    return result;
+}
+
+void wallet_history_database::add_owner(const short_hash &address_key, const short_hash &wallet_key)
+{
+    const auto wallets = owners(address_key);
+    if (std::find(wallets.begin(), wallets.end(), wallet_key) != wallets.end())
+        return;
+
+    auto write = [&wallet_key](memory_ptr data) {
+        auto serial = make_serializer(REMAP_ADDRESS(data));
+        serial.write_short_hash(wallet_key);
+    };
+    owners_rows_multimap_.add_row(address_key, write);
+}
+
+// Rows can only be dropped from the head, so the list is written again
+// without the wallet. An address has very few owners.
+void wallet_history_database::remove_owner(const short_hash &address_key, const short_hash &wallet_key)
+{
+    const auto wallets = owners(address_key);
+    if (std::find(wallets.begin(), wallets.end(), wallet_key) == wallets.end())
+        return;
+
+    for (size_t row = 0; row < wallets.size(); ++row)
+        owners_rows_multimap_.delete_last_row(address_key);
+
+    for (auto owner = wallets.rbegin(); owner != wallets.rend(); ++owner)
+        if (*owner != wallet_key)
+            add_owner(address_key, *owner);
+}
+
+// Timeline.
+// ----------------------------------------------------------------------------
+
+void wallet_history_database::store(const short_hash &wallet_key, wallet_tx::list txs)
+{
+    add_rows(wallet_key, txs);
+}
+
+void wallet_history_database::unlink(const short_hash &wallet_key, uint32_t height)
+{
+    while (true)
+    {
+        const auto start = rows_multimap_.lookup(wallet_key);
+        if (start == record_list::empty)
+            return;
+
+        const auto record = rows_list_.get(start);
+        if (read_row(REMAP_ADDRESS(record)).height < height)
+            return;
+
+        rows_multimap_.delete_last_row(wallet_key);
+    }
+}
+
+void wallet_history_database::rebuild(const short_hash &wallet_key, wallet_tx::list txs)
+{
+    for (auto rows = count(wallet_key); rows > 0; --rows)
+        rows_multimap_.delete_last_row(wallet_key);
+
+    add_rows(wallet_key, txs);
+}
+
+wallet_tx::list wallet_history_database::get(const short_hash &wallet_key) const
+{
+    wallet_tx::list result;
+    const auto start = rows_multimap_.lookup(wallet_key);
+    const auto records = record_multimap_iterable(rows_list_, start);
+
+    for (const auto index : records)
+    {
+        // This obtains a remap safe address pointer against the rows file.
+        const auto record = rows_list_.get(index);
+        result.emplace_back(read_row(REMAP_ADDRESS(record)));
+    }
+
+    return result;
+}
+
+wallet_tx::list wallet_history_database::get(const short_hash &wallet_key, history_cursor &cursor,
+                                             size_t start_height, size_t end_height, size_t limit) const
+{
+    auto start = rows_multimap_.lookup(wallet_key);
+
+    // Resume at the cursor row if it is a row of the cursor height.
+    const auto cursor_row = cursor.row(wallet_key);
+    if (rows_list_.in_use(cursor_row))
+    {
+        const auto record = rows_list_.get(cursor_row);
+        const auto row = read_row(REMAP_ADDRESS(record));
+        if (row.height == cursor.height() && row.hash == cursor.hash())
+            start = cursor_row;
+    }
+
+    wallet_tx::list result;
+    const auto records = record_multimap_iterable(rows_list_, start);
+
+    for (const auto index : records)
+    {
+        // Stop once we reach the limit (if specified).
+        if ((limit > 0) && (result.size() >= limit))
+            break;
+
+        // This obtains a remap safe address pointer against the rows file.
+        const auto record = rows_list_.get(index);
+        const auto row = read_row(REMAP_ADDRESS(record));
+
+        // Rows are newest first, so nothing below start_height follows.
+        if (row.height < start_height)
+            break;
+
+        if ((end_height > 0) && (row.height >= end_height))
+            continue;
+
+        if (!cursor.follows(row.height, row.hash))
+            continue;
+
+        result.push_back(row);
+        cursor = history_cursor(row.height, row.hash, index, wallet_key);
+    }
+
+    return result;
+}
+
+// Only the height of each row is read.
+size_t wallet_history_database::count(const short_hash &wallet_key,
+                                      size_t start_height, size_t end_height) const
+{
+    size_t rows = 0;
+    const auto start = rows_multimap_.lookup(wallet_key);
+    const auto records = record_multimap_iterable(rows_list_, start);
+
+    for (const auto index : records)
+    {
+        const auto record = rows_list_.get(index);
+        const auto height = from_little_endian_unsafe<uint32_t>(REMAP_ADDRESS(record));
+
+        if (height < start_height)
+            break;
+
+        if ((end_height == 0) || (height < end_height))
+            ++rows;
+    }
+
+    return rows;
+}
+
+void wallet_history_database::sync()
+{
+    lookup_manager_.sync();
+    rows_manager_.sync();
+    owners_lookup_manager_.sync();
+    owners_rows_manager_.sync();
+}
+
+wallet_history_statinfo wallet_history_database::statinfo() const
+{
+    return {
+        lookup_header_.size(),
+        lookup_manager_.count(),
+        rows_manager_.count()};
+}
+
+// privates
+
+bool wallet_history_database::newer(const wallet_tx &left, const wallet_tx &right)
+{
+    return left.height > right.height ||
+           (left.height == right.height && left.hash > right.hash);
+}
+
+// Rows are pushed oldest first so that the list reads newest first.
+void wallet_history_database::add_rows(const short_hash &wallet_key, wallet_tx::list &txs)
+{
+    const auto older = [](const wallet_tx &left, const wallet_tx &right) {
+        return newer(right, left);
+    };
+    const auto same = [](const wallet_tx &left, const wallet_tx &right) {
+        return left.hash == right.hash;
+    };
+
+    std::sort(txs.begin(), txs.end(), older);
+    txs.erase(std::unique(txs.begin(), txs.end(), same), txs.end());
+
+    for (const auto &tx : txs)
+    {
+        auto write = [&tx](memory_ptr data) {
+            auto serial = make_serializer(REMAP_ADDRESS(data));
+            serial.write_4_bytes_little_endian(tx.height);
+            serial.write_4_bytes_little_endian(tx.timestamp);
+            serial.write_hash(tx.hash);
+        };
+        rows_multimap_.add_row(wallet_key, write);
+    }
+}
+
+} // namespace database
+} // namespace libbitcoin
@@ -202,6 +202,13 @@ const std::string wallet_address::get_prv_key(std::string &passphrase) const
     decrypt_string(prv_key, passphrase, decry_output);
     return decry_output;
 }
+const std::string wallet_address::get_prv_key(aes256_key &key) const
+{
+    std::string decry_output("");
+
+    decrypt_string(prv_key, key, decry_output);
+    return decry_output;
+}
 const std::string wallet_address::get_prv_key() const
 {
     return prv_key;
@@ -213,6 +220,13 @@ void wallet_address::set_prv_key(const std::string &prv_key, std::string &passph
     encrypt_string(prv_key, passphrase, encry_output);
     this->prv_key = encry_output;
 }
+void wallet_address::set_prv_key(const std::string &prv_key, aes256_key &key)
+{
+    std::string encry_output("");
+
+    encrypt_string(prv_key, key, encry_output);
+    this->prv_key = encry_output;
+}
 void wallet_address::set_prv_key(const std::string &prv_key)
 {
     this->prv_key = prv_key;